@@ -1,13 +1,15 @@
 #include "Config.hpp"
 #include "Drawing.hpp"
+#include "Health.hpp"
 
 // define default values
 bool Config::bStreamProof = true;
 bool Config::bAutostart = false;
 bool Config::bDebug = false;
 int Config::iTargetFPS = 250;
-std::chrono::microseconds Config::targetFrametime{ 4000 };
+std::atomic<std::chrono::microseconds::rep> Config::targetFrametime = 4000;
 bool Config::lastConnectionStatus = false;
+uint64_t Config::lastConnectionGeneration = 0;
 bool Config::bCreateOverlay = false;
 int Config::iRandomOffsetMin = 0;
 int Config::iRandomOffsetMax = 0;
@@ -17,6 +19,7 @@ int Config::iOffsetRight = 0;
 int Config::iOffsetBottom = 0;
 std::string Config::sWindowName = "FC2Toverlay";
 int Config::iQuitKeycode = VK_END;
+std::vector<int> Config::fontSizes = { 13, 16, 20, 26, 34, 48 };
 
 // random number generator
 static std::random_device rd;
@@ -28,18 +31,17 @@ static std::mt19937 gen(rd());
  */
 bool Config::IsConstellationConnected()
 {
-    // call FC2T function to update the last error
-    fc2::get_session();
+    // read the status of the last heartbeat instead of asking FC2 every frame
+    bool connectionStatus = Health::IsConnected();
 
-    // get the last fc2 error
-    bool connectionStatus = fc2::get_error() == FC2_TEAM_ERROR_NO_ERROR;
-
-    // get config settings if constellation just connected
-    if (connectionStatus && !lastConnectionStatus)
+    // get config settings if constellation just connected, or reconnected after a restart
+    uint64_t connectionGeneration = fc2::get_generation();
+    if (connectionStatus && (!lastConnectionStatus || connectionGeneration != lastConnectionGeneration))
         GetConfig();
 
     // save and return the new connection status
     lastConnectionStatus = connectionStatus;
+    lastConnectionGeneration = connectionGeneration;
     return connectionStatus;
 }
 
@@ -52,17 +54,28 @@ void Config::GetConfig()
     if (fc2::get_error() != FC2_TEAM_ERROR_NO_ERROR)
         return;
 
-    // get saved config values
-    bStreamProof = fc2::call<BOOL>("directx_overlay_streamproof", FC2_LUA_TYPE_BOOLEAN);
-    bAutostart = fc2::call<BOOL>("directx_overlay_autostart", FC2_LUA_TYPE_BOOLEAN);
-    bDebug = fc2::call<BOOL>("directx_overlay_debug", FC2_LUA_TYPE_BOOLEAN);
-    iTargetFPS = fc2::call<uint32_t>("directx_overlay_target_fps", FC2_LUA_TYPE_INT);
+    // get saved config values in a single request
+    auto [streamProof, autostart, debug, targetFPS, randomOffsetMin, randomOffsetMax, windowName, quitKeycode] = fc2::call_many<BOOL, BOOL, BOOL, uint32_t, int, int, std::string, int>(
+        { "directx_overlay_streamproof", FC2_LUA_TYPE_BOOLEAN },
+        { "directx_overlay_autostart", FC2_LUA_TYPE_BOOLEAN },
+        { "directx_overlay_debug", FC2_LUA_TYPE_BOOLEAN },
+        { "directx_overlay_target_fps", FC2_LUA_TYPE_INT },
+        { "directx_overlay_random_min", FC2_LUA_TYPE_INT },
+        { "directx_overlay_random_max", FC2_LUA_TYPE_INT },
+        { "directx_overlay_window_name", FC2_LUA_TYPE_STRING },
+        { "directx_overlay_quit_key", FC2_LUA_TYPE_INT }
+    );
+
+    bStreamProof = streamProof;
+    bAutostart = autostart;
+    bDebug = debug;
+    iTargetFPS = targetFPS;
     iTargetFPS = std::min(1000, std::max(iTargetFPS, 0));
-    targetFrametime = std::chrono::microseconds(iTargetFPS == 0 ? 1 : 1000000 / iTargetFPS);
-    iRandomOffsetMin = fc2::call<int>("directx_overlay_random_min", FC2_LUA_TYPE_INT);
-    iRandomOffsetMax = fc2::call<int>("directx_overlay_random_max", FC2_LUA_TYPE_INT);
-    sWindowName = fc2::call<std::string>("directx_overlay_window_name", FC2_LUA_TYPE_STRING);
-    iQuitKeycode = fc2::call<int>("directx_overlay_quit_key", FC2_LUA_TYPE_INT);
+    targetFrametime = iTargetFPS == 0 ? 1 : 1000000 / iTargetFPS;
+    iRandomOffsetMin = randomOffsetMin;
+    iRandomOffsetMax = randomOffsetMax;
+    sWindowName = windowName;
+    iQuitKeycode = quitKeycode;
 
     // set button text for custom key
     Drawing::quitKey = ImGui_ImplWin32_KeyEventToImGuiKey(iQuitKeycode, 0);
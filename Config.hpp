@@ -9,13 +9,15 @@ class Config
 {
 private:
     static bool lastConnectionStatus;
+    static uint64_t lastConnectionGeneration;
 
 public:
     static bool bStreamProof;
     static bool bAutostart;
     static bool bDebug;
     static int iTargetFPS;
-    static std::chrono::microseconds targetFrametime;
+    // frametime in microseconds, written by the UI and read by the render and fetcher threads
+    static std::atomic<std::chrono::microseconds::rep> targetFrametime;
     static bool bCreateOverlay;
     static int iRandomOffsetMin;
     static int iRandomOffsetMax;
@@ -25,6 +27,7 @@ public:
     static int iOffsetBottom;
     static std::string sWindowName;
     static int iQuitKeycode;
+    static std::vector<int> fontSizes;
 
     static bool IsConstellationConnected();
     static void GetConfig();
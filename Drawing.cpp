@@ -1,12 +1,34 @@
 #include "Drawing.hpp"
 #include "UI.hpp"
 #include "Config.hpp"
+#include "Fetcher.hpp"
+#include "Health.hpp"
+#include "Fonts.hpp"
 
 // define default values
 std::chrono::steady_clock::time_point Drawing::errorTime = std::chrono::steady_clock::time_point();
 bool Drawing::bDrawSettings = true;
 ImGuiID Drawing::lastKeyLabelID = 0;
 ImGuiKey Drawing::quitKey = ImGui_ImplWin32_KeyEventToImGuiKey(Config::iQuitKeycode, 0);
+std::vector<fc2::render> Drawing::retainedEntries;
+std::vector<Drawing::RetainedSlot> Drawing::retainedSlots;
+ImVector<ImDrawVert> Drawing::retainedVertices;
+ImVector<unsigned int> Drawing::retainedIndices;
+ImVector<ImDrawVert> Drawing::retainedSpareVertices;
+ImVector<unsigned int> Drawing::retainedSpareIndices;
+ImDrawList Drawing::retainedScratch(nullptr);
+Drawing::PrimitiveBucket Drawing::retainedBuckets[FC2_TEAM_DRAW_TYPE_CIRCLE_FILLED + 1];
+Drawing::PrimitiveBucket Drawing::retainedDirect;
+ImDrawListSharedData* Drawing::retainedData = nullptr;
+ImVec4 Drawing::retainedClipRect;
+ImFont* Drawing::retainedFont = nullptr;
+ImTextureID Drawing::retainedTexture = ImTextureID();
+ImDrawListFlags Drawing::retainedFlags = ImDrawListFlags_None;
+int Drawing::retainedOffsetLeft = 0;
+int Drawing::retainedOffsetTop = 0;
+uint64_t Drawing::retainedHits = 0;
+uint64_t Drawing::retainedMisses = 0;
+std::chrono::microseconds Drawing::overlayDrawTime{ 0 };
 
 /**
  * @brief Check if settings window should get closed
@@ -36,7 +58,7 @@ void Drawing::DrawSettings()
         else
         {
             ImGui::TextColored({ 0.9f, 0.1f, 0.0f, 1.0f }, "Not connected");
-            ImGui::Text("Launch Constellation and restart\nthe overlay");
+            ImGui::Text("Launch Constellation, the overlay\nwill connect automatically");
         }
 
         // draw overlay config options
@@ -61,7 +83,7 @@ void Drawing::DrawSettings()
         if (ImGui::InputInt("##Target FPS", &Config::iTargetFPS, 10, 50, ImGuiInputTextFlags_CharsDecimal | ImGuiInputTextFlags_ParseEmptyRefVal))
         {
             Config::iTargetFPS = std::min(1000, std::max(Config::iTargetFPS, 0));
-            Config::targetFrametime = std::chrono::microseconds(Config::iTargetFPS == 0 ? 1 : 1000000 / Config::iTargetFPS);
+            Config::targetFrametime = Config::iTargetFPS == 0 ? 1 : 1000000 / Config::iTargetFPS;
         }
 
         // minimum random dimensions offset setting
@@ -175,8 +197,8 @@ void Drawing::DrawSettings()
             ImGui::Text("UIAccess status: %d", (uint32_t)UI::dwUIAccessErr);
             ImGui::Text("Target handle: %d", (uint32_t)UI::hTargetWindow);
             ImGui::Text("Target process ID: %d", (uint32_t)UI::dTargetPID);
-            auto frametime = Config::targetFrametime.count();
-            ImGui::Text("Overlay target frametime:\n%llu microsecond%s", frametime, frametime == 1 ? "" : "s");
+            auto frametime = Config::targetFrametime.load();
+            ImGui::Text("Overlay target frametime:\n%lld microsecond%s", static_cast<long long>(frametime), frametime == 1 ? "" : "s");
             ImGui::Text("Custom quit keycode: %d", Config::iQuitKeycode);
         }
     }
@@ -188,12 +210,14 @@ void Drawing::DrawSettings()
  */
 void Drawing::DrawOverlay()
 {
-    if (fc2::get_error() == FC2_TEAM_ERROR_NO_ERROR)
+    if (Health::IsConnected())
     {
-        // get drawing requests from FC2
-        auto drawing = fc2::draw::get();
+        auto drawStart = std::chrono::steady_clock::now();
 
-        // get the default font
+        // get the newest drawing requests fetched in the background
+        const DrawingSnapshot& snapshot = Fetcher::GetSnapshot();
+
+        // the retained geometry depends on the font atlas, which every baked font size shares with the default font
         ImFont* font = ImGui::GetIO().Fonts->Fonts[0];
 
         // get drawing canvas to draw in the background
@@ -201,84 +225,19 @@ void Drawing::DrawOverlay()
 
         // clip the drawing area to prevent drawing outside of the target window area
         ImVec2 displaySize = ImGui::GetIO().DisplaySize;
-        canvas->PushClipRect({ 0.0f - Config::iOffsetLeft, 0.0f - Config::iOffsetTop }, { displaySize.x + Config::iOffsetRight, displaySize.y + Config::iOffsetBottom });
-
-        // loop over the drawing requests
-        for (auto& [text, dimensions, style] : drawing)
-        {
-            // subtract random offsets from the drawing positions
-            dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_LEFT] -= Config::iOffsetLeft;
-            dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_RIGHT] -= Config::iOffsetLeft;
-            dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_TOP] -= Config::iOffsetTop;
-            dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_BOTTOM] -= Config::iOffsetTop;
-
-            // draw a drop shadow for the text and then the text itself on top of it
-            if (style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_TEXT)
-            {
-                canvas->AddText(
-                    font,
-                    13.0f,
-                    ImVec2(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_LEFT] + 1.0f, dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_TOP] + 1.0f),
-                    ImColor(0, 0, 0, style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_ALPHA]),
-                    text
-                );
-
-                canvas->AddText(
-                    font,
-                    13.0f,
-                    ImVec2(static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_LEFT]), static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_TOP])),
-                    ImColor(style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_RED], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_GREEN], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_BLUE], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_ALPHA]),
-                    text
-                );
-            }
-
-            // draw a line
-            else if (style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_LINE)
-            {
-                canvas->AddLine(
-                    ImVec2(static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_LEFT]), static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_TOP])),
-                    ImVec2(static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_RIGHT]), static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_BOTTOM])),
-                    ImColor(style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_RED], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_GREEN], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_BLUE], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_ALPHA]),
-                    static_cast<float>(style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_THICKNESS])
-                );
-            }
-
-            // draw normal or filled boxes
-            else if (style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_BOX || style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_BOX_FILLED)
-            {
-                const auto min = ImVec2(static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_LEFT]), static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_TOP]));
-                const auto max = ImVec2(min.x + dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_RIGHT] + Config::iOffsetLeft, min.y + dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_BOTTOM] + Config::iOffsetTop);
-                const auto clr = ImColor(style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_RED], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_GREEN], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_BLUE], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_ALPHA]);
+        const ImVec4 clipRect(0.0f - Config::iOffsetLeft, 0.0f - Config::iOffsetTop, displaySize.x + Config::iOffsetRight, displaySize.y + Config::iOffsetBottom);
+        canvas->PushClipRect({ clipRect.x, clipRect.y }, { clipRect.z, clipRect.w });
 
-                if (style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_BOX)
-                {
-                    canvas->AddRect(min, max, clr, NULL, NULL, static_cast<float>(style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_THICKNESS]));
-                }
-                else
-                {
-                    canvas->AddRectFilled(min, max, clr);
-                }
-            }
-
-            // draw normal or filled circles
-            else if (style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_CIRCLE || style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_CIRCLE_FILLED)
-            {
-                const auto pos = ImVec2(static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_LEFT]), static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_TOP]));
-                const auto clr = ImColor(style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_RED], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_GREEN], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_BLUE], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_ALPHA]);
-
-                if (style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_CIRCLE)
-                {
-                    canvas->AddCircle(pos, static_cast<float>(style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_THICKNESS]), clr);
-                }
-                else
-                {
-                    canvas->AddCircleFilled(pos, static_cast<float>(style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_THICKNESS]), clr);
-                }
-            }
-        }
+        // FC2 usually hands out mostly the same drawing requests for several frames, only tessellate the ones that changed
+        if (UpdateRetainedSlots(snapshot.entries, canvas, font, clipRect))
+            SpliceSlots(canvas);
+        else
+            DrawSlotsDirectly(canvas);
 
         // remove the drawing area restriction
         canvas->PopClipRect();
+
+        overlayDrawTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - drawStart);
     }
 
     if (Config::bDebug)
@@ -303,11 +262,849 @@ void Drawing::DrawOverlay()
             ImGui::Text("Target window size - X: %.0f Y: %.0f", displaySize.x + Config::iOffsetLeft + Config::iOffsetRight, displaySize.y + Config::iOffsetTop + Config::iOffsetBottom);
             ImGui::Text("Offset Left: %d Offset Top: %d", Config::iOffsetLeft, Config::iOffsetTop);
             ImGui::Text("Offset Right: %d Offset Bottom: %d", Config::iOffsetRight, Config::iOffsetBottom);
+
+            // show how old the drawing requests are
+            const DrawingSnapshot& snapshot = Fetcher::GetSnapshot();
+            auto snapshotAge = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - snapshot.fetchTime);
+            ImGui::Text("Drawing snapshot #%llu age: %.3f ms", static_cast<unsigned long long>(snapshot.frame), snapshotAge.count() / 1000.0f);
+
+            // show how often tessellated drawing requests could be reused
+            const uint64_t retainedTotal = retainedHits + retainedMisses;
+            ImGui::Text("Draw cache slot hit rate: %.1f%%", retainedTotal ? 100.0 * retainedHits / retainedTotal : 0.0);
+            ImGui::Text("Drawing requests time: %.3f ms/frame", overlayDrawTime.count() / 1000.0f);
+
+            // show what the baked font sizes cost at startup
+            ImGui::Text("Font sizes: %d atlas: %dx%d baked in %.3f ms", Fonts::GetCount(), ImGui::GetIO().Fonts->TexWidth, ImGui::GetIO().Fonts->TexHeight, Fonts::GetBakeTime().count() / 1000.0f);
+
+            // show how fast Constellation answers the heartbeat
+            float rttMin, rttAvg, rttMax;
+            Health::GetRttStats(rttMin, rttAvg, rttMax);
+            ImGui::Text("Heartbeat RTT min/avg/max: %.3f/%.3f/%.3f ms", rttMin, rttAvg, rttMax);
+            Health::PlotRttHistory("##Heartbeat RTT", ImVec2(280.0f, 50.0f));
+
+            // show how long requests to FC2 take
+            if (ImGui::CollapsingHeader("Request latency"))
+            {
+                if (ImGui::BeginTable("##Request latency", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit))
+                {
+                    ImGui::TableSetupColumn("Request");
+                    ImGui::TableSetupColumn("Count");
+                    ImGui::TableSetupColumn("p50 (us)");
+                    ImGui::TableSetupColumn("p99 (us)");
+                    ImGui::TableSetupColumn("p99.9 (us)");
+                    ImGui::TableHeadersRow();
+
+                    for (int id = 0; id < fc2::detail::statistics::max_requests; id++)
+                    {
+                        const auto stats = fc2::stats::get(id);
+                        if (stats.count == 0)
+                            continue;
+
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(fc2::stats::name(id));
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", static_cast<unsigned long long>(stats.count));
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.1f", stats.p50.count() / 1000.0f);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.1f", stats.p99.count() / 1000.0f);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.1f", stats.p999.count() / 1000.0f);
+                    }
+
+                    ImGui::EndTable();
+                }
+
+                if (ImGui::Button("Reset"))
+                    fc2::stats::reset();
+            }
         }
         ImGui::End();
     }
 }
 
+/**
+ * @brief Check if the retained geometry was tessellated for the current draw list setup
+ * @param canvas Draw list the geometry gets spliced into
+ * @param font Font used for text
+ * @param clipRect Clip rectangle of the drawing area
+ * @return true if the geometry of unchanged slots can be reused as it is
+ */
+bool Drawing::IsRetainedStateValid(ImDrawList* canvas, ImFont* font, const ImVec4& clipRect)
+{
+    if (retainedData != canvas->_Data || retainedFont != font || retainedTexture != canvas->_CmdHeader.TextureId || retainedFlags != canvas->Flags)
+        return false;
+
+    // the offsets change whenever the target window moves
+    if (retainedOffsetLeft != Config::iOffsetLeft || retainedOffsetTop != Config::iOffsetTop)
+        return false;
+
+    return memcmp(&retainedClipRect, &clipRect, sizeof(ImVec4)) == 0;
+}
+
+/**
+ * @brief Tessellate the drawing requests that changed since the last frame
+ * @param entries Drawing requests of the current snapshot
+ * @param canvas Draw list the geometry gets spliced into
+ * @param font Font used for text
+ * @param clipRect Clip rectangle of the drawing area
+ * @return false if most drawing requests changed and the frame should be drawn directly instead
+ */
+bool Drawing::UpdateRetainedSlots(const std::vector<fc2::render>& entries, ImDrawList* canvas, ImFont* font, const ImVec4& clipRect)
+{
+    // every slot has to be tessellated again if anything they all depend on changed
+    const bool bStateValid = IsRetainedStateValid(canvas, font, clipRect);
+    if (!bStateValid)
+    {
+        retainedData = canvas->_Data;
+        retainedClipRect = clipRect;
+        retainedFont = font;
+        retainedTexture = canvas->_CmdHeader.TextureId;
+        retainedFlags = canvas->Flags;
+        retainedOffsetLeft = Config::iOffsetLeft;
+        retainedOffsetTop = Config::iOffsetTop;
+    }
+
+    // new slots start out empty behind the last one, an empty drawing request draws nothing either
+    const size_t previousSize = retainedSlots.size();
+    retainedEntries.resize(entries.size());
+    retainedSlots.resize(entries.size());
+    for (size_t i = previousSize; i < retainedSlots.size(); i++)
+    {
+        GeometryRange& geometry = retainedSlots[i].geometry;
+        if (i > 0)
+        {
+            const GeometryRange& previous = retainedSlots[i - 1].geometry;
+            geometry.vtxOffset = previous.vtxOffset + previous.vtxCount;
+            geometry.idxOffset = previous.idxOffset + previous.idxCount;
+        }
+    }
+
+    // find the drawing requests that changed
+    size_t changed = 0;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        // compare the drawing request byte by byte, this is cheaper than hashing it and can't collide
+        if (bStateValid && memcmp(&retainedEntries[i], &entries[i], sizeof(fc2::render)) == 0)
+            continue;
+
+        retainedEntries[i] = entries[i];
+        retainedSlots[i].bStale = true;
+        changed++;
+    }
+
+    // keeping the geometry of a slot costs more than tessellating it once, so it only pays off if most slots stay the same
+    if (changed * 2 > entries.size())
+    {
+        retainedMisses += entries.size();
+        return false;
+    }
+
+    for (auto& bucket : retainedBuckets)
+        bucket.slots.clear();
+
+    // sort the slots without up to date geometry into buckets by their type
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        RetainedSlot& slot = retainedSlots[i];
+        if (!slot.bStale)
+        {
+            retainedHits++;
+            continue;
+        }
+
+        slot.bStale = false;
+        slot.bFresh = true;
+        slot.fresh = GeometryRange();
+        retainedMisses++;
+
+        // empty slots and unknown types don't draw anything
+        const int type = retainedEntries[i].style[FC2_TEAM_DRAW_STYLE_TYPE];
+        if (IsDrawableType(type))
+            retainedBuckets[type].slots.push_back(static_cast<uint32_t>(i));
+    }
+
+    for (auto& bucket : retainedBuckets)
+        DecodeBucket(bucket);
+
+    // filled boxes, boxes and lines are written without ImGui, text and circles go through its tessellation
+    ResetScratch(canvas, clipRect);
+    WriteBucket(FC2_TEAM_DRAW_TYPE_BOX_FILLED);
+    WriteBucket(FC2_TEAM_DRAW_TYPE_BOX);
+    WriteBucket(FC2_TEAM_DRAW_TYPE_LINE);
+    TessellateBucket(FC2_TEAM_DRAW_TYPE_TEXT);
+    TessellateBucket(FC2_TEAM_DRAW_TYPE_CIRCLE);
+    TessellateBucket(FC2_TEAM_DRAW_TYPE_CIRCLE_FILLED);
+
+    CommitFreshSlots();
+    return true;
+}
+
+/**
+ * @brief Draw all slots straight into the draw list in their order, their geometry stays stale until a later frame needs it
+ * @param canvas Draw list to draw into
+ */
+void Drawing::DrawSlotsDirectly(ImDrawList* canvas)
+{
+    PrimitiveBucket& bucket = retainedDirect;
+    bucket.slots.clear();
+
+    for (size_t i = 0; i < retainedEntries.size(); i++)
+    {
+        if (IsDrawableType(retainedEntries[i].style[FC2_TEAM_DRAW_STYLE_TYPE]))
+            bucket.slots.push_back(static_cast<uint32_t>(i));
+    }
+
+    DecodeBucket(bucket);
+
+    // sorting by type would change which drawing request ends up on top, instead space for each run of filled boxes, boxes and lines is reserved at once
+    size_t i = 0;
+    while (i < bucket.slots.size())
+    {
+        size_t end = i;
+        int vtxTotal = 0;
+        int idxTotal = 0;
+        int vtxCount = 0;
+        int idxCount = 0;
+        while (end < bucket.slots.size() && vtxTotal < 4096 && GetFixedGeometry(canvas, retainedEntries[bucket.slots[end]].style[FC2_TEAM_DRAW_STYLE_TYPE], bucket, end, vtxCount, idxCount))
+        {
+            vtxTotal += vtxCount;
+            idxTotal += idxCount;
+            end++;
+        }
+
+        if (end == i)
+        {
+            DrawPrimitive(canvas, retainedEntries[bucket.slots[i]].style[FC2_TEAM_DRAW_STYLE_TYPE], bucket, i);
+            i++;
+            continue;
+        }
+
+        // PrimReserve starts a new vertex offset by itself if the run doesn't fit behind the existing vertices
+        if (vtxTotal > 0)
+            canvas->PrimReserve(idxTotal, vtxTotal);
+
+        for (; i < end; i++)
+        {
+            const int type = retainedEntries[bucket.slots[i]].style[FC2_TEAM_DRAW_STYLE_TYPE];
+            GetFixedGeometry(canvas, type, bucket, i, vtxCount, idxCount);
+            WriteFixedGeometry(canvas, type, bucket, i, canvas->_VtxWritePtr, canvas->_IdxWritePtr, canvas->_VtxCurrentIdx);
+            canvas->_VtxWritePtr += vtxCount;
+            canvas->_IdxWritePtr += idxCount;
+            canvas->_VtxCurrentIdx += vtxCount;
+        }
+    }
+}
+
+/**
+ * @brief Check if a drawing request type draws anything
+ * @param type Value of FC2_TEAM_DRAW_STYLE_TYPE
+ */
+bool Drawing::IsDrawableType(int type)
+{
+    return type > FC2_TEAM_DRAW_TYPE_NONE && type < IM_ARRAYSIZE(retainedBuckets);
+}
+
+/**
+ * @brief Convert the drawing requests of a bucket into positions, colors and sizes ImGui can use directly
+ * @param bucket Bucket with the slots to decode
+ */
+void Drawing::DecodeBucket(PrimitiveBucket& bucket)
+{
+    const size_t count = bucket.slots.size();
+    bucket.left.resize(count);
+    bucket.top.resize(count);
+    bucket.right.resize(count);
+    bucket.bottom.resize(count);
+    bucket.colors.resize(count);
+    bucket.sizes.resize(count);
+    bucket.fontSizes.resize(count);
+
+    size_t i = 0;
+
+#ifdef DRAWING_DECODE_SSE2
+    for (; i + 4 <= count; i += 4)
+        DecodeEntriesSSE2(bucket, i);
+#endif
+
+    for (; i < count; i++)
+        DecodeEntry(bucket, i);
+}
+
+/**
+ * @brief Decode a single drawing request of a bucket
+ * @param bucket Bucket with the slots to decode
+ * @param i Index of the drawing request in the bucket
+ */
+void Drawing::DecodeEntry(PrimitiveBucket& bucket, size_t i)
+{
+    const auto& [text, dimensions, style] = retainedEntries[bucket.slots[i]];
+
+    // subtract random offsets from the drawing positions
+    bucket.left[i] = static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_LEFT] - Config::iOffsetLeft);
+    bucket.top[i] = static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_TOP] - Config::iOffsetTop);
+
+    // boxes send their size instead of a second point, add the offset back in the same order the positions always got calculated in
+    const float right = static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_RIGHT] - Config::iOffsetLeft);
+    const float bottom = static_cast<float>(dimensions[FC2_TEAM_DRAW_DIMENSIONS::FC2_TEAM_DRAW_DIMENSIONS_BOTTOM] - Config::iOffsetTop);
+    if (style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_BOX || style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_BOX_FILLED)
+    {
+        bucket.right[i] = bucket.left[i] + right + static_cast<float>(Config::iOffsetLeft);
+        bucket.bottom[i] = bucket.top[i] + bottom + static_cast<float>(Config::iOffsetTop);
+    }
+    else
+    {
+        bucket.right[i] = right;
+        bucket.bottom[i] = bottom;
+    }
+
+    bucket.colors[i] = ImColor(style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_RED], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_GREEN], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_BLUE], style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_ALPHA]);
+    bucket.sizes[i] = static_cast<float>(style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_THICKNESS]);
+
+    // text without a font size keeps the size it always had
+    const int fontSize = style[FC2_TEAM_DRAW_STYLE::FC2_TEAM_DRAW_STYLE_FONT_SIZE];
+    bucket.fontSizes[i] = fontSize > 0 ? static_cast<float>(fontSize) : Fonts::defaultSize;
+}
+
+#ifdef DRAWING_DECODE_SSE2
+/**
+ * @brief Decode four drawing requests of a bucket at once, the results are exactly the same as the ones of DecodeEntry
+ * @param bucket Bucket with the slots to decode
+ * @param i Index of the first of the four drawing requests in the bucket
+ */
+void Drawing::DecodeEntriesSSE2(PrimitiveBucket& bucket, size_t i)
+{
+    const fc2::render& entry0 = retainedEntries[bucket.slots[i + 0]];
+    const fc2::render& entry1 = retainedEntries[bucket.slots[i + 1]];
+    const fc2::render& entry2 = retainedEntries[bucket.slots[i + 2]];
+    const fc2::render& entry3 = retainedEntries[bucket.slots[i + 3]];
+
+    // subtract random offsets from the drawing positions, then turn the registers with one drawing request each into one coordinate each
+    const __m128i offsets = _mm_setr_epi32(Config::iOffsetLeft, Config::iOffsetTop, Config::iOffsetLeft, Config::iOffsetTop);
+    __m128 left = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(entry0.dimensions)), offsets));
+    __m128 top = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(entry1.dimensions)), offsets));
+    __m128 right = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(entry2.dimensions)), offsets));
+    __m128 bottom = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(entry3.dimensions)), offsets));
+    _MM_TRANSPOSE4_PS(left, top, right, bottom);
+
+    // boxes send their size instead of a second point, add the offset back in the same order DecodeEntry does
+    const __m128i types = _mm_setr_epi32(entry0.style[FC2_TEAM_DRAW_STYLE_TYPE], entry1.style[FC2_TEAM_DRAW_STYLE_TYPE], entry2.style[FC2_TEAM_DRAW_STYLE_TYPE], entry3.style[FC2_TEAM_DRAW_STYLE_TYPE]);
+    const __m128 boxes = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(types, _mm_set1_epi32(FC2_TEAM_DRAW_TYPE_BOX)), _mm_cmpeq_epi32(types, _mm_set1_epi32(FC2_TEAM_DRAW_TYPE_BOX_FILLED))));
+    const __m128 boxRight = _mm_add_ps(_mm_add_ps(left, right), _mm_set1_ps(static_cast<float>(Config::iOffsetLeft)));
+    const __m128 boxBottom = _mm_add_ps(_mm_add_ps(top, bottom), _mm_set1_ps(static_cast<float>(Config::iOffsetTop)));
+    right = _mm_or_ps(_mm_and_ps(boxes, boxRight), _mm_andnot_ps(boxes, right));
+    bottom = _mm_or_ps(_mm_and_ps(boxes, boxBottom), _mm_andnot_ps(boxes, bottom));
+
+    _mm_storeu_ps(bucket.left.data() + i, left);
+    _mm_storeu_ps(bucket.top.data() + i, top);
+    _mm_storeu_ps(bucket.right.data() + i, right);
+    _mm_storeu_ps(bucket.bottom.data() + i, bottom);
+
+    // ImColor clamps every channel to 0-255, the saturating packs do the same while packing them into RGBA8
+    __m128i color0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entry0.style));
+    __m128i color1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entry1.style));
+    __m128i color2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entry2.style));
+    __m128i color3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entry3.style));
+#ifdef IMGUI_USE_BGRA_PACKED_COLOR
+    color0 = _mm_shuffle_epi32(color0, _MM_SHUFFLE(3, 0, 1, 2));
+    color1 = _mm_shuffle_epi32(color1, _MM_SHUFFLE(3, 0, 1, 2));
+    color2 = _mm_shuffle_epi32(color2, _MM_SHUFFLE(3, 0, 1, 2));
+    color3 = _mm_shuffle_epi32(color3, _MM_SHUFFLE(3, 0, 1, 2));
+#endif
+    const __m128i colors = _mm_packus_epi16(_mm_packs_epi32(color0, color1), _mm_packs_epi32(color2, color3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(bucket.colors.data() + i), colors);
+
+    const __m128i sizes = _mm_setr_epi32(entry0.style[FC2_TEAM_DRAW_STYLE_THICKNESS], entry1.style[FC2_TEAM_DRAW_STYLE_THICKNESS], entry2.style[FC2_TEAM_DRAW_STYLE_THICKNESS], entry3.style[FC2_TEAM_DRAW_STYLE_THICKNESS]);
+    _mm_storeu_ps(bucket.sizes.data() + i, _mm_cvtepi32_ps(sizes));
+
+    const __m128i fontSizes = _mm_setr_epi32(entry0.style[FC2_TEAM_DRAW_STYLE_FONT_SIZE], entry1.style[FC2_TEAM_DRAW_STYLE_FONT_SIZE], entry2.style[FC2_TEAM_DRAW_STYLE_FONT_SIZE], entry3.style[FC2_TEAM_DRAW_STYLE_FONT_SIZE]);
+    const __m128 hasFontSize = _mm_castsi128_ps(_mm_cmpgt_epi32(fontSizes, _mm_setzero_si128()));
+    _mm_storeu_ps(bucket.fontSizes.data() + i, _mm_or_ps(_mm_and_ps(hasFontSize, _mm_cvtepi32_ps(fontSizes)), _mm_andnot_ps(hasFontSize, _mm_set1_ps(Fonts::defaultSize))));
+}
+#endif
+
+/**
+ * @brief Get the size of the geometry ImGui gives a drawing request if it is always the same for its type
+ * @param list Draw list the drawing request gets drawn into
+ * @param type Type of the drawing request
+ * @param bucket Bucket the drawing request was decoded into
+ * @param i Index of the drawing request in the bucket
+ * @param vtxCount Number of vertices, 0 if it isn't visible
+ * @param idxCount Number of indices, 0 if it isn't visible
+ * @return False if ImGui has to tessellate it, like text, circles and lines it doesn't draw with the baked line texture
+ */
+bool Drawing::GetFixedGeometry(const ImDrawList* list, int type, const PrimitiveBucket& bucket, size_t i, int& vtxCount, int& idxCount)
+{
+    vtxCount = 0;
+    idxCount = 0;
+
+    if (type != FC2_TEAM_DRAW_TYPE_BOX_FILLED && type != FC2_TEAM_DRAW_TYPE_BOX && type != FC2_TEAM_DRAW_TYPE_LINE)
+        return false;
+
+    // boxes and lines are only two triangles per edge if ImGui uses the baked line texture for them, the same checks ImDrawList::AddPolyline makes
+    if (type != FC2_TEAM_DRAW_TYPE_BOX_FILLED)
+    {
+        if (!(list->Flags & ImDrawListFlags_AntiAliasedLines) || !(list->Flags & ImDrawListFlags_AntiAliasedLinesUseTex) || list->_FringeScale != 1.0f)
+            return false;
+
+        const float thickness = ImMax(bucket.sizes[i], 1.0f);
+        const int integerThickness = static_cast<int>(thickness);
+        if (integerThickness >= IM_DRAWLIST_TEX_LINES_WIDTH_MAX || thickness - integerThickness > 0.00001f)
+            return false;
+    }
+
+    // invisible drawing requests are skipped by ImGui
+    if ((bucket.colors[i] & IM_COL32_A_MASK) == 0)
+        return true;
+
+    vtxCount = type == FC2_TEAM_DRAW_TYPE_BOX ? 8 : 4;
+    idxCount = type == FC2_TEAM_DRAW_TYPE_BOX ? 24 : 6;
+    return true;
+}
+
+/**
+ * @brief Write the geometry of a filled box, box or line exactly like ImDrawList::AddRectFilled, AddRect and AddLine do
+ * @param list Draw list the geometry is for
+ * @param type Type of the drawing request, GetFixedGeometry has to be true for it
+ * @param bucket Bucket the drawing request was decoded into
+ * @param i Index of the drawing request in the bucket
+ * @param vtx Where to write the vertices
+ * @param idx Where to write the indices
+ * @param vtxIndex Index of the first vertex
+ */
+void Drawing::WriteFixedGeometry(const ImDrawList* list, int type, const PrimitiveBucket& bucket, size_t i, ImDrawVert* vtx, ImDrawIdx* idx, unsigned int vtxIndex)
+{
+    const ImU32 col = bucket.colors[i];
+    if ((col & IM_COL32_A_MASK) == 0)
+        return;
+
+    const ImVec2 min(bucket.left[i], bucket.top[i]);
+    const ImVec2 max(bucket.right[i], bucket.bottom[i]);
+
+    if (type == FC2_TEAM_DRAW_TYPE_BOX_FILLED)
+    {
+        const ImVec2 uv = list->_Data->TexUvWhitePixel;
+        vtx[0].pos = min; vtx[0].uv = uv; vtx[0].col = col;
+        vtx[1].pos = ImVec2(max.x, min.y); vtx[1].uv = uv; vtx[1].col = col;
+        vtx[2].pos = max; vtx[2].uv = uv; vtx[2].col = col;
+        vtx[3].pos = ImVec2(min.x, max.y); vtx[3].uv = uv; vtx[3].col = col;
+        idx[0] = static_cast<ImDrawIdx>(vtxIndex); idx[1] = static_cast<ImDrawIdx>(vtxIndex + 1); idx[2] = static_cast<ImDrawIdx>(vtxIndex + 2);
+        idx[3] = static_cast<ImDrawIdx>(vtxIndex); idx[4] = static_cast<ImDrawIdx>(vtxIndex + 2); idx[5] = static_cast<ImDrawIdx>(vtxIndex + 3);
+        return;
+    }
+
+    const float thickness = ImMax(bucket.sizes[i], 1.0f);
+    const ImVec4& uvs = list->_Data->TexUvLines[static_cast<int>(thickness)];
+
+    // boxes are a closed path through their corners, moved half a pixel inside, lines are moved half a pixel to the bottom right
+    if (type == FC2_TEAM_DRAW_TYPE_BOX)
+    {
+        const ImVec2 a(min.x + 0.50f, min.y + 0.50f);
+        const ImVec2 b(max.x - 0.50f, max.y - 0.50f);
+        const ImVec2 points[4] = { a, ImVec2(b.x, a.y), b, ImVec2(a.x, b.y) };
+        WriteStroke(points, 4, true, col, thickness, uvs, vtx, idx, vtxIndex);
+    }
+    else
+    {
+        const ImVec2 points[2] = { ImVec2(min.x + 0.5f, min.y + 0.5f), ImVec2(max.x + 0.5f, max.y + 0.5f) };
+        WriteStroke(points, 2, false, col, thickness, uvs, vtx, idx, vtxIndex);
+    }
+}
+
+/**
+ * @brief Write a path of up to four points drawn with the baked line texture, the same computations in the same order as ImDrawList::AddPolyline
+ * @param points Points of the path
+ * @param pointsCount Number of points, 2 to 4
+ * @param bClosed Connect the last point with the first one
+ * @param col Color of the path
+ * @param thickness Thickness of the path, at least 1
+ * @param uvs Texture coordinates of the baked line of this thickness
+ * @param vtx Where to write the pointsCount * 2 vertices
+ * @param idx Where to write the 6 indices per segment
+ * @param vtxIndex Index of the first vertex
+ */
+void Drawing::WriteStroke(const ImVec2* points, int pointsCount, bool bClosed, ImU32 col, float thickness, const ImVec4& uvs, ImDrawVert* vtx, ImDrawIdx* idx, unsigned int vtxIndex)
+{
+    const int count = bClosed ? pointsCount : pointsCount - 1;
+    ImVec2 normals[4];
+    ImVec2 edges[8];
+
+    // normals of every segment
+    for (int i1 = 0; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == pointsCount ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        const float d2 = dx * dx + dy * dy;
+        if (d2 > 0.0f)
+        {
+            const float invLength = ImRsqrt(d2);
+            dx *= invLength;
+            dy *= invLength;
+        }
+        normals[i1].x = dy;
+        normals[i1].y = -dx;
+    }
+    if (!bClosed)
+        normals[pointsCount - 1] = normals[pointsCount - 2];
+
+    const float halfDrawSize = (thickness * 0.5f) + 1;
+    if (!bClosed)
+    {
+        edges[0] = ImVec2(points[0].x + normals[0].x * halfDrawSize, points[0].y + normals[0].y * halfDrawSize);
+        edges[1] = ImVec2(points[0].x - normals[0].x * halfDrawSize, points[0].y - normals[0].y * halfDrawSize);
+        const ImVec2& last = points[pointsCount - 1];
+        const ImVec2& normal = normals[pointsCount - 1];
+        edges[(pointsCount - 1) * 2 + 0] = ImVec2(last.x + normal.x * halfDrawSize, last.y + normal.y * halfDrawSize);
+        edges[(pointsCount - 1) * 2 + 1] = ImVec2(last.x - normal.x * halfDrawSize, last.y - normal.y * halfDrawSize);
+    }
+
+    // both edges at every point from the averaged normals of its segments, and two triangles per segment
+    unsigned int idx1 = vtxIndex;
+    for (int i1 = 0; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == pointsCount ? 0 : i1 + 1;
+        const unsigned int idx2 = (i1 + 1) == pointsCount ? vtxIndex : idx1 + 2;
+
+        float dmX = (normals[i1].x + normals[i2].x) * 0.5f;
+        float dmY = (normals[i1].y + normals[i2].y) * 0.5f;
+        const float d2 = dmX * dmX + dmY * dmY;
+        if (d2 > 0.000001f)
+        {
+            float invLength2 = 1.0f / d2;
+            if (invLength2 > 100.0f)
+                invLength2 = 100.0f;
+            dmX *= invLength2;
+            dmY *= invLength2;
+        }
+        dmX *= halfDrawSize;
+        dmY *= halfDrawSize;
+
+        edges[i2 * 2 + 0].x = points[i2].x + dmX;
+        edges[i2 * 2 + 0].y = points[i2].y + dmY;
+        edges[i2 * 2 + 1].x = points[i2].x - dmX;
+        edges[i2 * 2 + 1].y = points[i2].y - dmY;
+
+        idx[0] = static_cast<ImDrawIdx>(idx2 + 0); idx[1] = static_cast<ImDrawIdx>(idx1 + 0); idx[2] = static_cast<ImDrawIdx>(idx1 + 1);
+        idx[3] = static_cast<ImDrawIdx>(idx2 + 1); idx[4] = static_cast<ImDrawIdx>(idx1 + 1); idx[5] = static_cast<ImDrawIdx>(idx2 + 0);
+        idx += 6;
+
+        idx1 = idx2;
+    }
+
+    const ImVec2 uv0(uvs.x, uvs.y);
+    const ImVec2 uv1(uvs.z, uvs.w);
+    for (int i = 0; i < pointsCount; i++)
+    {
+        vtx[0].pos = edges[i * 2 + 0]; vtx[0].uv = uv0; vtx[0].col = col;
+        vtx[1].pos = edges[i * 2 + 1]; vtx[1].uv = uv1; vtx[1].col = col;
+        vtx += 2;
+    }
+}
+
+/**
+ * @brief Write the geometry of a bucket of filled boxes, boxes or lines into the scratch draw list, reserving space for the whole bucket at once
+ * @param type Type of the drawing requests in the bucket
+ */
+void Drawing::WriteBucket(int type)
+{
+    const PrimitiveBucket& bucket = retainedBuckets[type];
+
+    int vtxTotal = 0;
+    int idxTotal = 0;
+    int vtxCount = 0;
+    int idxCount = 0;
+    for (size_t i = 0; i < bucket.slots.size(); i++)
+    {
+        if (GetFixedGeometry(&retainedScratch, type, bucket, i, vtxCount, idxCount))
+        {
+            vtxTotal += vtxCount;
+            idxTotal += idxCount;
+        }
+    }
+
+    int vtxOffset = retainedScratch.VtxBuffer.Size;
+    int idxOffset = retainedScratch.IdxBuffer.Size;
+    retainedScratch.VtxBuffer.resize(vtxOffset + vtxTotal);
+    retainedScratch.IdxBuffer.resize(idxOffset + idxTotal);
+
+    // every slot gets indices starting at its first vertex, so the scratch list never needs a second vertex offset
+    for (size_t i = 0; i < bucket.slots.size(); i++)
+    {
+        if (!GetFixedGeometry(&retainedScratch, type, bucket, i, vtxCount, idxCount))
+            continue;
+
+        WriteFixedGeometry(&retainedScratch, type, bucket, i, retainedScratch.VtxBuffer.Data + vtxOffset, retainedScratch.IdxBuffer.Data + idxOffset, 0);
+
+        RetainedSlot& slot = retainedSlots[bucket.slots[i]];
+        slot.fresh = { vtxOffset, vtxCount, idxOffset, idxCount };
+        vtxOffset += vtxCount;
+        idxOffset += idxCount;
+    }
+
+    // thick lines and lines without the baked line texture are left to ImGui
+    for (size_t i = 0; i < bucket.slots.size(); i++)
+    {
+        if (GetFixedGeometry(&retainedScratch, type, bucket, i, vtxCount, idxCount))
+            continue;
+
+        RetainedSlot& slot = retainedSlots[bucket.slots[i]];
+        retainedScratch._VtxCurrentIdx = 0;
+        slot.fresh.vtxOffset = retainedScratch.VtxBuffer.Size;
+        slot.fresh.idxOffset = retainedScratch.IdxBuffer.Size;
+
+        DrawPrimitive(&retainedScratch, type, bucket, i);
+
+        slot.fresh.vtxCount = retainedScratch.VtxBuffer.Size - slot.fresh.vtxOffset;
+        slot.fresh.idxCount = retainedScratch.IdxBuffer.Size - slot.fresh.idxOffset;
+    }
+}
+
+/**
+ * @brief Tessellate the drawing requests of a bucket into the scratch draw list
+ * @param type Type of the drawing requests in the bucket
+ */
+void Drawing::TessellateBucket(int type)
+{
+    const PrimitiveBucket& bucket = retainedBuckets[type];
+
+    for (size_t i = 0; i < bucket.slots.size(); i++)
+    {
+        RetainedSlot& slot = retainedSlots[bucket.slots[i]];
+
+        // every slot gets indices starting at its first vertex, so the scratch list never needs a second vertex offset
+        retainedScratch._VtxCurrentIdx = 0;
+        slot.fresh.vtxOffset = retainedScratch.VtxBuffer.Size;
+        slot.fresh.idxOffset = retainedScratch.IdxBuffer.Size;
+
+        DrawPrimitive(&retainedScratch, type, bucket, i);
+
+        slot.fresh.vtxCount = retainedScratch.VtxBuffer.Size - slot.fresh.vtxOffset;
+        slot.fresh.idxCount = retainedScratch.IdxBuffer.Size - slot.fresh.idxOffset;
+    }
+}
+
+/**
+ * @brief Draw a single decoded drawing request
+ * @param canvas Draw list to draw into
+ * @param type Type of the drawing request
+ * @param bucket Bucket the drawing request was decoded into
+ * @param i Index of the drawing request in the bucket
+ */
+void Drawing::DrawPrimitive(ImDrawList* canvas, int type, const PrimitiveBucket& bucket, size_t i)
+{
+    const ImVec2 min(bucket.left[i], bucket.top[i]);
+    const ImVec2 max(bucket.right[i], bucket.bottom[i]);
+
+    // draw a drop shadow for the text and then the text itself on top of it, using the baked font closest to the requested size
+    if (type == FC2_TEAM_DRAW_TYPE_TEXT)
+    {
+        const char* text = retainedEntries[bucket.slots[i]].text;
+        ImFont* font = Fonts::Get(bucket.fontSizes[i]);
+        canvas->AddText(font, bucket.fontSizes[i], ImVec2(min.x + 1.0f, min.y + 1.0f), bucket.colors[i] & IM_COL32_A_MASK, text);
+        canvas->AddText(font, bucket.fontSizes[i], min, bucket.colors[i], text);
+    }
+
+    // draw a line
+    else if (type == FC2_TEAM_DRAW_TYPE_LINE)
+    {
+        canvas->AddLine(min, max, bucket.colors[i], bucket.sizes[i]);
+    }
+
+    // draw normal or filled boxes
+    else if (type == FC2_TEAM_DRAW_TYPE_BOX)
+    {
+        canvas->AddRect(min, max, bucket.colors[i], NULL, NULL, bucket.sizes[i]);
+    }
+    else if (type == FC2_TEAM_DRAW_TYPE_BOX_FILLED)
+    {
+        canvas->AddRectFilled(min, max, bucket.colors[i]);
+    }
+
+    // draw normal or filled circles
+    else if (type == FC2_TEAM_DRAW_TYPE_CIRCLE)
+    {
+        canvas->AddCircle(min, bucket.sizes[i], bucket.colors[i]);
+    }
+    else if (type == FC2_TEAM_DRAW_TYPE_CIRCLE_FILLED)
+    {
+        canvas->AddCircleFilled(min, bucket.sizes[i], bucket.colors[i]);
+    }
+}
+
+/**
+ * @brief Set the scratch draw list up like the background draw list, so the tessellation is exactly the same
+ * @param canvas Draw list the geometry gets spliced into
+ * @param clipRect Clip rectangle of the drawing area
+ */
+void Drawing::ResetScratch(ImDrawList* canvas, const ImVec4& clipRect)
+{
+    retainedScratch._Data = canvas->_Data;
+    retainedScratch._ResetForNewFrame();
+    retainedScratch.Flags = canvas->Flags;
+    retainedScratch.PushTextureID(canvas->_CmdHeader.TextureId);
+    retainedScratch.PushClipRect({ clipRect.x, clipRect.y }, { clipRect.z, clipRect.w });
+}
+
+/**
+ * @brief Move the geometry of the slots tessellated this frame from the scratch draw list into the retained geometry
+ */
+void Drawing::CommitFreshSlots()
+{
+    // moving ESP boxes usually keep their vertex count, then their geometry can be overwritten where it is
+    bool bSameLayout = true;
+    for (const auto& slot : retainedSlots)
+    {
+        if (slot.bFresh && (slot.fresh.vtxCount != slot.geometry.vtxCount || slot.fresh.idxCount != slot.geometry.idxCount))
+        {
+            bSameLayout = false;
+            break;
+        }
+    }
+
+    if (bSameLayout)
+    {
+        for (auto& slot : retainedSlots)
+        {
+            if (!slot.bFresh)
+                continue;
+
+            CopyFreshSlot(slot, slot.geometry, retainedVertices, retainedIndices);
+            slot.bFresh = false;
+        }
+        return;
+    }
+
+    // otherwise lay all slots out again, unchanged ones are copied over from the current geometry
+    int vtxTotal = 0;
+    int idxTotal = 0;
+    for (const auto& slot : retainedSlots)
+    {
+        vtxTotal += slot.bFresh ? slot.fresh.vtxCount : slot.geometry.vtxCount;
+        idxTotal += slot.bFresh ? slot.fresh.idxCount : slot.geometry.idxCount;
+    }
+
+    retainedSpareVertices.resize(vtxTotal);
+    retainedSpareIndices.resize(idxTotal);
+
+    int vtxOffset = 0;
+    int idxOffset = 0;
+    for (size_t first = 0; first < retainedSlots.size();)
+    {
+        RetainedSlot& slot = retainedSlots[first];
+        if (slot.bFresh)
+        {
+            slot.geometry.vtxOffset = vtxOffset;
+            slot.geometry.vtxCount = slot.fresh.vtxCount;
+            slot.geometry.idxOffset = idxOffset;
+            slot.geometry.idxCount = slot.fresh.idxCount;
+            CopyFreshSlot(slot, slot.geometry, retainedSpareVertices, retainedSpareIndices);
+            slot.bFresh = false;
+
+            vtxOffset += slot.geometry.vtxCount;
+            idxOffset += slot.geometry.idxCount;
+            first++;
+            continue;
+        }
+
+        // unchanged slots in a row are stored back to back in both layouts, so they are copied together
+        const GeometryRange start = slot.geometry;
+        const unsigned int delta = static_cast<unsigned int>(vtxOffset - start.vtxOffset);
+
+        size_t last = first;
+        for (; last < retainedSlots.size() && !retainedSlots[last].bFresh; last++)
+        {
+            retainedSlots[last].geometry.vtxOffset += vtxOffset - start.vtxOffset;
+            retainedSlots[last].geometry.idxOffset += idxOffset - start.idxOffset;
+        }
+
+        const GeometryRange& end = retainedSlots[last - 1].geometry;
+        const int vtxCount = end.vtxOffset + end.vtxCount - vtxOffset;
+        const int idxCount = end.idxOffset + end.idxCount - idxOffset;
+
+        if (vtxCount > 0)
+            memcpy(retainedSpareVertices.Data + vtxOffset, retainedVertices.Data + start.vtxOffset, vtxCount * sizeof(ImDrawVert));
+
+        const unsigned int* src = retainedIndices.Data + start.idxOffset;
+        unsigned int* dst = retainedSpareIndices.Data + idxOffset;
+        for (int i = 0; i < idxCount; i++)
+            dst[i] = src[i] + delta;
+
+        vtxOffset += vtxCount;
+        idxOffset += idxCount;
+        first = last;
+    }
+
+    retainedVertices.swap(retainedSpareVertices);
+    retainedIndices.swap(retainedSpareIndices);
+}
+
+/**
+ * @brief Copy the geometry of a slot from the scratch draw list into retained geometry buffers
+ * @param slot Slot tessellated this frame
+ * @param geometry Where the geometry goes in the destination buffers
+ * @param vertices Destination vertex buffer
+ * @param indices Destination index buffer, indices count from its first vertex
+ */
+void Drawing::CopyFreshSlot(const RetainedSlot& slot, const GeometryRange& geometry, ImVector<ImDrawVert>& vertices, ImVector<unsigned int>& indices)
+{
+    if (geometry.vtxCount > 0)
+        memcpy(vertices.Data + geometry.vtxOffset, retainedScratch.VtxBuffer.Data + slot.fresh.vtxOffset, geometry.vtxCount * sizeof(ImDrawVert));
+
+    const ImDrawIdx* src = retainedScratch.IdxBuffer.Data + slot.fresh.idxOffset;
+    unsigned int* dst = indices.Data + geometry.idxOffset;
+    const unsigned int base = static_cast<unsigned int>(geometry.vtxOffset);
+    for (int i = 0; i < geometry.idxCount; i++)
+        dst[i] = src[i] + base;
+}
+
+/**
+ * @brief Append the retained geometry of all slots to the current draw command
+ * @param canvas Draw list to append to, its current clip rectangle and texture are used
+ */
+void Drawing::SpliceSlots(ImDrawList* canvas)
+{
+    // highest vertex count a single reservation may have, so its indices fit into ImDrawIdx
+    constexpr int maxChunkVertices = sizeof(ImDrawIdx) == 2 ? (1 << 16) - 1 : INT_MAX;
+
+    for (size_t first = 0; first < retainedSlots.size();)
+    {
+        // collect a run of slots to copy with a single reservation, their geometry is stored back to back
+        size_t last = first;
+        int vtxCount = 0;
+        int idxCount = 0;
+        while (last < retainedSlots.size() && (last == first || vtxCount + retainedSlots[last].geometry.vtxCount <= maxChunkVertices))
+        {
+            vtxCount += retainedSlots[last].geometry.vtxCount;
+            idxCount += retainedSlots[last].geometry.idxCount;
+            last++;
+        }
+
+        if (idxCount > 0)
+        {
+            // PrimReserve starts a new vertex offset by itself if the run doesn't fit behind the existing vertices
+            canvas->PrimReserve(idxCount, vtxCount);
+
+            const GeometryRange& start = retainedSlots[first].geometry;
+            memcpy(canvas->_VtxWritePtr, retainedVertices.Data + start.vtxOffset, vtxCount * sizeof(ImDrawVert));
+
+            // rebase the indices, local pointers let the compiler vectorize this
+            const unsigned int* src = retainedIndices.Data + start.idxOffset;
+            ImDrawIdx* dst = canvas->_IdxWritePtr;
+            const unsigned int delta = canvas->_VtxCurrentIdx - static_cast<unsigned int>(start.vtxOffset);
+            for (int i = 0; i < idxCount; i++)
+                dst[i] = static_cast<ImDrawIdx>(src[i] + delta);
+
+            canvas->_VtxWritePtr += vtxCount;
+            canvas->_IdxWritePtr += idxCount;
+            canvas->_VtxCurrentIdx += vtxCount;
+        }
+
+        first = last;
+    }
+}
+
 /**
  * @brief Filter input characters with specified rules
  * @param data ImGui callback data for the input text
@@ -3,6 +3,11 @@
 
 #include "pch.hpp"
 
+// decode drawing requests four at a time where SSE2 is available
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define DRAWING_DECODE_SSE2
+#endif
+
 class Drawing
 {
 private:
@@ -10,6 +15,78 @@ private:
     static bool bDrawSettings;
     static ImGuiID lastKeyLabelID;
 
+    // where the tessellated output of a drawing request slot is stored
+    struct GeometryRange
+    {
+        int vtxOffset = 0;
+        int vtxCount = 0;
+        int idxOffset = 0;
+        int idxCount = 0;
+    };
+
+    // retained geometry of one drawing request slot, and its new geometry in the scratch draw list while it gets tessellated again
+    struct RetainedSlot
+    {
+        bool bStale = false;
+        bool bFresh = false;
+        GeometryRange geometry;
+        GeometryRange fresh;
+    };
+
+    // changed drawing requests of one type, decoded into one array per field
+    struct PrimitiveBucket
+    {
+        std::vector<uint32_t> slots;
+        std::vector<float> left;
+        std::vector<float> top;
+        std::vector<float> right;
+        std::vector<float> bottom;
+        std::vector<ImU32> colors;
+        std::vector<float> sizes;
+        std::vector<float> fontSizes;
+    };
+
+    // geometry of all slots stored back to back and everything it depends on
+    static std::vector<fc2::render> retainedEntries;
+    static std::vector<RetainedSlot> retainedSlots;
+    static ImVector<ImDrawVert> retainedVertices;
+    static ImVector<unsigned int> retainedIndices;
+    static ImVector<ImDrawVert> retainedSpareVertices;
+    static ImVector<unsigned int> retainedSpareIndices;
+    static ImDrawList retainedScratch;
+    static PrimitiveBucket retainedBuckets[FC2_TEAM_DRAW_TYPE_CIRCLE_FILLED + 1];
+    static PrimitiveBucket retainedDirect;
+    static ImDrawListSharedData* retainedData;
+    static ImVec4 retainedClipRect;
+    static ImFont* retainedFont;
+    static ImTextureID retainedTexture;
+    static ImDrawListFlags retainedFlags;
+    static int retainedOffsetLeft;
+    static int retainedOffsetTop;
+    static uint64_t retainedHits;
+    static uint64_t retainedMisses;
+    static std::chrono::microseconds overlayDrawTime;
+
+    static bool IsRetainedStateValid(ImDrawList* canvas, ImFont* font, const ImVec4& clipRect);
+    static bool UpdateRetainedSlots(const std::vector<fc2::render>& entries, ImDrawList* canvas, ImFont* font, const ImVec4& clipRect);
+    static void DrawSlotsDirectly(ImDrawList* canvas);
+    static bool IsDrawableType(int type);
+    static void DecodeBucket(PrimitiveBucket& bucket);
+    static void DecodeEntry(PrimitiveBucket& bucket, size_t i);
+#ifdef DRAWING_DECODE_SSE2
+    static void DecodeEntriesSSE2(PrimitiveBucket& bucket, size_t i);
+#endif
+    static bool GetFixedGeometry(const ImDrawList* list, int type, const PrimitiveBucket& bucket, size_t i, int& vtxCount, int& idxCount);
+    static void WriteFixedGeometry(const ImDrawList* list, int type, const PrimitiveBucket& bucket, size_t i, ImDrawVert* vtx, ImDrawIdx* idx, unsigned int vtxIndex);
+    static void WriteStroke(const ImVec2* points, int pointsCount, bool bClosed, ImU32 col, float thickness, const ImVec4& uvs, ImDrawVert* vtx, ImDrawIdx* idx, unsigned int vtxIndex);
+    static void WriteBucket(int type);
+    static void TessellateBucket(int type);
+    static void DrawPrimitive(ImDrawList* canvas, int type, const PrimitiveBucket& bucket, size_t i);
+    static void ResetScratch(ImDrawList* canvas, const ImVec4& clipRect);
+    static void CommitFreshSlots();
+    static void CopyFreshSlot(const RetainedSlot& slot, const GeometryRange& geometry, ImVector<ImDrawVert>& vertices, ImVector<unsigned int>& indices);
+    static void SpliceSlots(ImDrawList* canvas);
+
 public:
     static ImGuiKey quitKey;
     static bool IsSettingsWindowActive();
@@ -0,0 +1,72 @@
+#include "Fetcher.hpp"
+#include "Config.hpp"
+
+// define default values
+TripleBuffer<DrawingSnapshot> Fetcher::snapshots;
+std::thread Fetcher::thread;
+std::atomic<bool> Fetcher::bRunning = false;
+
+/**
+ * @brief Start fetching drawing requests from FC2 in the background
+ */
+void Fetcher::Start()
+{
+    if (bRunning.exchange(true))
+        return;
+
+    thread = std::thread(Run);
+}
+
+/**
+ * @brief Stop fetching drawing requests and wait for the fetch thread to finish
+ */
+void Fetcher::Stop()
+{
+    bRunning = false;
+
+    if (thread.joinable())
+        thread.join();
+}
+
+/**
+ * @brief Get the newest complete drawing snapshot without waiting for FC2
+ * @return the newest snapshot, or the previous one if nothing new was fetched since the last call
+ */
+const DrawingSnapshot& Fetcher::GetSnapshot()
+{
+    snapshots.Update();
+    return snapshots.Front();
+}
+
+/**
+ * @brief Fetch loop that runs on its own thread so a slow or stalled FC2 never blocks the overlay
+ */
+void Fetcher::Run()
+{
+    // the fetch thread is the only user of the drawing table
+    fc2::draw::table table;
+    uint64_t frame = 0;
+
+    auto nextFetch = std::chrono::steady_clock::now();
+
+    while (bRunning)
+    {
+        // patch the drawing requests with the changes from FC2
+        table.update();
+
+        // copy them into the back buffer and hand it to the render thread
+        DrawingSnapshot& snapshot = snapshots.Back();
+        snapshot.entries.assign(table.entries().begin(), table.entries().end());
+        snapshot.frame = ++frame;
+        snapshot.fetchTime = std::chrono::steady_clock::now();
+        snapshots.Publish();
+
+        // fetch at the same rate the overlay renders at
+        nextFetch += std::chrono::microseconds(Config::targetFrametime.load());
+        const auto now = std::chrono::steady_clock::now();
+        if (nextFetch < now)
+            nextFetch = now;
+
+        std::this_thread::sleep_until(nextFetch);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef FETCHER_HPP
+#define FETCHER_HPP
+
+#include "pch.hpp"
+#include "TripleBuffer.hpp"
+
+struct DrawingSnapshot
+{
+    std::vector<fc2::render> entries;
+    uint64_t frame = 0;
+    std::chrono::steady_clock::time_point fetchTime;
+};
+
+class Fetcher
+{
+private:
+    static TripleBuffer<DrawingSnapshot> snapshots;
+    static std::thread thread;
+    static std::atomic<bool> bRunning;
+
+    static void Run();
+
+public:
+    static void Start();
+    static void Stop();
+    static const DrawingSnapshot& GetSnapshot();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "Fonts.hpp"
+#include "Config.hpp"
+
+// define default values
+std::vector<ImFont*> Fonts::fonts;
+std::chrono::microseconds Fonts::bakeTime{ 0 };
+
+/**
+ * @brief Bake the default font in every configured size into the font atlas
+ *
+ * The atlas is built right away, so text of any size never makes ImGui rebuild it while the overlay is running.
+ * Has to be called after the ImGui context got created and before the renderer uploads the font texture.
+ */
+void Fonts::Load()
+{
+    auto start = std::chrono::steady_clock::now();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+
+    // the first font stays the default 13 pixel one, the overlay and ImGui itself use it for everything else
+    fonts.clear();
+    fonts.push_back(atlas->AddFontDefault());
+
+    // bake every other size from the same outlines instead of scaling the 13 pixel glyphs up
+    std::vector<int> sizes = Config::fontSizes;
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    for (int size : sizes)
+    {
+        if (size <= 0 || static_cast<float>(size) == defaultSize)
+            continue;
+
+        ImFontConfig config;
+        config.SizePixels = static_cast<float>(size);
+        fonts.push_back(atlas->AddFontDefault(&config));
+    }
+
+    // keep them sorted by size so Get can stop at the first one that's large enough
+    std::sort(fonts.begin(), fonts.end(), [](const ImFont* a, const ImFont* b) { return a->FontSize < b->FontSize; });
+
+    atlas->Build();
+    bakeTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+/**
+ * @brief Get the baked font that renders text of the given size the sharpest
+ * @param size Requested text height in pixels
+ * @return The smallest baked font that is at least as large as the requested size, so glyphs only ever get scaled down. The largest one if none of them is
+ */
+ImFont* Fonts::Get(float size)
+{
+    for (ImFont* font : fonts)
+    {
+        if (font->FontSize >= size)
+            return font;
+    }
+
+    return fonts.back();
+}
+
+/**
+ * @brief Get how long baking all font sizes took at startup
+ */
+std::chrono::microseconds Fonts::GetBakeTime()
+{
+    return bakeTime;
+}
+
+/**
+ * @brief Get how many font sizes are baked into the atlas
+ */
+int Fonts::GetCount()
+{
+    return static_cast<int>(fonts.size());
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef FONTS_HPP
+#define FONTS_HPP
+
+#include "pch.hpp"
+
+class Fonts
+{
+private:
+    static std::vector<ImFont*> fonts;
+    static std::chrono::microseconds bakeTime;
+
+public:
+    static constexpr float defaultSize = 13.0f;
+
+    static void Load();
+    static ImFont* Get(float size);
+    static std::chrono::microseconds GetBakeTime();
+    static int GetCount();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "Health.hpp"
+
+// define default values
+std::thread Health::thread;
+std::atomic<bool> Health::bRunning = false;
+std::mutex Health::mutex;
+std::condition_variable Health::wakeUp;
+std::atomic<bool> Health::bConnected = false;
+std::atomic<float> Health::rttHistory[Health::historySize] = {};
+std::atomic<int> Health::historyCount = 0;
+
+/**
+ * @brief Check the connection once right away and keep checking it in the background
+ */
+void Health::Start()
+{
+    if (bRunning.exchange(true))
+        return;
+
+    // the first result is needed before the settings window shows up
+    Heartbeat();
+
+    thread = std::thread(Run);
+}
+
+/**
+ * @brief Stop the heartbeat and wait for its thread to finish
+ */
+void Health::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        bRunning = false;
+    }
+    wakeUp.notify_all();
+
+    if (thread.joinable())
+        thread.join();
+}
+
+/**
+ * @brief Check if Constellation answered the last heartbeat
+ */
+bool Health::IsConnected()
+{
+    return bConnected;
+}
+
+/**
+ * @brief Get the round trip time of the last answered heartbeat
+ * @return round trip time in milliseconds, or 0 if no heartbeat was answered yet
+ */
+float Health::GetLastRtt()
+{
+    int count = historyCount;
+    if (count == 0)
+        return 0.0f;
+
+    return rttHistory[(count - 1) % historySize];
+}
+
+/**
+ * @brief Get the round trip time statistics of the recorded heartbeats
+ * @param min shortest round trip time in milliseconds
+ * @param avg average round trip time in milliseconds
+ * @param max longest round trip time in milliseconds
+ */
+void Health::GetRttStats(float& min, float& avg, float& max)
+{
+    int count = std::min(historyCount.load(), historySize);
+    if (count == 0)
+    {
+        min = avg = max = 0.0f;
+        return;
+    }
+
+    min = max = rttHistory[0];
+    float sum = min;
+    for (int i = 1; i < count; i++)
+    {
+        float rtt = rttHistory[i];
+        min = std::min(min, rtt);
+        max = std::max(max, rtt);
+        sum += rtt;
+    }
+    avg = sum / count;
+}
+
+/**
+ * @brief Plot the recorded round trip times, oldest first
+ * @param label ImGui label of the plot
+ * @param size size of the plot, 0 to use the default
+ */
+void Health::PlotRttHistory(const char* label, ImVec2 size)
+{
+    int count = std::min(historyCount.load(), historySize);
+
+    float min, avg, max;
+    GetRttStats(min, avg, max);
+
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "last %.3f ms", GetLastRtt());
+    ImGui::PlotLines(label, GetHistoryValue, nullptr, count, 0, overlay, 0.0f, max * 1.2f, size);
+}
+
+/**
+ * @brief ImGui getter that maps plot indices to the ring buffer, oldest value first
+ */
+float Health::GetHistoryValue(void* data, int idx)
+{
+    int count = historyCount;
+    int start = count > historySize ? count - historySize : 0;
+    return rttHistory[(start + idx) % historySize];
+}
+
+/**
+ * @brief Send a ping to Constellation and record whether and how fast it answered
+ */
+void Health::Heartbeat()
+{
+    auto start = std::chrono::steady_clock::now();
+    auto pong = fc2::ping().second;
+    auto rtt = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start);
+
+    // only an answer fills in the pong. the last error is shared by every thread and may belong to another request
+    bool connected = pong != 0;
+    if (connected)
+    {
+        int count = historyCount;
+        rttHistory[count % historySize] = rtt.count();
+        historyCount = count + 1;
+    }
+
+    bConnected = connected;
+}
+
+/**
+ * @brief Heartbeat loop, a ping is tiny compared to the session request it replaces
+ */
+void Health::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (bRunning)
+    {
+        if (wakeUp.wait_for(lock, interval, [] { return !bRunning; }))
+            break;
+
+        lock.unlock();
+        Heartbeat();
+        lock.lock();
+    }
+}
\ No newline at end of file
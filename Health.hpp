@@ -0,0 +1,36 @@
+#ifndef HEALTH_HPP
+#define HEALTH_HPP
+
+#include "pch.hpp"
+#include <condition_variable>
+
+class Health
+{
+private:
+    static constexpr int historySize = 120;
+
+    static std::thread thread;
+    static std::atomic<bool> bRunning;
+    static std::mutex mutex;
+    static std::condition_variable wakeUp;
+
+    static std::atomic<bool> bConnected;
+    static std::atomic<float> rttHistory[historySize];
+    static std::atomic<int> historyCount;
+
+    static void Heartbeat();
+    static void Run();
+    static float GetHistoryValue(void* data, int idx);
+
+public:
+    static constexpr std::chrono::milliseconds interval{ 500 };
+
+    static void Start();
+    static void Stop();
+    static bool IsConnected();
+    static float GetLastRtt();
+    static void GetRttStats(float& min, float& avg, float& max);
+    static void PlotRttHistory(const char* label, ImVec2 size);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef TRIPLEBUFFER_HPP
+#define TRIPLEBUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Wait-free single producer/single consumer triple buffer
+ *
+ * The producer always owns one buffer to write into and the consumer always owns one buffer to read from.
+ * The third buffer is swapped between them, so neither side ever waits for the other and the consumer
+ * always gets the newest complete value. Values the consumer didn't pick up in time are skipped.
+ */
+template <typename T>
+class TripleBuffer
+{
+private:
+    static constexpr uint8_t indexMask = 0b011;
+    static constexpr uint8_t freshBit = 0b100;
+
+    T buffers[3] = {};
+
+    // index of the shared buffer, plus freshBit if the producer published into it since the consumer last took it
+    std::atomic<uint8_t> shared{ 1 };
+
+    // only touched by the producer
+    uint8_t back = 0;
+
+    // only touched by the consumer
+    uint8_t front = 2;
+
+public:
+    /**
+     * @brief Get the buffer the producer writes into
+     */
+    T& Back()
+    {
+        return buffers[back];
+    }
+
+    /**
+     * @brief Hand the written back buffer to the consumer and get a new one to write into
+     */
+    void Publish()
+    {
+        back = shared.exchange(back | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    /**
+     * @brief Take the newest published buffer if there is one
+     * @return true if the front buffer changed
+     */
+    bool Update()
+    {
+        if (!(shared.load(std::memory_order_relaxed) & freshBit))
+            return false;
+
+        front = shared.exchange(front, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    /**
+     * @brief Get the buffer the consumer reads from
+     */
+    const T& Front() const
+    {
+        return buffers[front];
+    }
+};
+
+#endif
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include "Drawing.hpp"
 #include "uiaccess.hpp"
 #include "Config.hpp"
+#include "Fetcher.hpp"
+#include "Health.hpp"
+#include "Fonts.hpp"
 
 // define default values
 ID3D11Device* UI::pd3dDevice = nullptr;
@@ -327,9 +330,15 @@ void UI::RenderOverlay()
     ImGui::CreateContext();
     ImGui::GetIO().IniFilename = nullptr;
 
+    // bake every font size drawing requests can use before the renderer uploads the font atlas
+    Fonts::Load();
+
     ImGui_ImplWin32_Init(hwnd);
     ImGui_ImplDX11_Init(pd3dDevice, pd3dDeviceContext);
 
+    // fetch drawing requests on a separate thread so FC2 can't stall the overlay
+    Fetcher::Start();
+
     bool bDone = false;
 
     // overlay loop
@@ -348,8 +357,8 @@ void UI::RenderOverlay()
                 bDone = true;
         }
 
-        // check for the last FC2 error message
-        if (fc2::get_error() != FC2_TEAM_ERROR_NO_ERROR)
+        // check if Constellation stopped answering the heartbeat
+        if (!Health::IsConnected())
             bDone = true;
 
         // check if the target window got closed
@@ -398,7 +407,7 @@ void UI::RenderOverlay()
         // calculate the time we have to wait for to achieve our target frametime
         auto frame_end = std::chrono::high_resolution_clock::now();
         auto frame_time = std::chrono::duration_cast<std::chrono::microseconds>(frame_end - frame_start);
-        auto time_to_wait = Config::targetFrametime - frame_time - millisecond;
+        auto time_to_wait = std::chrono::microseconds(Config::targetFrametime.load()) - frame_time - millisecond;
         if (time_to_wait < microsecond)
             time_to_wait = microsecond;
 
@@ -407,6 +416,7 @@ void UI::RenderOverlay()
     }
 
     // cleanup and shutdown
+    Fetcher::Stop();
     ImGui_ImplDX11_Shutdown();
     ImGui_ImplWin32_Shutdown();
     ImGui::DestroyContext();
@@ -425,10 +435,12 @@ bool UI::SetTargetWindow()
     if (fc2::get_error() != FC2_TEAM_ERROR_NO_ERROR)
         return false;
 
-    uint32_t iTargetHandle = fc2::call<uint32_t>("directx_overlay_target_handle", FC2_LUA_TYPE_INT);
+    auto [iTargetHandle, iTargetProcID] = fc2::call_many<uint32_t, uint32_t>(
+        { "directx_overlay_target_handle", FC2_LUA_TYPE_INT },
+        { "directx_overlay_target_process_id", FC2_LUA_TYPE_INT }
+    );
     if (iTargetHandle == 0)
         return false;
-    uint32_t iTargetProcID = fc2::call<uint32_t>("directx_overlay_target_process_id", FC2_LUA_TYPE_INT);
     if (iTargetProcID == 0)
         return false;
 
@@ -0,0 +1,258 @@
+/**
+ * @brief replays a trace of `read_memory` calls with and without `fc2::engine::cache`
+ *
+ * usage: fc2t-bench-cache [--trace file] [--write file] [--frames n] [--latency us]
+ *
+ * a trace is a text file with one read per line, its address and size in hex, and a line "frame" wherever the game
+ * loop that recorded it started a new frame. without --trace the built in trace of a typical esp loop is replayed:
+ * the view matrix, an entity list and for 64 entities their pointer, health, team, position and 20 bones, with some
+ * entities replaced every few frames. --write saves that trace to edit or extend.
+ *
+ * the server runs in a child process. prints the round trips and the wall time per frame of both runs, and the hit
+ * rate, the bytes the cache saved and the bytes it fetched in whole lines.
+ */
+#include "../tools/standin/standin.hpp"
+#include <array>
+#include <fstream>
+
+namespace
+{
+    struct access
+    {
+        unsigned long long address = 0;
+        std::uint32_t size = 0;
+    };
+
+    /**
+     * @brief reads of one frame each
+     */
+    using trace = std::vector< std::vector< access > >;
+
+    auto make_trace(const int frames) -> trace
+    {
+        constexpr unsigned long long module = 0x140000000ull;
+        constexpr unsigned long long heap = 0x200000000ull;
+        constexpr int entities = 64;
+
+        std::mt19937 random(2024);
+        std::vector< unsigned long long > entity(entities);
+        for (int i = 0; i < entities; ++i)
+        {
+            entity[i] = heap + static_cast<unsigned long long>(i) * 0x4000;
+        }
+
+        trace output(static_cast<std::size_t>(frames));
+        for (auto& frame : output)
+        {
+            // now and then an entity dies and another one gets allocated somewhere else
+            if (random() % 8 == 0)
+            {
+                entity[random() % entities] = heap + (random() % 0x10000) * 0x400;
+            }
+
+            frame.push_back({ module + 0x1a2b40, 64 });
+            frame.push_back({ module + 0x1b0000, 8 });
+
+            for (int i = 0; i < entities; ++i)
+            {
+                frame.push_back({ heap - 0x1000 + static_cast<unsigned long long>(i) * 8, 8 });
+                frame.push_back({ entity[i] + 0x100, 4 });
+                frame.push_back({ entity[i] + 0x104, 4 });
+                frame.push_back({ entity[i] + 0x134, 12 });
+                for (int bone = 0; bone < 20; ++bone)
+                {
+                    frame.push_back({ entity[i] + 0x1000 + static_cast<unsigned long long>(bone) * 48, 12 });
+                }
+            }
+        }
+
+        return output;
+    }
+
+    auto load_trace(const std::string& path, trace& output) -> bool
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            return false;
+        }
+
+        output.assign(1, {});
+        for (std::string line; std::getline(file, line);)
+        {
+            if (line.rfind("frame", 0) == 0)
+            {
+                output.emplace_back();
+                continue;
+            }
+
+            access a;
+            char* end = nullptr;
+            a.address = strtoull(line.c_str(), &end, 16);
+            a.size = static_cast<std::uint32_t>(strtoul(end, nullptr, 16));
+            if (a.size != 0)
+            {
+                output.back().push_back(a);
+            }
+        }
+
+        return true;
+    }
+
+    void save_trace(const std::string& path, const trace& reads)
+    {
+        std::ofstream file(path);
+        for (const auto& frame : reads)
+        {
+            for (const auto& a : frame)
+            {
+                char line[64];
+                snprintf(line, sizeof line, "%llx %x\n", a.address, a.size);
+                file << line;
+            }
+
+            file << "frame\n";
+        }
+    }
+
+    volatile unsigned char sink = 0;
+
+    /**
+     * @brief read_memory is typed, every size is read as the next larger array of bytes
+     */
+    template< std::size_t n, std::size_t... rest >
+    void read_as(const access& a)
+    {
+        if constexpr (sizeof...(rest) > 0)
+        {
+            if (a.size > n)
+            {
+                read_as< rest... >(a);
+                return;
+            }
+        }
+
+        const auto value = fc2::engine::read_memory< std::array< unsigned char, n > >(a.address);
+        sink = value ? (*value)[0] : 0;
+    }
+
+    struct result
+    {
+        double trips = 0;
+        long long us = 0;
+    };
+
+    auto replay(const trace& reads, const bool cached) -> result
+    {
+        fc2::engine::cache::enable(cached);
+        fc2::engine::cache::reset_stats();
+        fc2::stats::reset();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& frame : reads)
+        {
+            fc2::engine::cache::next_frame();
+            for (const auto& a : frame)
+            {
+                read_as< 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024 >(a);
+            }
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        const auto frames = static_cast<long long>(std::max< std::size_t >(reads.size(), 1));
+
+        result output;
+        output.us = elapsed.count() / frames;
+        for (const auto request : { FC2_TEAM_REQUESTS_READ_MEMORY, FC2_TEAM_REQUESTS_READ_MEMORY_MANY })
+        {
+            output.trips += static_cast<double>(fc2::stats::get(request).count) / static_cast<double>(frames);
+        }
+
+        return output;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    standin::options opts;
+    opts.capabilities = 1u << FC2_TEAM_EXTENSION_READ_MEMORY_MANY;
+
+    int frames = 200;
+    std::string input;
+    std::string output;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--frames")
+        {
+            frames = std::max(1, atoi(argv[i + 1]));
+        }
+        else if (arg == "--trace")
+        {
+            input = argv[i + 1];
+        }
+        else if (arg == "--write")
+        {
+            output = argv[i + 1];
+        }
+        else if (arg == "--latency")
+        {
+            opts.latency = std::chrono::microseconds(atoll(argv[i + 1]));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    trace reads;
+    if (input.empty())
+    {
+        reads = make_trace(frames);
+    }
+    else if (!load_trace(input, reads))
+    {
+        fprintf(stderr, "can't read %s\n", input.c_str());
+        return 1;
+    }
+
+    if (!output.empty())
+    {
+        save_trace(output, reads);
+    }
+
+    standin::process server(opts);
+    if (!server)
+    {
+        fprintf(stderr, "can't start the stand-in server\n");
+        return 1;
+    }
+
+    fc2::ping();
+    if (fc2::get_error() != FC2_TEAM_ERROR_NO_ERROR)
+    {
+        fprintf(stderr, "can't connect to the stand-in server\n");
+        return 1;
+    }
+
+    std::size_t count = 0;
+    for (const auto& frame : reads)
+    {
+        count += frame.size();
+    }
+
+    printf("%zu frames, %zu reads, latency %lld us\n\n", reads.size(), count, static_cast<long long>(opts.latency.count()));
+    printf("%-8s %12s %12s %9s %12s %12s\n", "cache", "trips/frame", "us/frame", "hit rate", "saved KB", "fetched KB");
+
+    const auto direct = replay(reads, false);
+    printf("%-8s %12.1f %12lld %9s %12s %12s\n", "off", direct.trips, direct.us, "-", "-", "-");
+
+    const auto cached = replay(reads, true);
+    const auto stats = fc2::engine::cache::get_stats();
+    printf("%-8s %12.1f %12lld %8.1f%% %12.1f %12.1f\n", "on", cached.trips, cached.us, stats.hit_rate() * 100.0,
+        static_cast<double>(stats.bytes_saved) / 1024.0, static_cast<double>(stats.bytes_fetched) / 1024.0);
+
+    return 0;
+}
\ No newline at end of file
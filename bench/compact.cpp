@@ -0,0 +1,87 @@
+/**
+ * @brief size and speed of the compact drawing encoding
+ *
+ * usage: fc2t-bench-compact [--iterations n]
+ *
+ * for scenes of lines and boxes, of labels and of both, prints the bytes per entry on the wire next to the 172 bytes of
+ * a full entry, and how many entries per second encode and decode manage.
+ */
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    auto make_scene(const std::size_t count, const int text_every) -> std::vector< fc2::render >
+    {
+        std::vector< fc2::render > scene;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto x = static_cast<std::int32_t>(i * 37 % 1900);
+            const auto y = static_cast<std::int32_t>(i * 53 % 1060);
+
+            if (text_every && i % text_every == 0)
+            {
+                scene.push_back(fc2::draw::primitive::text("player " + std::to_string(i) + " [100 hp]", 13, x, y, 255, 255, 255, 255));
+            }
+            else if (i % 2)
+            {
+                scene.push_back(fc2::draw::primitive::line(x, y, x + 40, y + 40, 0, 255, 0, 255, 1));
+            }
+            else
+            {
+                scene.push_back(fc2::draw::primitive::box(x, y, 20, 40, 255, 0, 0, 255, 2));
+            }
+        }
+
+        return scene;
+    }
+
+    void measure(const char* name, const std::vector< fc2::render >& scene, const int iterations)
+    {
+        std::vector< std::uint8_t > encoded;
+        std::vector< fc2::render > decoded;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            fc2::detail::compact::encode(scene.data(), scene.size(), encoded);
+        }
+        const auto encode_time = std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            fc2::detail::compact::decode(encoded.data(), encoded.size(), decoded);
+        }
+        const auto decode_time = std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+
+        const auto entries = static_cast<double>(scene.size()) * iterations;
+        printf("%-8s %7zu %10zu %9.1f %8.1f%% %12.1f %12.1f\n",
+            name,
+            scene.size(),
+            encoded.size(),
+            static_cast<double>(encoded.size()) / static_cast<double>(scene.size()),
+            100.0 * static_cast<double>(encoded.size()) / static_cast<double>(scene.size() * sizeof(fc2::render)),
+            entries / encode_time / 1e6,
+            entries / decode_time / 1e6);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = 200;
+    if (argc > 2 && std::string(argv[1]) == "--iterations")
+    {
+        iterations = std::max(1, atoi(argv[2]));
+    }
+
+    printf("%-8s %7s %10s %9s %9s %12s %12s\n", "scene", "entries", "bytes", "per entry", "of full", "encode M/s", "decode M/s");
+
+    for (const std::size_t count : { 100, 1000, 10000 })
+    {
+        measure("shapes", make_scene(count, 0), iterations);
+        measure("mixed", make_scene(count, 4), iterations);
+        measure("labels", make_scene(count, 1), iterations);
+    }
+
+    return 0;
+}
\ No newline at end of file
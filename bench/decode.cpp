@@ -0,0 +1,112 @@
+/**
+ * @brief decoding drawing requests one at a time with DecodeEntry against four at a time with DecodeEntriesSSE2
+ *
+ * usage: fc2t-bench-decode [--iterations n]
+ *
+ * for buckets of 16 to 16384 requests in random slots, prints the time per decoded request of both and the speedup.
+ * runs the overlay's drawing code through tools/headless, no server is needed.
+ */
+#define private public
+#include "headless.hpp"
+#undef private
+
+namespace
+{
+    auto make_bucket(const std::size_t count, std::mt19937& random) -> Drawing::PrimitiveBucket
+    {
+        Drawing::PrimitiveBucket bucket;
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            bucket.slots.push_back(i);
+        }
+
+        std::shuffle(bucket.slots.begin(), bucket.slots.end(), random);
+        bucket.left.resize(count);
+        bucket.top.resize(count);
+        bucket.right.resize(count);
+        bucket.bottom.resize(count);
+        bucket.colors.resize(count);
+        bucket.sizes.resize(count);
+        bucket.fontSizes.resize(count);
+        return bucket;
+    }
+
+    template< typename fn_t >
+    auto measure(const int iterations, const std::size_t count, fn_t&& fn) -> double
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            fn();
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        return static_cast<double>(elapsed.count()) / iterations / static_cast<double>(count);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = 2000;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--iterations")
+        {
+            iterations = std::max(1, atoi(argv[i + 1]));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+#ifndef DRAWING_DECODE_SSE2
+    fprintf(stderr, "built without DRAWING_DECODE_SSE2, there is nothing to compare\n");
+    return 1;
+#else
+    std::mt19937 random(1357);
+    Config::iOffsetLeft = 3;
+    Config::iOffsetTop = 5;
+
+    printf("%d iterations\n\n", iterations);
+    printf("%8s | %12s | %12s | %7s\n", "requests", "scalar ns", "sse2 ns", "speedup");
+
+    for (const std::size_t count : { 16, 256, 4096, 16384 })
+    {
+        Drawing::retainedEntries.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto x = static_cast<std::int32_t>(random() % 1900);
+            const auto y = static_cast<std::int32_t>(random() % 1060);
+            Drawing::retainedEntries.push_back(i % 2
+                ? fc2::draw::primitive::box(x, y, 20, 40, 255, 0, 0, 255, 1)
+                : fc2::draw::primitive::line(x, y, x + 30, y + 30, 0, 255, 0, 200, 2));
+        }
+
+        auto bucket = make_bucket(count, random);
+
+        const auto scalar = measure(iterations, count, [&bucket]
+            {
+                for (std::size_t i = 0; i < bucket.slots.size(); ++i)
+                {
+                    Drawing::DecodeEntry(bucket, i);
+                }
+            });
+
+        const auto sse2 = measure(iterations, count, [&bucket]
+            {
+                for (std::size_t i = 0; i < bucket.slots.size(); i += 4)
+                {
+                    Drawing::DecodeEntriesSSE2(bucket, i);
+                }
+            });
+
+        printf("%8zu | %12.2f | %12.2f | %6.1fx\n", count, scalar, sse2, scalar / std::max(sse2, 0.001));
+    }
+
+    return 0;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * @brief sending a frame of primitives one `render` call at a time against sending it as one `draw::batch`
+ *
+ * usage: fc2t-bench-draw [--iterations n] [--latency us]
+ *
+ * the server runs in a child process and advertises FC2_TEAM_EXTENSION_DRAW_BATCH. for frames of 1 to 1000 primitives,
+ * prints the wall time per frame, the round trips per frame and the cpu time per frame of both.
+ */
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    auto make_frame(const std::size_t count) -> std::vector< fc2::render >
+    {
+        std::vector< fc2::render > frame;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto x = static_cast<std::int32_t>(i * 37 % 1900);
+            const auto y = static_cast<std::int32_t>(i * 53 % 1060);
+
+            frame.push_back(i % 4 == 3
+                ? fc2::draw::primitive::text("player " + std::to_string(i), 13, x, y, 255, 255, 255, 255)
+                : fc2::draw::primitive::box(x, y, 20, 40, 255, 0, 0, 255, 1));
+        }
+
+        return frame;
+    }
+
+    struct result
+    {
+        long long ns = 0;
+        double trips = 0;
+        long long cpu = 0;
+    };
+
+    template< typename fn_t >
+    auto measure(const int iterations, fn_t&& fn) -> result
+    {
+        fc2::stats::reset();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            fn();
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        result output;
+        output.ns = elapsed.count() / iterations;
+        for (const auto request : { FC2_TEAM_REQUESTS_DRAW, FC2_TEAM_REQUESTS_DRAW_BATCH })
+        {
+            const auto s = fc2::stats::get(request);
+            output.trips += static_cast<double>(s.count) / iterations;
+            output.cpu += s.cpu.count() / iterations;
+        }
+
+        return output;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    standin::options opts;
+    opts.capabilities = 1u << FC2_TEAM_EXTENSION_DRAW_BATCH;
+    int iterations = 200;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--iterations")
+        {
+            iterations = std::max(1, atoi(argv[i + 1]));
+        }
+        else if (arg == "--latency")
+        {
+            opts.latency = std::chrono::microseconds(atoll(argv[i + 1]));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    standin::process server(opts);
+    if (!server)
+    {
+        fprintf(stderr, "can't start the stand-in server\n");
+        return 1;
+    }
+
+    fc2::ping();
+    if (fc2::get_error() != FC2_TEAM_ERROR_NO_ERROR)
+    {
+        fprintf(stderr, "can't connect to the stand-in server\n");
+        return 1;
+    }
+
+    printf("%d iterations, latency %lld us\n\n", iterations, static_cast<long long>(opts.latency.count()));
+    printf("%10s | %12s %8s %10s | %12s %8s %10s | %7s\n", "primitives", "render ns", "trips", "cpu ns", "batch ns", "trips", "cpu ns", "speedup");
+
+    for (const std::size_t count : { 1, 10, 100, 1000 })
+    {
+        const auto frame = make_frame(count);
+
+        const auto single = measure(iterations, [&frame]
+            {
+                for (const auto& entry : frame)
+                {
+                    fc2::draw::render(entry);
+                }
+            });
+
+        const auto batched = measure(iterations, [&frame]
+            {
+                fc2::draw::batch batch;
+                for (const auto& entry : frame)
+                {
+                    batch.add(entry);
+                }
+
+                batch.submit();
+            });
+
+        printf("%10zu | %12lld %8.1f %10lld | %12lld %8.1f %10lld | %6.1fx\n", count,
+            single.ns, single.trips, single.cpu, batched.ns, batched.trips, batched.cpu,
+            static_cast<double>(single.ns) / static_cast<double>(std::max(batched.ns, 1ll)));
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+/**
+ * @brief reading drawing requests from the drawing feed against asking for them with FC2_TEAM_REQUESTS_GET_DRAWING
+ *
+ * usage: fc2t-bench-feed [--iterations n] [--interval us] [--latency us]
+ *
+ * the server runs in this process, publishes a feed every `interval` and answers requests after `latency`. throughput
+ * is the time per read of a frame of 100 requests. latency is how long it takes from changing the scene until a read
+ * returns the change: the request path sees it with the next answer, the feed with the next frame it publishes.
+ */
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    using namespace fc2::detail;
+
+    auto make_scene(const std::int32_t marker) -> std::vector< fc2::render >
+    {
+        std::vector< fc2::render > scene;
+        for (std::int32_t i = 0; i < 100; ++i)
+        {
+            scene.push_back(fc2::draw::primitive::box(i * 19, i * 10, 20, 20, 255, i, 0, 255, 1));
+        }
+
+        scene[0].dimensions[0] = marker;
+        return scene;
+    }
+
+    /**
+     * @brief the request path of draw::get
+     */
+    auto request(std::vector< fc2::render >& output) -> bool
+    {
+        output.clear();
+
+        transaction< requests::draw > tx(FC2_TEAM_REQUESTS_GET_DRAWING);
+        if (!tx.submit())
+        {
+            return false;
+        }
+
+        std::copy_if(std::begin(tx->details), std::end(tx->details), std::back_inserter(output), [](const fc2::render& o)
+            {
+                return o.style[FC2_TEAM_DRAW_STYLE_TYPE] != FC2_TEAM_DRAW_TYPE_NONE;
+            });
+
+        return true;
+    }
+
+    auto feed(std::vector< fc2::render >& output) -> bool
+    {
+        return extension::read_drawing(output);
+    }
+
+    auto percentile(std::vector< long long > values, const double p) -> long long
+    {
+        std::sort(values.begin(), values.end());
+        return values[std::min(values.size() - 1, static_cast<std::size_t>(p * static_cast<double>(values.size())))];
+    }
+
+    template< typename read_t >
+    void measure(const char* name, standin::server& server, const std::chrono::microseconds interval, const int iterations, read_t&& read)
+    {
+        std::vector< fc2::render > output;
+        std::mt19937 random(97);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            read(output);
+        }
+
+        const long long per_read = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+        // fewer scene changes than reads, the feed needs up to an interval for every one of them
+        std::vector< long long > latency;
+        for (int i = 0; i < std::max(1, iterations / 20); ++i)
+        {
+            // a read just saw the last change, which would line every change up with the publisher without this
+            std::this_thread::sleep_for(std::chrono::microseconds(random() % static_cast<unsigned long long>(std::max< long long >(interval.count(), 1))));
+
+            const auto marker = 100000 + i;
+            server.set_scene(make_scene(marker));
+
+            const auto changed = std::chrono::steady_clock::now();
+            while (!read(output) || output.empty() || output[0].dimensions[0] != marker)
+            {
+                if (std::chrono::steady_clock::now() - changed > std::chrono::seconds(1))
+                {
+                    fprintf(stderr, "%s: the change never showed up\n", name);
+                    return;
+                }
+            }
+
+            latency.push_back(static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - changed).count()));
+        }
+
+        printf("%-8s %10lld %12.0f %10lld %10lld %10lld\n", name, per_read, 1e9 / static_cast<double>(std::max(per_read, 1LL)),
+            percentile(latency, 0.5), percentile(latency, 0.99), percentile(latency, 1.0));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    standin::options opts;
+    opts.capabilities = 1u << FC2_TEAM_EXTENSION_DRAWING_FEED;
+    int iterations = 20000;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--iterations")
+        {
+            iterations = std::max(1, atoi(argv[i + 1]));
+        }
+        else if (arg == "--interval")
+        {
+            opts.feed_interval = std::chrono::microseconds(atoll(argv[i + 1]));
+        }
+        else if (arg == "--latency")
+        {
+            opts.latency = std::chrono::microseconds(atoll(argv[i + 1]));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    standin::server server(opts);
+    if (!server)
+    {
+        fprintf(stderr, "can't start the stand-in server\n");
+        return 1;
+    }
+
+    server.set_scene(make_scene(0));
+
+    std::vector< fc2::render > output;
+    if (!request(output) || !feed(output))
+    {
+        fprintf(stderr, "can't connect to the stand-in server or it publishes no feed\n");
+        return 1;
+    }
+
+    printf("%d iterations, feed interval %lld us, request latency %lld us\n\n", iterations, static_cast<long long>(opts.feed_interval.count()), static_cast<long long>(opts.latency.count()));
+    printf("%-8s %10s %12s %10s %10s %10s\n", "path", "ns/read", "reads/s", "p50 us", "p99 us", "max us");
+
+    measure("request", server, opts.feed_interval, iterations, request);
+    measure("feed", server, opts.feed_interval, iterations, feed);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,236 @@
+/**
+ * @brief what honouring FC2_TEAM_DRAW_STYLE_FONT_SIZE costs: baking the font sizes at startup and drawing sized text
+ * every frame
+ *
+ * usage: fc2t-bench-fonts [--runs n] [--frames n]
+ *
+ * startup: Fonts::Load in a fresh ImGui context for the default font alone, Config::fontSizes as it ships and two
+ * larger sets, and the RGBA32 conversion the dx11 backend asks for before it uploads the atlas. prints the fonts, the
+ * atlas size and the median time of both over the runs.
+ *
+ * per frame: scenes of 100, 1000 and 5000 text requests drawn like DrawPrimitive draws them, all at the default size,
+ * at random sizes from 8 to 64 pixels through Fonts::Get and at the same sizes by scaling the default 13 pixel font,
+ * which is what the overlay did before it baked any other size. prints the time per frame and the vertices, and
+ * checks that the atlas never gets built again. runs the overlay's drawing code through tools/headless, no server is
+ * needed.
+ */
+#define private public
+#include "headless.hpp"
+#undef private
+
+namespace
+{
+    std::mt19937 random(8642);
+
+    auto median(std::vector< double > values) -> double
+    {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    struct size_set
+    {
+        const char* name;
+        std::vector< int > sizes;
+    };
+
+    auto every(const int first, const int last, const int step) -> std::vector< int >
+    {
+        std::vector< int > output;
+        for (int size = first; size <= last; size += step)
+        {
+            output.push_back(size);
+        }
+
+        return output;
+    }
+
+    void startup(const int runs)
+    {
+        const std::vector< int > shipped = Config::fontSizes;
+        const size_set sets[] =
+        {
+            { "default only", {} },
+            { "shipped", shipped },
+            { "8-64 step 4", every(8, 64, 4) },
+            { "8-96 step 2", every(8, 96, 2) }
+        };
+
+        printf("%-13s | %5s | %9s | %8s | %11s\n", "sizes", "fonts", "atlas", "load ms", "rgba32 ms");
+        for (const auto& set : sets)
+        {
+            std::vector< double > load;
+            std::vector< double > convert;
+            int width = 0;
+            int height = 0;
+            int fonts = 0;
+
+            for (int run = 0; run < runs; ++run)
+            {
+                ImGui::CreateContext();
+                Config::fontSizes = set.sizes;
+
+                auto start = std::chrono::steady_clock::now();
+                Fonts::Load();
+                load.push_back(std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - start).count());
+
+                unsigned char* pixels = nullptr;
+                start = std::chrono::steady_clock::now();
+                ImGui::GetIO().Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+                convert.push_back(std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - start).count());
+
+                fonts = Fonts::GetCount();
+                ImGui::DestroyContext();
+            }
+
+            char atlas[32];
+            snprintf(atlas, sizeof atlas, "%dx%d", width, height);
+            printf("%-13s | %5d | %9s | %8.2f | %11.2f\n", set.name, fonts, atlas, median(load), median(convert));
+        }
+
+        Config::fontSizes = shipped;
+    }
+
+    /**
+     * @brief decodes a scene of text requests into the bucket of the direct path
+     */
+    void load(const std::size_t count, const bool sized)
+    {
+        Drawing::retainedEntries.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto entry = fc2::draw::primitive::text("player " + std::to_string(i), 0, static_cast<int>(random() % 1900),
+                static_cast<int>(random() % 1060), 255, 255, 255, 255);
+            entry.style[FC2_TEAM_DRAW_STYLE_FONT_SIZE] = sized ? 8 + static_cast<int>(random() % 57) : 0;
+            Drawing::retainedEntries.push_back(entry);
+        }
+
+        auto& bucket = Drawing::retainedDirect;
+        bucket.slots.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            bucket.slots.push_back(static_cast<uint32_t>(i));
+        }
+
+        Drawing::DecodeBucket(bucket);
+    }
+
+    /**
+     * @brief every text request through DrawPrimitive, which picks the baked font closest to its size
+     */
+    void draw_baked(ImDrawList* canvas)
+    {
+        const auto& bucket = Drawing::retainedDirect;
+        for (std::size_t i = 0; i < bucket.slots.size(); ++i)
+        {
+            Drawing::DrawPrimitive(canvas, FC2_TEAM_DRAW_TYPE_TEXT, bucket, i);
+        }
+    }
+
+    /**
+     * @brief every text request with the default font scaled to its size, its shadow and itself like DrawPrimitive
+     */
+    void draw_scaled(ImDrawList* canvas)
+    {
+        const auto& bucket = Drawing::retainedDirect;
+        ImFont* font = Fonts::Get(Fonts::defaultSize);
+        for (std::size_t i = 0; i < bucket.slots.size(); ++i)
+        {
+            const char* text = Drawing::retainedEntries[bucket.slots[i]].text;
+            const ImVec2 min(bucket.left[i], bucket.top[i]);
+            canvas->AddText(font, bucket.fontSizes[i], ImVec2(min.x + 1.0f, min.y + 1.0f), bucket.colors[i] & IM_COL32_A_MASK, text);
+            canvas->AddText(font, bucket.fontSizes[i], min, bucket.colors[i], text);
+        }
+    }
+
+    struct result
+    {
+        int vertices = 0;
+        double us = 0.0;
+    };
+
+    /**
+     * @brief microseconds per frame spent in `draw`, ImGui's frame around it isn't measured
+     */
+    template< typename fn_t >
+    auto measure(const int frames, fn_t&& draw) -> result
+    {
+        result output;
+        std::chrono::nanoseconds total{};
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            ImGui::NewFrame();
+            const auto canvas = ImGui::GetBackgroundDrawList();
+            const auto start = std::chrono::steady_clock::now();
+            draw(canvas);
+            total += std::chrono::steady_clock::now() - start;
+            output.vertices = canvas->VtxBuffer.Size;
+            ImGui::EndFrame();
+        }
+
+        output.us = static_cast<double>(total.count()) / 1000.0 / static_cast<double>(frames);
+        return output;
+    }
+
+    /**
+     * @brief whatever ImGui does with the atlas, its pixels stay where Fonts::Load left them unless it got built again
+     */
+    auto atlas_pixels() -> const void*
+    {
+        return ImGui::GetIO().Fonts->TexPixelsRGBA32;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int runs = 9;
+    int frames = 200;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--runs")
+        {
+            runs = std::max(1, atoi(argv[i + 1]));
+        }
+        else if (arg == "--frames")
+        {
+            frames = std::max(1, atoi(argv[i + 1]));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    printf("startup, median of %d runs\n\n", runs);
+    startup(runs);
+
+    headless::start(ImVec2(1920.0f, 1080.0f));
+    const auto pixels = atlas_pixels();
+
+    printf("\nper frame, %d frames, time in us per frame\n\n", frames);
+    printf("%8s | %-16s %9s | %-16s %9s | %-16s %9s %9s\n", "requests", "13 px", "vertices", "sized, baked", "vertices",
+        "sized, scaled", "vertices", "baked");
+
+    for (const std::size_t count : { 100, 1000, 5000 })
+    {
+        load(count, false);
+        const auto plain = measure(frames, draw_baked);
+
+        load(count, true);
+        const auto baked = measure(frames, draw_baked);
+        const auto scaled = measure(frames, draw_scaled);
+
+        printf("%8zu | %16.1f %9d | %16.1f %9d | %16.1f %9d %+8.1f%%\n", count, plain.us, plain.vertices, baked.us, baked.vertices,
+            scaled.us, scaled.vertices, 100.0 * (baked.us - scaled.us) / std::max(scaled.us, 0.001));
+    }
+
+    const bool rebuilt = atlas_pixels() != pixels;
+    printf("\natlas built again while drawing: %s\n", rebuilt ? "yes" : "no");
+
+    headless::stop();
+
+    return rebuilt ? 1 : 0;
+}
\ No newline at end of file
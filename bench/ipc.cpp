@@ -0,0 +1,116 @@
+/**
+ * @brief round trip cost of every request type against the stand-in server
+ *
+ * usage: fc2t-bench-ipc [--iterations n] [--latency us] [--jitter us]
+ *
+ * the server runs in a child process. latency percentiles and cpu time come from fc2::stats, so they measure exactly
+ * what an application would see. ns/op is the wall time of the whole call, including building and reading the request.
+ */
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    /**
+     * @brief the same hundred boxes and labels the overlay gets from a busy script
+     */
+    auto make_scene() -> std::vector< fc2::render >
+    {
+        std::vector< fc2::render > scene;
+        for (std::int32_t i = 0; i < 100; ++i)
+        {
+            scene.push_back(i % 4 == 3
+                ? fc2::draw::primitive::text("entry " + std::to_string(i), 13, i * 19, i * 10, 255, 255, 255, 255)
+                : fc2::draw::primitive::box(i * 19, i * 10, 20, 20, 255, i, 0, 255, 1));
+        }
+
+        return scene;
+    }
+
+    template< typename fn_t >
+    void measure(const int request, const int iterations, fn_t&& fn)
+    {
+        fc2::stats::reset();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            fn(i);
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        const auto s = fc2::stats::get(request);
+        const auto count = std::max< std::uint64_t >(s.count, 1);
+
+        printf("%-14s %8llu %7llu %10lld %10lld %10lld %10lld %10lld %10lld\n",
+            fc2::stats::name(request),
+            static_cast<unsigned long long>(s.count),
+            static_cast<unsigned long long>(s.failed),
+            static_cast<long long>(elapsed.count() / iterations),
+            static_cast<long long>(s.p50.count()),
+            static_cast<long long>(s.p99.count()),
+            static_cast<long long>(s.p999.count()),
+            static_cast<long long>(s.max.count()),
+            static_cast<long long>(s.cpu.count() / static_cast<long long>(count)));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    standin::options opts;
+    int iterations = 20000;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--iterations")
+        {
+            iterations = std::max(1, atoi(argv[i + 1]));
+        }
+        else if (arg == "--latency")
+        {
+            opts.latency = std::chrono::microseconds(atoll(argv[i + 1]));
+        }
+        else if (arg == "--jitter")
+        {
+            opts.jitter = std::chrono::microseconds(atoll(argv[i + 1]));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    standin::process server(opts, make_scene());
+    if (!server)
+    {
+        fprintf(stderr, "can't start the stand-in server\n");
+        return 1;
+    }
+
+    /**
+     * @brief the first request connects
+     */
+    fc2::ping();
+    if (fc2::get_error() != FC2_TEAM_ERROR_NO_ERROR)
+    {
+        fprintf(stderr, "can't connect to the stand-in server\n");
+        return 1;
+    }
+
+    printf("%d iterations, latency %lld us, jitter %lld us\n\n", iterations, static_cast<long long>(opts.latency.count()), static_cast<long long>(opts.jitter.count()));
+    printf("%-14s %8s %7s %10s %10s %10s %10s %10s %10s\n", "request", "count", "failed", "ns/op", "p50", "p99", "p999", "max", "cpu/op");
+
+    const auto box = fc2::draw::primitive::box(10, 10, 20, 20, 255, 0, 0, 255, 1);
+
+    measure(FC2_TEAM_REQUESTS_PING, iterations, [](int) { fc2::ping(); });
+    measure(FC2_TEAM_REQUESTS_CALL, iterations, [](int) { fc2::call< int >("on_team_call"); });
+    measure(FC2_TEAM_REQUESTS_SESSION, iterations, [](int) { fc2::get_session(); });
+    measure(FC2_TEAM_REQUESTS_GET_DRAWING, iterations, [](int) { fc2::draw::get(); });
+    measure(FC2_TEAM_REQUESTS_DRAW, iterations, [&box](int) { fc2::draw::render(box); });
+    measure(FC2_TEAM_REQUESTS_READ_MEMORY, iterations, [](const int i) { fc2::engine::read_memory< std::uint64_t >(0x140001000ull + static_cast<unsigned long long>(i % 4096) * 8); });
+    measure(FC2_TEAM_REQUESTS_HTTP_REQUEST, iterations, [](int) { fc2::http::get("https://example.com/?size=512"); });
+    measure(FC2_TEAM_REQUESTS_API, iterations, [](int) { fc2::api("getMember&size=512"); });
+
+    return 0;
+}
\ No newline at end of file
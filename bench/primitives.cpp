@@ -0,0 +1,224 @@
+/**
+ * @brief vertices per second of the overlay's drawing requests written by ImGui and by Drawing's own writers
+ *
+ * usage: fc2t-bench-primitives [--frames n]
+ *
+ * for scenes of 100 to 10000 drawing requests, an esp mix of 40% boxes, 20% lines, 20% text, 15% filled boxes and 5%
+ * circles, and one of boxes and lines only. every frame the scene gets drawn twice in slot order, once one request at
+ * a time through ImGui's AddRect, AddLine and so on, the way DrawSlotsDirectly used to, and once with
+ * DrawSlotsDirectly, which writes runs of boxes, filled boxes and lines into one reservation. then all requests get
+ * tessellated by type into the retained geometry's scratch list, once every bucket through TessellateBucket and once
+ * with WriteBucket for boxes, filled boxes and lines. prints the vertices per frame, the time per frame and the million
+ * vertices per second of each. runs the overlay's drawing code through tools/headless, no server is needed.
+ */
+#define private public
+#include "headless.hpp"
+#undef private
+
+namespace
+{
+    std::mt19937 random(1357);
+
+    auto make_entry(const int i, const bool outlines) -> fc2::render
+    {
+        const auto x = static_cast<int>(random() % 1900);
+        const auto y = static_cast<int>(random() % 1060);
+        const auto thickness = 1 + static_cast<int>(random() % 3);
+
+        const auto pick = outlines ? i % 3 : i % 20;
+        if (outlines)
+        {
+            return pick == 0 ? fc2::draw::primitive::line(960, 1080, x, y, 255, 255, 255, 120, thickness)
+                : fc2::draw::primitive::box(x, y, 40, 80, 255, 0, 0, 255, thickness);
+        }
+
+        if (pick < 8)
+        {
+            return fc2::draw::primitive::box(x, y, 40, 80, 255, 0, 0, 255, thickness);
+        }
+
+        if (pick < 12)
+        {
+            return fc2::draw::primitive::line(960, 1080, x, y, 255, 255, 255, 120, thickness);
+        }
+
+        if (pick < 16)
+        {
+            return fc2::draw::primitive::text("player " + std::to_string(i), 0, x, y - 16, 255, 255, 255, 255);
+        }
+
+        if (pick < 19)
+        {
+            return fc2::draw::primitive::box_filled(x - 6, y, 4, 80, 0, 255, 0, 255);
+        }
+
+        auto entry = fc2::draw::primitive::box(x, y, 6, 0, 255, 255, 0, 255, 1);
+        entry.style[FC2_TEAM_DRAW_STYLE_TYPE] = FC2_TEAM_DRAW_TYPE_CIRCLE_FILLED;
+        return entry;
+    }
+
+    /**
+     * @brief decode the scene into the bucket of the direct path and into the buckets by type of the retained path
+     */
+    void load(const std::vector< fc2::render >& entries)
+    {
+        Drawing::retainedEntries = entries;
+        Drawing::retainedSlots.assign(entries.size(), Drawing::RetainedSlot());
+
+        for (auto& bucket : Drawing::retainedBuckets)
+        {
+            bucket.slots.clear();
+        }
+
+        for (std::size_t i = 0; i < entries.size(); ++i)
+        {
+            const int type = entries[i].style[FC2_TEAM_DRAW_STYLE_TYPE];
+            if (Drawing::IsDrawableType(type))
+            {
+                Drawing::retainedBuckets[type].slots.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        for (auto& bucket : Drawing::retainedBuckets)
+        {
+            Drawing::DecodeBucket(bucket);
+        }
+    }
+
+    struct result
+    {
+        int vertices = 0;
+        double us = 0.0;
+    };
+
+    /**
+     * @brief microseconds per frame spent in `draw` and the vertices it left in `list`, ImGui's frame around it isn't
+     * measured
+     */
+    template< typename fn_t >
+    auto measure(const int frames, const ImDrawList* list, fn_t&& draw) -> result
+    {
+        result output;
+        std::chrono::nanoseconds total{};
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            ImGui::NewFrame();
+            const auto canvas = ImGui::GetBackgroundDrawList();
+            const auto start = std::chrono::steady_clock::now();
+            draw(canvas);
+            total += std::chrono::steady_clock::now() - start;
+            output.vertices = (list ? list : canvas)->VtxBuffer.Size;
+            ImGui::EndFrame();
+        }
+
+        output.us = static_cast<double>(total.count()) / 1000.0 / static_cast<double>(frames);
+        return output;
+    }
+
+    /**
+     * @brief what DrawSlotsDirectly did before it wrote anything itself
+     */
+    void draw_each(ImDrawList* canvas)
+    {
+        auto& bucket = Drawing::retainedDirect;
+        bucket.slots.clear();
+        for (std::size_t i = 0; i < Drawing::retainedEntries.size(); ++i)
+        {
+            if (Drawing::IsDrawableType(Drawing::retainedEntries[i].style[FC2_TEAM_DRAW_STYLE_TYPE]))
+            {
+                bucket.slots.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        Drawing::DecodeBucket(bucket);
+        for (std::size_t i = 0; i < bucket.slots.size(); ++i)
+        {
+            Drawing::DrawPrimitive(canvas, Drawing::retainedEntries[bucket.slots[i]].style[FC2_TEAM_DRAW_STYLE_TYPE], bucket, i);
+        }
+    }
+
+    auto scratch_clip() -> ImVec4
+    {
+        const ImGuiIO& io = ImGui::GetIO();
+        return { 0.0f, 0.0f, io.DisplaySize.x, io.DisplaySize.y };
+    }
+
+    void tessellate_buckets(ImDrawList* canvas)
+    {
+        Drawing::ResetScratch(canvas, scratch_clip());
+        for (const int type : { FC2_TEAM_DRAW_TYPE_BOX_FILLED, FC2_TEAM_DRAW_TYPE_BOX, FC2_TEAM_DRAW_TYPE_LINE, FC2_TEAM_DRAW_TYPE_TEXT, FC2_TEAM_DRAW_TYPE_CIRCLE, FC2_TEAM_DRAW_TYPE_CIRCLE_FILLED })
+        {
+            Drawing::TessellateBucket(type);
+        }
+    }
+
+    void write_buckets(ImDrawList* canvas)
+    {
+        Drawing::ResetScratch(canvas, scratch_clip());
+        Drawing::WriteBucket(FC2_TEAM_DRAW_TYPE_BOX_FILLED);
+        Drawing::WriteBucket(FC2_TEAM_DRAW_TYPE_BOX);
+        Drawing::WriteBucket(FC2_TEAM_DRAW_TYPE_LINE);
+        Drawing::TessellateBucket(FC2_TEAM_DRAW_TYPE_TEXT);
+        Drawing::TessellateBucket(FC2_TEAM_DRAW_TYPE_CIRCLE);
+        Drawing::TessellateBucket(FC2_TEAM_DRAW_TYPE_CIRCLE_FILLED);
+    }
+
+    void print(const std::size_t count, const char* mix, const char* path, const char* before, const result& a, const char* after, const result& b)
+    {
+        const auto rate = [](const result& r) { return static_cast<double>(r.vertices) / std::max(r.us, 0.001); };
+        printf("%8zu %-9s %-8s | %9d | %-18s %9.1f %8.1f | %-18s %9.1f %8.1f | %6.2fx\n", count, mix, path, a.vertices, before, a.us,
+            rate(a), after, b.us, rate(b), a.us / std::max(b.us, 0.001));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int frames = 200;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--frames")
+        {
+            frames = std::max(1, atoi(argv[i + 1]));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    headless::start(ImVec2(1920.0f, 1080.0f));
+
+    printf("%d frames, time in us per frame, rate in million vertices per second\n\n", frames);
+    printf("%8s %-9s %-8s | %9s | %-18s %9s %8s | %-18s %9s %8s | %7s\n", "requests", "mix", "path", "vertices", "before", "us", "Mvtx/s",
+        "after", "us", "Mvtx/s", "speedup");
+
+    for (const bool outlines : { false, true })
+    {
+        for (const std::size_t count : { 100, 1000, 10000 })
+        {
+            std::vector< fc2::render > entries;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                entries.push_back(make_entry(static_cast<int>(i), outlines));
+            }
+
+            const char* mix = outlines ? "outlines" : "esp";
+            load(entries);
+
+            const auto each = measure(frames, nullptr, draw_each);
+            const auto direct = measure(frames, nullptr, Drawing::DrawSlotsDirectly);
+            print(count, mix, "direct", "ImGui per request", each, "DrawSlotsDirectly", direct);
+
+            const auto tessellated = measure(frames, &Drawing::retainedScratch, tessellate_buckets);
+            const auto written = measure(frames, &Drawing::retainedScratch, write_buckets);
+            print(count, mix, "buckets", "TessellateBucket", tessellated, "WriteBucket", written);
+        }
+    }
+
+    headless::stop();
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,210 @@
+/**
+ * @brief bytes moved and time per call of every request struct, copied through client::send against built in place
+ *
+ * usage: fc2t-bench-requests [--iterations n]
+ *
+ * client::send takes the request by value, copies it into the segment and copies the whole answer back out, that is
+ * twice the struct. a transaction writes the fields of the request and reads the fields of the answer where they lie in
+ * the segment, the in place column counts exactly those bytes. both are timed on the client side alone, the round trip
+ * against a server in a child process without latency is printed next to them for scale.
+ */
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    using namespace fc2::detail;
+
+    volatile std::size_t sink = 0;
+
+    auto time_per_call(const int iterations, const std::function< void() >& fn) -> long long
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            fn();
+        }
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / iterations;
+    }
+
+    /**
+     * @brief runs one request both ways. the client side is timed without handing the request to the server, it reads
+     * whatever the last answer left in the segment. the round trip is the in place request including the server.
+     * @param fill writes the request and returns how many bytes it wrote
+     * @param read reads the answer and returns how many bytes it read
+     */
+    template< typename t, typename fill_t, typename read_t >
+    void measure(const char* name, const int id, const int iterations, fill_t&& fill, read_t&& read)
+    {
+        std::size_t moved = 0;
+
+        // what client::send does, apart from the round trip
+        const auto copied = time_per_call(iterations, [&]
+            {
+                t req{};
+                fill(req);
+
+                transaction< t > tx(id, req);
+                if (!tx)
+                {
+                    return;
+                }
+
+                memcpy(static_cast<void*>(&req), static_cast<const void*>(&*tx), sizeof(t));
+                sink = sink + read(std::as_const(req));
+            });
+
+        const auto in_place = time_per_call(iterations, [&]
+            {
+                transaction< t > tx(id, no_init);
+                if (!tx)
+                {
+                    return;
+                }
+
+                sink = sink + fill(*tx) + read(std::as_const(*tx));
+            });
+
+        const auto round_trip = time_per_call(iterations, [&]
+            {
+                transaction< t > tx(id, no_init);
+                if (tx)
+                {
+                    moved = fill(*tx);
+                    if (tx.submit())
+                    {
+                        moved += read(std::as_const(*tx));
+                    }
+
+                    sink = sink + moved;
+                }
+            });
+
+        printf("%-14s %8zu %10zu %10zu %10lld %10lld %10lld\n", name, sizeof(t), 2 * sizeof(t), moved, copied, in_place, round_trip);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = 20000;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--iterations")
+        {
+            iterations = std::max(1, atoi(argv[i + 1]));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    standin::process server(standin::options{}, { fc2::draw::primitive::box(10, 10, 20, 20, 255, 0, 0, 255, 1) });
+    if (!server)
+    {
+        fprintf(stderr, "can't start the stand-in server\n");
+        return 1;
+    }
+
+    fc2::ping();
+    if (fc2::get_error() != FC2_TEAM_ERROR_NO_ERROR)
+    {
+        fprintf(stderr, "can't connect to the stand-in server\n");
+        return 1;
+    }
+
+    printf("%d iterations\n\n", iterations);
+    printf("%-14s %8s %10s %10s %10s %10s %10s\n", "request", "struct", "copied", "in place", "copied ns", "in place ns", "round trip");
+
+    measure< requests::ping_pong >("ping", FC2_TEAM_REQUESTS_PING, iterations,
+        [](requests::ping_pong& p)
+        {
+            p.ping = 1;
+            return sizeof p.ping;
+        },
+        [](const requests::ping_pong& p)
+        {
+            return static_cast<std::size_t>(p.pong != 0) * sizeof p.pong;
+        });
+
+    measure< requests::call >("call", FC2_TEAM_REQUESTS_CALL, iterations,
+        [](requests::call& p)
+        {
+            helper::safe_copy(p.identifier, "on_team_call", sizeof p.identifier);
+            p.typing = FC2_LUA_TYPE_INT;
+            return sizeof "on_team_call" + sizeof p.typing;
+        },
+        [](const requests::call& p)
+        {
+            int value = 0;
+            memcpy(&value, p.data, sizeof value);
+            sink = sink + static_cast<std::size_t>(value);
+            return sizeof value;
+        });
+
+    measure< requests::session >("session", FC2_TEAM_REQUESTS_SESSION, iterations,
+        [](requests::session&)
+        {
+            return std::size_t{ 0 };
+        },
+        [](const requests::session& p)
+        {
+            return strlen(p.username) + 1 + sizeof p.level;
+        });
+
+    measure< requests::read_memory >("read_memory", FC2_TEAM_REQUESTS_READ_MEMORY, iterations,
+        [](requests::read_memory& p)
+        {
+            p.address = 0x140001000ull;
+            p.size = sizeof(std::uint64_t);
+            return sizeof p.address + sizeof p.size;
+        },
+        [](const requests::read_memory& p)
+        {
+            return sizeof p.bytes_read + static_cast<std::size_t>(p.bytes_read);
+        });
+
+    measure< requests::draw::detail >("draw", FC2_TEAM_REQUESTS_DRAW, iterations,
+        [](requests::draw::detail& p)
+        {
+            p = fc2::draw::primitive::box(10, 10, 20, 20, 255, 0, 0, 255, 1);
+            return sizeof p;
+        },
+        [](const requests::draw::detail&)
+        {
+            return std::size_t{ 0 };
+        });
+
+    measure< requests::draw >("get_drawing", FC2_TEAM_REQUESTS_GET_DRAWING, iterations,
+        [](requests::draw&)
+        {
+            return std::size_t{ 0 };
+        },
+        [](const requests::draw& p)
+        {
+            // draw::get looks at the type of every entry and copies the used ones
+            std::size_t read = 0;
+            for (const auto& detail : p.details)
+            {
+                read += detail.style[FC2_TEAM_DRAW_STYLE_TYPE] != FC2_TEAM_DRAW_TYPE_NONE ? sizeof detail : sizeof detail.style[0];
+            }
+
+            return read;
+        });
+
+    measure< requests::api >("api", FC2_TEAM_REQUESTS_API, iterations,
+        [](requests::api& p)
+        {
+            helper::safe_copy(p.url, "getMember&size=512", sizeof p.url);
+            return sizeof "getMember&size=512";
+        },
+        [](const requests::api& p)
+        {
+            return strlen(p.buffer) + 1;
+        });
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+/**
+ * @brief the overlay's frame with retained geometry against tessellating every drawing request again
+ *
+ * usage: fc2t-bench-retained [--frames n]
+ *
+ * for scenes of 300 to 10000 drawing requests, replays frame sequences that keep a different share of them: a scene
+ * that doesn't change, a script updating at 60 Hz under an overlay at 240 fps that moves a fifth or all of its requests
+ * every update, and one that moves a fifth every frame. prints the slot hit rate, the time per frame of
+ * Drawing::DrawOverlay and of drawing every slot directly, and the time saved. runs the overlay's drawing code through
+ * tools/headless, no server is needed.
+ */
+#define private public
+#include "headless.hpp"
+#undef private
+
+namespace
+{
+    std::mt19937 random(2468);
+
+    auto make_entry(const int i) -> fc2::render
+    {
+        const auto x = static_cast<int>(random() % 1900);
+        const auto y = static_cast<int>(random() % 1060);
+
+        // an esp: per player a box, its outline, a health bar, a snap line and a name
+        switch (i % 5)
+        {
+        case 0:
+            return fc2::draw::primitive::box(x, y, 40, 80, 255, 0, 0, 255, 1);
+        case 1:
+            return fc2::draw::primitive::box(x, y, 42, 82, 0, 0, 0, 180, 3);
+        case 2:
+            return fc2::draw::primitive::box_filled(x - 6, y, 4, 80, 0, 255, 0, 255);
+        case 3:
+            return fc2::draw::primitive::line(960, 1080, x, y, 255, 255, 255, 120, 1);
+        default:
+            return fc2::draw::primitive::text("player " + std::to_string(i / 5), 0, x, y - 16, 255, 255, 255, 255);
+        }
+    }
+
+    struct scenario
+    {
+        const char* name;
+
+        /**
+         * @brief every `every`th frame a script update moves this share of the requests
+         */
+        int every;
+        double moved;
+    };
+
+    /**
+     * @brief frames of a scenario, the entries of every frame
+     */
+    auto make_frames(const std::size_t count, const scenario& s, const int frames) -> std::vector< std::vector< fc2::render > >
+    {
+        std::vector< fc2::render > entries;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            entries.push_back(make_entry(static_cast<int>(i)));
+        }
+
+        std::vector< std::vector< fc2::render > > output;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            if (s.every && frame % s.every == 0)
+            {
+                for (auto& entry : entries)
+                {
+                    if (static_cast<double>(random() % 1000) < s.moved * 1000.0)
+                    {
+                        entry.dimensions[0] += static_cast<int>(random() % 5) - 2;
+                        entry.dimensions[1] += static_cast<int>(random() % 5) - 2;
+                    }
+                }
+            }
+
+            output.push_back(entries);
+        }
+
+        return output;
+    }
+
+    /**
+     * @brief microseconds per frame spent in `draw`, ImGui's frame around it isn't measured
+     */
+    template< typename fn_t >
+    auto measure(const std::vector< std::vector< fc2::render > >& frames, fn_t&& draw) -> double
+    {
+        std::chrono::nanoseconds total{};
+        for (const auto& entries : frames)
+        {
+            headless::snapshot.entries = entries;
+
+            ImGui::NewFrame();
+            const auto start = std::chrono::steady_clock::now();
+            draw();
+            total += std::chrono::steady_clock::now() - start;
+            ImGui::EndFrame();
+        }
+
+        return static_cast<double>(total.count()) / 1000.0 / static_cast<double>(frames.size());
+    }
+
+    /**
+     * @brief what DrawOverlay did before it retained anything
+     */
+    void draw_directly()
+    {
+        const ImGuiIO& io = ImGui::GetIO();
+        const auto canvas = ImGui::GetBackgroundDrawList();
+
+        Drawing::retainedEntries = headless::snapshot.entries;
+        canvas->PushClipRect({ 0.0f - Config::iOffsetLeft, 0.0f - Config::iOffsetTop }, { io.DisplaySize.x + Config::iOffsetRight, io.DisplaySize.y + Config::iOffsetBottom });
+        Drawing::DrawSlotsDirectly(canvas);
+        canvas->PopClipRect();
+    }
+
+    /**
+     * @brief start the retained geometry over, so no scenario inherits the slots of the one before
+     */
+    void forget()
+    {
+        Drawing::retainedEntries.clear();
+        Drawing::retainedSlots.clear();
+        Drawing::retainedHits = 0;
+        Drawing::retainedMisses = 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int frames = 400;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--frames")
+        {
+            frames = std::max(1, atoi(argv[i + 1]));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    headless::start(ImVec2(1920.0f, 1080.0f));
+
+    const scenario scenarios[] =
+    {
+        { "static", 0, 0.0 },
+        { "60hz 20%", 4, 0.2 },
+        { "60hz all", 4, 1.0 },
+        { "every 20%", 1, 0.2 }
+    };
+
+    printf("%d frames\n\n", frames);
+    printf("%8s %-10s | %8s | %10s %11s | %9s %7s\n", "requests", "scenario", "hit rate", "direct us", "retained us", "saved us", "saved");
+
+    for (const std::size_t count : { 300, 1000, 10000 })
+    {
+        for (const auto& s : scenarios)
+        {
+            const auto sequence = make_frames(count, s, frames);
+
+            forget();
+            const auto direct = measure(sequence, draw_directly);
+
+            forget();
+            const auto retained = measure(sequence, Drawing::DrawOverlay);
+            const auto total = Drawing::retainedHits + Drawing::retainedMisses;
+            const auto rate = total ? 100.0 * static_cast<double>(Drawing::retainedHits) / static_cast<double>(total) : 0.0;
+
+            printf("%8zu %-10s | %7.1f%% | %10.1f %11.1f | %9.1f %6.1f%%\n", count, s.name, rate, direct, retained,
+                direct - retained, 100.0 * (direct - retained) / std::max(direct, 0.001));
+        }
+    }
+
+    headless::stop();
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+/**
+ * @brief the overlay's startup calls, one `call` per identifier against `call_many`
+ *
+ * usage: fc2t-bench-startup [--iterations n]
+ *
+ * Config::GetConfig reads 8 settings and UI::SetTargetWindow 2 more. for server latencies of 0 to 1000 us, prints the
+ * round trips and the wall time of fetching all 10 with separate calls and with the two `call_many` requests the
+ * overlay makes. the server runs in this process and advertises FC2_TEAM_EXTENSION_CALL_MANY.
+ */
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    // the overlay's BOOL on Windows
+    using BOOL = int;
+
+    void separate()
+    {
+        fc2::call< BOOL >("directx_overlay_streamproof", FC2_LUA_TYPE_BOOLEAN);
+        fc2::call< BOOL >("directx_overlay_autostart", FC2_LUA_TYPE_BOOLEAN);
+        fc2::call< BOOL >("directx_overlay_debug", FC2_LUA_TYPE_BOOLEAN);
+        fc2::call< std::uint32_t >("directx_overlay_target_fps", FC2_LUA_TYPE_INT);
+        fc2::call< int >("directx_overlay_random_min", FC2_LUA_TYPE_INT);
+        fc2::call< int >("directx_overlay_random_max", FC2_LUA_TYPE_INT);
+        fc2::call< std::string >("directx_overlay_window_name", FC2_LUA_TYPE_STRING);
+        fc2::call< int >("directx_overlay_quit_key", FC2_LUA_TYPE_INT);
+
+        fc2::call< std::uint32_t >("directx_overlay_target_handle", FC2_LUA_TYPE_INT);
+        fc2::call< std::uint32_t >("directx_overlay_target_process_id", FC2_LUA_TYPE_INT);
+    }
+
+    void batched()
+    {
+        fc2::call_many< BOOL, BOOL, BOOL, std::uint32_t, int, int, std::string, int >(
+            { "directx_overlay_streamproof", FC2_LUA_TYPE_BOOLEAN },
+            { "directx_overlay_autostart", FC2_LUA_TYPE_BOOLEAN },
+            { "directx_overlay_debug", FC2_LUA_TYPE_BOOLEAN },
+            { "directx_overlay_target_fps", FC2_LUA_TYPE_INT },
+            { "directx_overlay_random_min", FC2_LUA_TYPE_INT },
+            { "directx_overlay_random_max", FC2_LUA_TYPE_INT },
+            { "directx_overlay_window_name", FC2_LUA_TYPE_STRING },
+            { "directx_overlay_quit_key", FC2_LUA_TYPE_INT }
+        );
+
+        fc2::call_many< std::uint32_t, std::uint32_t >(
+            { "directx_overlay_target_handle", FC2_LUA_TYPE_INT },
+            { "directx_overlay_target_process_id", FC2_LUA_TYPE_INT }
+        );
+    }
+
+    struct result
+    {
+        long long us = 0;
+        double trips = 0;
+    };
+
+    auto measure(const int iterations, void (*fn)()) -> result
+    {
+        fc2::stats::reset();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            fn();
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        result output;
+        output.us = elapsed.count() / iterations;
+        for (const auto request : { FC2_TEAM_REQUESTS_CALL, FC2_TEAM_REQUESTS_CALL_MANY })
+        {
+            output.trips += static_cast<double>(fc2::stats::get(request).count) / iterations;
+        }
+
+        return output;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = 200;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--iterations")
+        {
+            iterations = std::max(1, atoi(argv[i + 1]));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    standin::options opts;
+    opts.capabilities = 1u << FC2_TEAM_EXTENSION_CALL_MANY;
+
+    standin::server server(opts);
+    if (!server)
+    {
+        fprintf(stderr, "can't start the stand-in server\n");
+        return 1;
+    }
+
+    fc2::ping();
+    if (fc2::get_error() != FC2_TEAM_ERROR_NO_ERROR || !fc2::detail::client::get()->supports(FC2_TEAM_EXTENSION_CALL_MANY))
+    {
+        fprintf(stderr, "can't connect to the stand-in server or it doesn't support call_many\n");
+        return 1;
+    }
+
+    printf("%d iterations, 10 identifiers\n\n", iterations);
+    printf("%10s | %8s %10s | %8s %10s | %7s\n", "latency us", "calls", "us", "batched", "us", "speedup");
+
+    for (const int latency : { 0, 50, 250, 1000 })
+    {
+        server.set_latency(std::chrono::microseconds(latency));
+
+        const auto a = measure(iterations, separate);
+        const auto b = measure(iterations, batched);
+
+        printf("%10d | %8.1f %10lld | %8.1f %10lld | %6.1fx\n", latency, a.trips, a.us, b.trips, b.us,
+            static_cast<double>(a.us) / static_cast<double>(std::max(b.us, 1LL)));
+    }
+
+    return 0;
+}
\ No newline at end of file
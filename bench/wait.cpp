@@ -0,0 +1,78 @@
+/**
+ * @brief cost of waiting for the server with one wait strategy
+ *
+ * usage: fc2t-bench-wait-<strategy> [--iterations n]
+ *
+ * every strategy is the same source built with different FC2_TEAM_WAIT_* values, see CMakeLists.txt. the stand-in
+ * server answers every request type with a different latency, so one run covers fast and slow requests. cpu/op is the
+ * cpu time the waiting thread burned per request, the price of a strategy that reacts quicker.
+ */
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    struct scenario
+    {
+        int request;
+        std::chrono::microseconds latency;
+    };
+
+    constexpr scenario scenarios[] = {
+        { FC2_TEAM_REQUESTS_PING, std::chrono::microseconds(0) },
+        { FC2_TEAM_REQUESTS_CALL, std::chrono::microseconds(50) },
+        { FC2_TEAM_REQUESTS_SESSION, std::chrono::microseconds(500) },
+        { FC2_TEAM_REQUESTS_GET_DRAWING, std::chrono::microseconds(5000) },
+    };
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = 1000;
+    if (argc > 2 && std::string(argv[1]) == "--iterations")
+    {
+        iterations = std::max(1, atoi(argv[2]));
+    }
+
+    standin::options opts;
+    for (const auto& s : scenarios)
+    {
+        opts.request_latency[s.request] = s.latency;
+    }
+
+    standin::process server(opts);
+    if (!server)
+    {
+        fprintf(stderr, "can't start the stand-in server\n");
+        return 1;
+    }
+
+    fc2::ping();
+
+    printf("strategy %s: spin %u, yield %u, block %u us\n\n", FC2T_WAIT_STRATEGY, static_cast<unsigned>(FC2_TEAM_WAIT_SPIN_COUNT), static_cast<unsigned>(FC2_TEAM_WAIT_YIELD_COUNT), static_cast<unsigned>(FC2_TEAM_WAIT_BLOCK_MICROSECONDS));
+    printf("%10s %10s %10s %10s %10s %10s\n", "latency", "ns/op", "p50", "p99", "p999", "cpu/op");
+
+    for (const auto& s : scenarios)
+    {
+        fc2::stats::reset();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            fc2::detail::transaction< fc2::detail::requests::ping_pong > tx(s.request);
+            tx.submit();
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        const auto summary = fc2::stats::get(s.request);
+
+        printf("%8lldus %10lld %10lld %10lld %10lld %10lld\n",
+            static_cast<long long>(s.latency.count()),
+            static_cast<long long>(elapsed.count() / iterations),
+            static_cast<long long>(summary.p50.count()),
+            static_cast<long long>(summary.p99.count()),
+            static_cast<long long>(summary.p999.count()),
+            static_cast<long long>(summary.cpu.count() / std::max< long long >(1, static_cast<long long>(summary.count))));
+    }
+
+    return 0;
+}
\ No newline at end of file
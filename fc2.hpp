@@ -41,6 +41,66 @@
      */
 #ifndef FC2_TEAM_REQUESTS_API_TIMEOUT
 #define FC2_TEAM_REQUESTS_API_TIMEOUT 5
+#endif
+
+     /**
+      * @brief how many times to poll the request status with a cpu pause hint before giving up the time slice. most requests are answered within a few microseconds, so a short spin keeps the latency low without burning a whole core on slow ones.
+      */
+#ifndef FC2_TEAM_WAIT_SPIN_COUNT
+#define FC2_TEAM_WAIT_SPIN_COUNT 4000
+#endif
+
+     /**
+      * @brief how many times to yield the time slice after spinning before the client starts blocking.
+      */
+#ifndef FC2_TEAM_WAIT_YIELD_COUNT
+#define FC2_TEAM_WAIT_YIELD_COUNT 64
+#endif
+
+     /**
+      * @brief longest time (in microseconds) the client blocks in one go while waiting for a slow request. on Linux this is a futex wait on the status word, so a server that wakes the futex is noticed immediately. on Windows it is a WaitOnAddress on the status word, which only ends at the timeout because the server writes it from another process, and is rounded up to whole milliseconds, see `wait::block`.
+      */
+#ifndef FC2_TEAM_WAIT_BLOCK_MICROSECONDS
+#define FC2_TEAM_WAIT_BLOCK_MICROSECONDS 250
+#endif
+
+     /**
+      * @brief a client that lost the server tries to reconnect after this many milliseconds, doubling the delay after every failed attempt up to the maximum. requests in between fail right away.
+      */
+#ifndef FC2_TEAM_RECONNECT_MIN_MILLISECONDS
+#define FC2_TEAM_RECONNECT_MIN_MILLISECONDS 100
+#endif
+
+#ifndef FC2_TEAM_RECONNECT_MAX_MILLISECONDS
+#define FC2_TEAM_RECONNECT_MAX_MILLISECONDS 5000
+#endif
+
+     /**
+      * @brief `fc2::engine::pattern` remembers results in this file, relative to the directory of the executable. the cache is keyed by the module's size and header, so a changed binary is scanned again. define it as "" to always scan.
+      */
+#ifndef FC2_TEAM_PATTERN_CACHE_FILE
+#define FC2_TEAM_PATTERN_CACHE_FILE "fc2t-patterns.bin"
+#endif
+
+     /**
+      * @brief how many bytes of responses `fc2::api` and `fc2::http::get` keep when called with a max age. the least recently used ones are dropped first.
+      */
+#ifndef FC2_TEAM_RESPONSE_CACHE_BYTES
+#define FC2_TEAM_RESPONSE_CACHE_BYTES ( 1024 * 1024 )
+#endif
+
+     /**
+      * @brief `fc2::engine::cache` fetches process memory in aligned lines of this many bytes. has to be a power of two and no larger than FC2_TEAM_MAX_DATA_BUFFER.
+      */
+#ifndef FC2_TEAM_READ_CACHE_LINE_SIZE
+#define FC2_TEAM_READ_CACHE_LINE_SIZE 256
+#endif
+
+     /**
+      * @brief how many lines `fc2::engine::cache` keeps before it starts over.
+      */
+#ifndef FC2_TEAM_READ_CACHE_LINES
+#define FC2_TEAM_READ_CACHE_LINES 1024
 #endif
 
      /**
@@ -102,6 +162,26 @@
 #endif
 #ifndef SHM_KEY_WIN_AURORA2
 #define SHM_KEY_WIN_AURORA2 "Global\\329032499"
+#endif
+
+        /**
+         * @brief key of the optional extension segment. servers that support protocol extensions create it next to the request segment and advertise what they support in its header.
+         */
+#ifndef SHM_EXTENSION_OFFSET_LINUX
+#define SHM_EXTENSION_OFFSET_LINUX 65536
+#endif
+#ifndef SHM_EXTENSION_SUFFIX_WIN
+#define SHM_EXTENSION_SUFFIX_WIN "-extension"
+#endif
+
+        /**
+         * @brief where the locks that keep several FC2T clients from writing the same request buffer live. lock files on linux, a named mapping of owner tokens on windows.
+         */
+#ifndef SHM_LOCK_PREFIX_LINUX
+#define SHM_LOCK_PREFIX_LINUX "/tmp/fc2t-"
+#endif
+#ifndef SHM_LOCK_SUFFIX_WIN
+#define SHM_LOCK_SUFFIX_WIN "-lock"
 #endif
 
         /**
@@ -151,6 +231,13 @@ enum FC2_TEAM_REQUESTS : int
     FC2_TEAM_REQUESTS_GET_DRAWING,
     FC2_TEAM_REQUESTS_SESSION,
     FC2_TEAM_REQUESTS_DRAW,
+    FC2_TEAM_REQUESTS_GET_DRAWING_STREAM,
+    FC2_TEAM_REQUESTS_GET_DRAWING_COMPACT,
+    FC2_TEAM_REQUESTS_GET_DRAWING_DELTA,
+    FC2_TEAM_REQUESTS_CALL_MANY,
+    FC2_TEAM_REQUESTS_DRAW_BATCH,
+    FC2_TEAM_REQUESTS_READ_MEMORY_MANY,
+    FC2_TEAM_REQUESTS_HTTP_STREAM,
 };
 
 /**
@@ -217,6 +304,80 @@ enum FC2_TEAM_DRAW_DIMENSIONS : int
     FC2_TEAM_DRAW_DIMENSIONS_BOTTOM,
 };
 
+/**
+ * @brief protocol extensions a server can advertise in the extension segment. each one is a bit in the capability mask and an index into the region table of the segment header.
+ */
+enum FC2_TEAM_EXTENSION : int
+{
+    /**
+     * @brief triple-buffered drawing frames that can be read without a request
+     */
+    FC2_TEAM_EXTENSION_DRAWING_FEED,
+
+    /**
+     * @brief FC2_TEAM_REQUESTS_GET_DRAWING_STREAM is understood. this has no region.
+     */
+    FC2_TEAM_EXTENSION_DRAWING_STREAM,
+
+    /**
+     * @brief FC2_TEAM_REQUESTS_GET_DRAWING_COMPACT is understood. this has no region.
+     */
+    FC2_TEAM_EXTENSION_DRAWING_COMPACT,
+
+    /**
+     * @brief FC2_TEAM_REQUESTS_GET_DRAWING_DELTA is understood. this has no region.
+     */
+    FC2_TEAM_EXTENSION_DRAWING_DELTA,
+
+    /**
+     * @brief FC2_TEAM_REQUESTS_CALL_MANY is understood. this has no region.
+     */
+    FC2_TEAM_EXTENSION_CALL_MANY,
+
+    /**
+     * @brief one request buffer per FC2_TEAM_LANE, each served independently
+     */
+    FC2_TEAM_EXTENSION_LANES,
+
+    /**
+     * @brief a ring of request buffers that any client can claim without a lock. takes precedence over lanes.
+     */
+    FC2_TEAM_EXTENSION_SLOTS,
+
+    /**
+     * @brief FC2_TEAM_REQUESTS_DRAW_BATCH is understood. this has no region.
+     */
+    FC2_TEAM_EXTENSION_DRAW_BATCH,
+
+    /**
+     * @brief FC2_TEAM_REQUESTS_READ_MEMORY_MANY is understood. this has no region.
+     */
+    FC2_TEAM_EXTENSION_READ_MEMORY_MANY,
+
+    /**
+     * @brief FC2_TEAM_REQUESTS_HTTP_STREAM is understood. this has no region.
+     */
+    FC2_TEAM_EXTENSION_HTTP_STREAM,
+};
+
+/**
+ * @brief request lanes. on servers that provide FC2_TEAM_EXTENSION_LANES every lane has its own buffer and status word, so a slow request on one lane never holds up another. otherwise all lanes share the request segment.
+ */
+enum FC2_TEAM_LANE : int
+{
+    /**
+     * @brief drawing, memory, input and everything else that runs every frame
+     */
+    FC2_TEAM_LANE_LATENCY,
+
+    /**
+     * @brief web API, HTTP, lua, pattern scans and other requests that may take seconds
+     */
+    FC2_TEAM_LANE_BULK,
+
+    FC2_TEAM_LANE_COUNT,
+};
+
 /**
  * @brief includes
  */
@@ -229,7 +390,28 @@ enum FC2_TEAM_DRAW_DIMENSIONS : int
 #include <variant> /** std::variant **/
 #include <optional> /** std::optional **/
 #include <cstddef> /** offsetof **/
+#include <cstdint> /** std::uint32_t **/
 #include <algorithm> /** std::min/std::max/std::copy_if **/
+#include <chrono> /** std::chrono::steady_clock **/
+#include <atomic> /** std::atomic_thread_fence, std::atomic_ref **/
+#include <new> /** placement new **/
+#include <type_traits> /** std::is_trivially_copyable_v **/
+#include <utility> /** std::as_const **/
+#include <tuple> /** std::tuple **/
+#include <mutex> /** std::mutex **/
+#include <deque> /** std::deque **/
+#include <bit> /** std::bit_width **/
+#include <ctime> /** clock_gettime **/
+#include <unordered_map> /** std::unordered_map **/
+#include <fstream> /** std::ifstream, std::ofstream **/
+#include <filesystem> /** std::filesystem::path **/
+#include <list> /** std::list **/
+#include <future> /** std::shared_future **/
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine> /** std::coroutine_handle **/
+#define FC2_TEAM_COROUTINES
+#endif
 
 #ifdef __linux__
  /**
@@ -237,7 +419,14 @@ enum FC2_TEAM_DRAW_DIMENSIONS : int
   */
 #include <sys/ipc.h>
 #include <sys/shm.h>
-#include <semaphore.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <signal.h>
+#include <cerrno>
 #include <pthread.h>
 
   /**
@@ -252,10 +441,13 @@ enum FC2_TEAM_DRAW_DIMENSIONS : int
 #else
 #define SHM_KEY SHM_KEY_LINUX_GLOBAL
 #endif
+
+#define SHM_EXTENSION_KEY ( SHM_KEY + SHM_EXTENSION_OFFSET_LINUX )
 #else
 #define NOMINMAX
 #include <windows.h>
 #include <iterator>
+#pragma comment(lib, "Synchronization.lib") /** WaitOnAddress **/
 
 #ifdef FC2_TEAM_CONSTELLATION4
 #define SHM_KEY SHM_KEY_WIN_CONSTELLATION
@@ -266,6 +458,8 @@ enum FC2_TEAM_DRAW_DIMENSIONS : int
 #else
 #define SHM_KEY SHM_KEY_WIN_GLOBAL
 #endif
+
+#define SHM_EXTENSION_KEY SHM_KEY SHM_EXTENSION_SUFFIX_WIN
 #endif
 
 namespace fc2
@@ -369,6 +563,29 @@ namespace fc2
                 unsigned char data[FC2_TEAM_MAX_DATA_BUFFER]{};
             };
 
+            /**
+             * @brief several process memory reads in one round trip
+             *
+             * the server reads `size` bytes at `address` into `data + offset` for every entry and sets `bytes_read`. a failed read leaves `bytes_read` at 0.
+             */
+            struct read_memory_many
+            {
+                struct entry
+                {
+                    unsigned long long address = 0;
+                    std::uint32_t size = 0;
+                    std::uint32_t offset = 0;
+                    std::uint32_t bytes_read = 0;
+                    std::uint32_t reserved = 0;
+                };
+
+                std::uint32_t count = 0;
+                std::uint32_t reserved = 0;
+
+                entry entries[256];
+                unsigned char data[FC2_TEAM_BUFFER_SIZE - 8 - 2 * sizeof(std::uint32_t) - 256 * sizeof(entry)];
+            };
+
             /**
              * @brief on_team_call request
              */
@@ -380,6 +597,23 @@ namespace fc2
                 char args[FC2_TEAM_MAX_DATA_BUFFER]{};
             };
 
+            /**
+             * @brief several on_team_call requests in one round trip. the server answers every entry in order, exactly like separate `call` requests.
+             * entries hold the same identifiers and results as `call`, so nothing that fits into one `call` gets truncated here.
+             */
+            struct call_many
+            {
+                struct entry
+                {
+                    char identifier[FC2_TEAM_MAX_DATA_BUFFER]{};
+                    FC2_LUA_TYPE typing = FC2_LUA_TYPE::FC2_LUA_TYPE_NONE;
+                    unsigned char data[FC2_TEAM_MAX_DATA_BUFFER]{};
+                };
+
+                std::uint32_t count = 0;
+                entry entries[(FC2_TEAM_BUFFER_SIZE - 8 - sizeof(std::uint32_t)) / sizeof(entry)];
+            };
+
             /**
              * @brief http request
              */
@@ -390,6 +624,30 @@ namespace fc2
                 char response[FC2_TEAM_MAX_DATA_BUFFER]{};
             };
 
+            /**
+             * @brief an api or http response of any size, pulled in chunks
+             *
+             * the first request has `stream` 0: the server performs the request described by `source`, `url` and `post`, keeps the response, answers with its stream id, the total size and the first chunk. the following requests pass the stream id and the amount of bytes received so far as `offset` until the server sets `end`. the server drops the response after the last chunk, or if a stream isn't continued for a while.
+             */
+            struct http_stream
+            {
+                /**
+                 * @brief FC2_TEAM_REQUESTS_API or FC2_TEAM_REQUESTS_HTTP_REQUEST
+                 */
+                std::uint32_t source = 0;
+                std::uint32_t stream = 0;
+                std::uint64_t offset = 0;
+
+                std::uint64_t total = 0;
+                std::uint32_t size = 0;
+                bool end = false;
+                bool failed = false;
+
+                char url[FC2_TEAM_MAX_DATA_BUFFER]{};
+                char post[FC2_TEAM_MAX_DATA_BUFFER]{};
+                char data[FC2_TEAM_BUFFER_SIZE - 8 - 4 * sizeof(std::uint64_t) - 2 * FC2_TEAM_MAX_DATA_BUFFER];
+            };
+
             /**
              * @brief encode and escape
              */
@@ -433,6 +691,71 @@ namespace fc2
                 detail details[100]{ };
             };
 
+            /**
+             * @brief several drawing requests in one round trip. the server queues them in order, exactly like separate `draw` requests.
+             */
+            struct draw_batch
+            {
+                std::uint32_t count = 0;
+                std::uint32_t reserved = 0;
+
+                draw::detail details[(FC2_TEAM_BUFFER_SIZE - 8 - 2 * sizeof(std::uint32_t)) / sizeof(draw::detail)];
+            };
+
+            /**
+             * @brief one chunk of the variable-length drawing stream
+             *
+             * the first request asks for offset 0 with frame 0. the server takes a snapshot of all drawing requests, answers with the snapshot's frame id, the total amount of entries and as many entries as fit into this chunk. the following requests pass that frame id and the next offset. if the snapshot expired the server answers with a new frame id and offset 0.
+             */
+            struct draw_stream
+            {
+                std::uint32_t frame = 0;
+                std::uint32_t offset = 0;
+                std::uint32_t total = 0;
+                std::uint32_t count = 0;
+
+                draw::detail details[(FC2_TEAM_BUFFER_SIZE - 8 - 4 * sizeof(std::uint32_t)) / sizeof(draw::detail)];
+            };
+
+            /**
+             * @brief one chunk of the drawing requests in the compact encoding (see detail::compact). works like draw_stream, except offset, total and count are in bytes.
+             */
+            struct draw_compact
+            {
+                std::uint32_t frame = 0;
+                std::uint32_t offset = 0;
+                std::uint32_t total = 0;
+                std::uint32_t count = 0;
+
+                std::uint8_t data[FC2_TEAM_BUFFER_SIZE - 8 - 4 * sizeof(std::uint32_t)];
+            };
+
+            /**
+             * @brief one chunk of the drawing changes since a frame the client acknowledged. works like draw_stream.
+             *
+             * drawing requests are kept in slots. the client passes the last frame it applied in `acknowledged`. the server answers with the frame the changes are relative to in `base`, which is 0 if it can't produce a delta and sends every slot instead, and the amount of slots after the update in `slots`. a change with FC2_TEAM_DRAW_TYPE_NONE removes the slot's drawing.
+             */
+            struct draw_delta
+            {
+                struct change
+                {
+                    std::uint32_t slot;
+                    draw::detail entry;
+                };
+
+                std::uint32_t frame = 0;
+                std::uint32_t offset = 0;
+                std::uint32_t total = 0;
+                std::uint32_t count = 0;
+
+                std::uint32_t acknowledged = 0;
+                std::uint32_t base = 0;
+                std::uint32_t slots = 0;
+                std::uint32_t reserved = 0;
+
+                change changes[(FC2_TEAM_BUFFER_SIZE - 8 - 8 * sizeof(std::uint32_t)) / sizeof(change)];
+            };
+
             /**
              * @brief member information from the Sessions module in FC2
              *
@@ -485,714 +808,4720 @@ namespace fc2
             };
         };
 
-#pragma pack(push, 1)
-        struct information
+        /**
+         * @brief layout of the optional extension segment
+         *
+         * a server that doesn't know about extensions never creates the segment, so every feature below silently falls back to the request path.
+         */
+        namespace extension
         {
-            /**
-             * @brief request ID / command ID
-             */
-            int id = 0;
+            constexpr std::uint32_t magic = 0x54324346; /** "FC2T" **/
+            constexpr std::uint32_t version = 1;
+            constexpr std::size_t max_regions = 16;
 
-            /**
-             * @brief status
-             */
-            int status = FC2_TEAM_SERVER_PENDING;
+            struct header
+            {
+                std::uint32_t magic;
+                std::uint32_t version;
 
-            /**
-             * @brief buffer
-             */
-            char* data = nullptr;
-        };
-#pragma pack(pop)
+                /**
+                 * @brief size of the whole segment in bytes
+                 */
+                std::uint32_t size;
 
-        class shm
-        {
-        public:
-#ifdef __linux__
-            /**
-             * @brief shm id
-             */
-            int id = -1;
+                /**
+                 * @brief bit n is set when the server provides FC2_TEAM_EXTENSION n
+                 */
+                std::uint32_t capabilities;
+
+                /**
+                 * @brief byte offset of each extension's region from the start of the segment
+                 */
+                std::uint32_t regions[max_regions];
+            };
 
             /**
-             * @brief semaphore mutex to prevent simultaneous operations
+             * @brief drawing frames published by the server every tick
+             *
+             * the producer writes into a frame that isn't `latest`: it bumps the frame's sequence to an odd value, writes count and details, bumps the sequence back to an even value and then stores the frame index in `latest`. readers retry when the sequence is odd or changed while they were copying (seqlock).
+             *
+             * `count` is the amount of drawing requests the server has, even if that is more than a frame holds. only the first 100 are published then, and readers have to stream them instead.
              */
-            sem_t sem_mutex = {};
-#else
-            HANDLE shm_handle = nullptr;
-            HANDLE sem_mutex = nullptr;
-#endif
+            struct drawing_feed
+            {
+                struct frame
+                {
+                    std::uint32_t sequence;
+                    std::uint32_t count;
+
+                    /**
+                     * @brief increases with every published frame, even if the drawing didn't change
+                     */
+                    std::uint64_t number;
+
+                    requests::draw::detail details[100];
+                };
+
+                std::uint32_t latest;
+                std::uint32_t reserved;
+                frame frames[3];
+            };
 
             /**
-             * @brief last caught error
+             * @brief request buffers, one per FC2_TEAM_LANE
+             *
+             * lane n starts `sizeof(lanes) + n * stride` bytes into the region and is laid out exactly like the request segment.
              */
-            FC2_TEAM_ERROR_CODES last_error = FC2_TEAM_ERROR_NO_ERROR;
+            struct lanes
+            {
+                std::uint32_t count;
+                std::uint32_t stride;
+            };
 
             /**
-             * @brief data being sent/rec
+             * @brief request buffers shared by every client
+             *
+             * slot n starts `sizeof(slots) + n * stride` bytes into the region with a `slot` header, followed by a request buffer laid out exactly like the request segment. a client owns a slot once it swapped its token into `owner`, and gives it back by storing zero. the server serves every slot whose status is pending, no matter who owns it.
              */
-            void* data;
-
-        public:
-            FC2_TEAM_FORCE_INLINE shm()
+            struct slots
             {
-#ifdef __linux__
+                std::uint32_t count;
+                std::uint32_t stride;
+
                 /**
-                 * @brief find server
+                 * @brief where the next client starts looking for a free slot, so clients spread over the ring
                  */
-                id = shmget(SHM_KEY, FC2_TEAM_BUFFER_SIZE, 0666);
-
-                if (id < 0)
-                {
-                    /**
-                     * @brief universe4 isn't open. cant connect to server.
-                     */
-                    last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_FC2_SOLUTION_OPEN;
-                    return;
-                }
+                std::uint32_t next;
+                std::uint32_t reserved;
+            };
 
+            struct slot
+            {
                 /**
-                 * @brief attach to data
+                 * @brief process id in the upper half, a per process counter in the lower half. zero if free.
                  */
-                data = shmat(id, nullptr, 0);
-                if (static_cast <char*>(data) == reinterpret_cast <char*>(-1))
-                {
-                    /**
-                     * @brief memory failed to attach
-                     */
-                    last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_MEMORY_FAILED_TO_ATTACH;
-                    return;
-                }
+                std::uint64_t owner;
+                std::uint64_t reserved;
+            };
+        }
+
+        /**
+         * @brief compact encoding of drawing requests
+         *
+         * a full `render` entry is 172 bytes even for a line that only needs four coordinates and a colour. the compact encoding is a header, followed by one 24 byte primitive per entry, followed by a string pool that only holds the text of text primitives.
+         *
+         * version 1 had 16-bit text offsets and silently dropped text once the pool passed 64 KB. version 2 has 32-bit offsets. data of another version is rejected by `decode`, which makes `draw::get` fall back to the stream.
+         *
+         * coordinates, thickness and font size are stored as 16-bit and colour channels as 8-bit values. anything outside of those ranges is clamped, everything inside of them survives a round trip unchanged.
+         */
+        namespace compact
+        {
+            constexpr std::uint8_t version = 2;
+
+#pragma pack(push, 1)
+            struct header
+            {
+                std::uint8_t version;
+                std::uint8_t reserved[3];
+                std::uint32_t count;
+                std::uint32_t pool_size;
+            };
+
+            struct primitive
+            {
+                std::uint8_t type;
 
                 /**
-                 * @brief start semaphore
+                 * @brief text length in the string pool, without null-terminator
                  */
-                sem_init(&sem_mutex, 1, 1);
+                std::uint8_t text_length;
+                std::uint16_t reserved;
+                std::uint32_t text_offset;
+
+                std::int16_t thickness;
+                std::int16_t font_size;
+                std::int16_t dimensions[4];
 
                 /**
-                 * @brief set success
+                 * @brief RGBA8, red in the lowest byte
                  */
-                last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR;
-#else
-                /**
-                 * @brief find mapping
-                 *
-                 * on Windows, OpenFileMapping will succeed even if it doesn't have FILE_MAP_ALL_ACCESS permissions. this is extremely misleading. if you notice your projects not working, it is important to note that you should execute it with administrator permissions.
-                 */
-                shm_handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, SHM_KEY);
+                std::uint32_t color;
+            };
+#pragma pack(pop)
+
+            static_assert(sizeof(primitive) == 24, "compact primitives are 24 bytes on the wire");
+
+            FC2T_FUNCTION auto to_int16(const std::int32_t value) -> std::int16_t
+            {
+                return static_cast<std::int16_t>(std::clamp< std::int32_t >(value, INT16_MIN, INT16_MAX));
+            }
+
+            FC2T_FUNCTION auto to_uint8(const std::int32_t value) -> std::uint32_t
+            {
+                return static_cast<std::uint32_t>(std::clamp< std::int32_t >(value, 0, 255));
+            }
 
+            /**
+             * @brief encode drawing requests
+             * @param entries
+             * @param count
+             * @param output replaced with the encoded bytes
+             */
+            FC2T_FUNCTION void encode(const requests::draw::detail* entries, const std::size_t count, std::vector< std::uint8_t >& output)
+            {
                 /**
-                 * @brief universe4 isn't open. cant connect to server.
+                 * @brief text goes to the pool, which is only known after walking all entries
                  */
-                if (shm_handle == nullptr || GetLastError() == ERROR_ALREADY_EXISTS)
+                std::string pool;
+
+                output.resize(sizeof(header) + count * sizeof(primitive));
+
+                for (std::size_t i = 0; i < count; ++i)
                 {
-                    last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_FC2_SOLUTION_OPEN;
-                    return;
+                    const auto& entry = entries[i];
+
+                    primitive p{};
+                    p.type = static_cast<std::uint8_t>(entry.style[FC2_TEAM_DRAW_STYLE_TYPE]);
+                    p.thickness = to_int16(entry.style[FC2_TEAM_DRAW_STYLE_THICKNESS]);
+                    p.font_size = to_int16(entry.style[FC2_TEAM_DRAW_STYLE_FONT_SIZE]);
+
+                    for (int d = 0; d < 4; ++d)
+                    {
+                        p.dimensions[d] = to_int16(entry.dimensions[d]);
+                    }
+
+                    p.color = to_uint8(entry.style[FC2_TEAM_DRAW_STYLE_RED])
+                        | to_uint8(entry.style[FC2_TEAM_DRAW_STYLE_GREEN]) << 8
+                        | to_uint8(entry.style[FC2_TEAM_DRAW_STYLE_BLUE]) << 16
+                        | to_uint8(entry.style[FC2_TEAM_DRAW_STYLE_ALPHA]) << 24;
+
+                    /**
+                     * @brief at most 127 bytes per entry, the pool needs over 33 million text entries to outgrow a 32-bit offset
+                     */
+                    if (entry.style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_TEXT)
+                    {
+                        const auto length = strnlen(entry.text, sizeof entry.text - 1);
+
+                        p.text_offset = static_cast<std::uint32_t>(pool.size());
+                        p.text_length = static_cast<std::uint8_t>(length);
+                        pool.append(entry.text, length);
+                    }
+
+                    memcpy(output.data() + sizeof(header) + i * sizeof(primitive), &p, sizeof p);
                 }
 
-                /**
-                 * @brief attach to data
-                 */
-                data = MapViewOfFile(shm_handle, FILE_MAP_ALL_ACCESS, 0, 0, FC2_TEAM_BUFFER_SIZE);
+                header h{};
+                h.version = version;
+                h.count = static_cast<std::uint32_t>(count);
+                h.pool_size = static_cast<std::uint32_t>(pool.size());
+                memcpy(output.data(), &h, sizeof h);
 
-                if (data == nullptr)
+                output.insert(output.end(), pool.begin(), pool.end());
+            }
+
+            /**
+             * @brief decode drawing requests
+             * @param data
+             * @param size
+             * @param output replaced with the decoded entries
+             * @return false if the data is malformed or from an unknown version
+             */
+            FC2T_FUNCTION auto decode(const std::uint8_t* data, const std::size_t size, std::vector< requests::draw::detail >& output) -> bool
+            {
+                output.clear();
+
+                if (size < sizeof(header))
                 {
-                    last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_MEMORY_FAILED_TO_ATTACH;
-                    return;
+                    return false;
                 }
 
-                sem_mutex = CreateMutex(nullptr, 0, nullptr);
-                if (sem_mutex == nullptr)
+                header h;
+                memcpy(&h, data, sizeof h);
+
+                const auto pool_start = sizeof(header) + static_cast<std::size_t>(h.count) * sizeof(primitive);
+                if (h.version != version || pool_start > size || size - pool_start < h.pool_size)
                 {
-                    last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_FAILED_SEMAPHORE;
-                    return;
+                    return false;
                 }
 
-                /**
-                 * @brief set success
-                 */
-                last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR;
-#endif
+                const auto pool = reinterpret_cast<const char*>(data + pool_start);
+                output.resize(h.count);
+
+                for (std::size_t i = 0; i < h.count; ++i)
+                {
+                    primitive p;
+                    memcpy(&p, data + sizeof(header) + i * sizeof(primitive), sizeof p);
+
+                    auto& entry = output[i];
+                    entry.style[FC2_TEAM_DRAW_STYLE_TYPE] = p.type;
+                    entry.style[FC2_TEAM_DRAW_STYLE_THICKNESS] = p.thickness;
+                    entry.style[FC2_TEAM_DRAW_STYLE_FONT_SIZE] = p.font_size;
+                    entry.style[FC2_TEAM_DRAW_STYLE_RED] = static_cast<std::int32_t>(p.color & 0xFF);
+                    entry.style[FC2_TEAM_DRAW_STYLE_GREEN] = static_cast<std::int32_t>(p.color >> 8 & 0xFF);
+                    entry.style[FC2_TEAM_DRAW_STYLE_BLUE] = static_cast<std::int32_t>(p.color >> 16 & 0xFF);
+                    entry.style[FC2_TEAM_DRAW_STYLE_ALPHA] = static_cast<std::int32_t>(p.color >> 24 & 0xFF);
+
+                    for (int d = 0; d < 4; ++d)
+                    {
+                        entry.dimensions[d] = p.dimensions[d];
+                    }
+
+                    if (p.text_length)
+                    {
+                        if (static_cast<std::size_t>(p.text_offset) + p.text_length > h.pool_size || p.text_length >= sizeof entry.text)
+                        {
+                            return false;
+                        }
+
+                        memcpy(entry.text, pool + p.text_offset, p.text_length);
+                    }
+
+                    entry.text[p.text_length] = '\0';
+                }
+
+                return true;
             }
+        }
+
+#pragma pack(push, 1)
+        struct information
+        {
+            /**
+             * @brief request ID / command ID
+             */
+            int id = 0;
+
+            /**
+             * @brief status
+             */
+            int status = FC2_TEAM_SERVER_PENDING;
 
+            /**
+             * @brief buffer
+             */
+            char* data = nullptr;
         };
+#pragma pack(pop)
 
-        class client
+        /**
+         * @brief waiting for the server. spin for a bounded budget, then yield, then block until the deadline passes.
+         */
+        namespace wait
         {
-        public:
             /**
-             * @brief create our client
-             * @return
+             * @brief the counts of the spin and yield phases. either can be 0 to turn its phase off, the phases check that with `if constexpr` on these, a comparison with the macro itself would be always false and warn.
              */
-            FC2T_FUNCTION auto get()
-            {
-                /**
-                 * @brief create object
-                 */
-                static auto obj = std::make_unique< shm >();
+            constexpr unsigned int spin_count = FC2_TEAM_WAIT_SPIN_COUNT;
+            constexpr unsigned int yield_count = FC2_TEAM_WAIT_YIELD_COUNT;
 
-                /**
-                 * @brief get client
-                 */
-                return obj.get();
+            /**
+             * @brief cpu hint that we're in a spin loop
+             */
+            FC2T_FUNCTION void relax()
+            {
+#ifdef _WIN32
+                YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#elif defined(__aarch64__)
+                asm volatile("yield");
+#endif
             }
 
             /**
-             * @brief send to universe4
-             * @tparam t
-             * @param id
-             * @param req
+             * @brief read the status word. the server writes it from another process, so it must not be cached in a register.
+             * @param info
              * @return
              */
-            template< typename t >
-            FC2T_FUNCTION auto send(const int id, t req) -> t
+            FC2T_FUNCTION auto status(const information* info) -> int
             {
+                return *reinterpret_cast<const volatile int*>(&info->status);
+            }
+
+            /**
+             * @brief wait while the status is still pending, for at most the given duration
+             *
+             * on Linux this sleeps on the status word with a futex, a server that issues FUTEX_WAKE after flipping the status wakes us right away, any other server after `duration`. on Windows it sleeps on the status word with WaitOnAddress. that only sees wakes from the same process, so it always runs until the timeout, which is rounded up to whole milliseconds and then to the timer resolution (the overlay sets it to 1 ms with timeBeginPeriod). only requests that outlast spinning and yielding get here, and they no longer keep a core busy while they wait.
+             *
+             * @param info
+             * @param duration
+             */
+            FC2T_FUNCTION void block(const information* info, const std::chrono::microseconds duration)
+            {
+#ifdef __linux__
                 /**
-                 * @brief get client
+                 * @brief not FUTEX_PRIVATE_FLAG, the status word lives in memory shared with the server.
                  */
-                auto c = get();
+                timespec ts{};
+                ts.tv_sec = static_cast<time_t>(duration.count() / 1000000);
+                ts.tv_nsec = static_cast<long>((duration.count() % 1000000) * 1000);
 
-                /**
-                 * @brief did something break
-                */
-#ifdef __linux__
-                if (c->id < 0 || c->last_error != FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR)
-                {
-                    c->last_error = FC2_TEAM_ERROR_NO_FC2_SOLUTION_OPEN;
-                    return req;
-                }
+                syscall(SYS_futex, &info->status, FUTEX_WAIT, FC2_TEAM_SERVER_PENDING, &ts, nullptr, 0);
+#else
+                int pending = FC2_TEAM_SERVER_PENDING;
+                const auto milliseconds = std::max< long long >(1, (duration.count() + 999) / 1000);
 
-                /**
-                 * @brief semaphore lock
-                */
-                sem_wait(&c->sem_mutex);
+                WaitOnAddress(const_cast<int*>(&info->status), &pending, sizeof pending, static_cast<DWORD>(milliseconds));
+#endif
+            }
+
+            /**
+             * @brief wait while an owner token of a request buffer still holds `value`, for at most the given duration
+             *
+             * on Windows this is a WaitOnAddress on the token, which `wake` ends as soon as a thread of this process gives the buffer back, and a release by another process at the timeout. on Linux the token is 64 bits wide and can't be waited on with a futex, it sleeps for `duration`, which Linux doesn't round up to milliseconds.
+             *
+             * @param owner
+             * @param value
+             * @param duration
+             */
+            FC2T_FUNCTION void block(std::uint64_t* owner, std::uint64_t value, const std::chrono::microseconds duration)
+            {
+#ifdef __linux__
+                (void)owner;
+                (void)value;
+                std::this_thread::sleep_for(duration);
 #else
+                const auto milliseconds = std::max< long long >(1, (duration.count() + 999) / 1000);
 
-                if (c->shm_handle == nullptr || c->shm_handle == INVALID_HANDLE_VALUE || c->last_error != FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR)
-                {
-                    c->last_error = FC2_TEAM_ERROR_NO_FC2_SOLUTION_OPEN;
-                    return req;
-                }
+                WaitOnAddress(owner, &value, sizeof value, static_cast<DWORD>(milliseconds));
+#endif
+            }
 
-                /**
-                 * @brief semaphore lock
-                */
-                WaitForSingleObject(c->sem_mutex, INFINITE);
+            /**
+             * @brief wake the threads of this process that wait in `block` for an owner token that was just cleared
+             * @param owner
+             */
+            FC2T_FUNCTION void wake(std::uint64_t* owner)
+            {
+#ifdef __linux__
+                (void)owner;
+#else
+                WakeByAddressAll(owner);
 #endif
+            }
 
+            /**
+             * @brief wait until the server is done with the request
+             * @param info
+             * @param deadline
+             * @return false if the deadline passed before the server answered
+             */
+            FC2T_FUNCTION auto until_done(const information* info, const std::chrono::steady_clock::time_point deadline) -> bool
+            {
                 /**
-                 * @brief create new data with our request info
+                 * @brief spin
                  */
-                const auto data = std::make_unique< char[] >(offsetof(information, data) + sizeof(t));
+                if constexpr (spin_count > 0)
                 {
-                    memcpy(data.get(), static_cast<const void*>(&id), sizeof(detail::information::id));
-                    memcpy(data.get() + offsetof(information, data), static_cast<const void*>(&req), sizeof(t));
+                    for (unsigned int i = 0; i < spin_count; ++i)
+                    {
+                        if (status(info) != FC2_TEAM_SERVER_PENDING)
+                        {
+                            std::atomic_thread_fence(std::memory_order_acquire);
+                            return true;
+                        }
+
+                        relax();
+                    }
                 }
 
                 /**
-                 * @brief send to universe4
+                 * @brief yield
                  */
-                memcpy(c->data, data.get(), offsetof(information, data) + sizeof(t));
+                if constexpr (yield_count > 0)
+                {
+                    for (unsigned int i = 0; i < yield_count; ++i)
+                    {
+                        if (status(info) != FC2_TEAM_SERVER_PENDING)
+                        {
+                            std::atomic_thread_fence(std::memory_order_acquire);
+                            return true;
+                        }
 
-                /**
-                 * @brief convert data
-                 */
-                const auto information = static_cast<detail::information*>(c->data);
+                        std::this_thread::yield();
+                    }
+                }
 
                 /**
-                 * @brief wait until completed
+                 * @brief block
                  */
-                const unsigned long long timeout_time = static_cast<unsigned long long>(std::time(nullptr)) + (information->id == FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_API || information->id == FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_HTTP_REQUEST ? FC2_TEAM_REQUESTS_API_TIMEOUT : FC2_TEAM_REQUESTS_TIMEOUT);
-
-                while (information->status == FC2_TEAM_STATUS::FC2_TEAM_SERVER_PENDING) {
-                    if (static_cast<unsigned long long>(std::time(nullptr)) > timeout_time)
+                while (status(info) == FC2_TEAM_SERVER_PENDING)
+                {
+                    const auto now = std::chrono::steady_clock::now();
+                    if (now >= deadline)
                     {
-                        information->status = FC2_TEAM_STATUS::FC2_TEAM_SERVER_TIMEOUT;
-                        c->last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_FC2_SOLUTION_OPEN;
-                        break;
+                        return false;
                     }
+
+                    const auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now);
+                    block(info, std::min(remaining, std::chrono::microseconds(FC2_TEAM_WAIT_BLOCK_MICROSECONDS)));
                 }
 
-                /**
-                 * @brief semaphore unlock
-                */
-#ifdef __linux__
-                sem_post(&c->sem_mutex);
-#else
-                ReleaseMutex(c->sem_mutex);
-#endif
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return true;
+            }
 
-                /**
-                 * @brief return data
-                 */
-                memcpy(&req, static_cast<char*>(c->data) + offsetof(detail::information, data), sizeof(t));
+            /**
+             * @brief same escalation as `until_done`, for loops that check something other than the status word
+             */
+            class backoff
+            {
+                unsigned int count = 0;
 
+            public:
                 /**
-                 * @brief reset last error
+                 * @param block called with the longest time to block once spinning and yielding didn't help
                  */
-                if (information->status == FC2_TEAM_STATUS::FC2_TEAM_SERVER_DONE)
+                template< typename block_t >
+                FC2_TEAM_FORCE_INLINE void pause(block_t&& block)
                 {
-                    c->last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR;
+                    if constexpr (spin_count > 0)
+                    {
+                        if (count < spin_count)
+                        {
+                            relax();
+                            ++count;
+                            return;
+                        }
+                    }
+
+                    if constexpr (spin_count + yield_count > 0)
+                    {
+                        if (count < spin_count + yield_count)
+                        {
+                            std::this_thread::yield();
+                            ++count;
+                            return;
+                        }
+                    }
+
+                    block(std::chrono::microseconds(FC2_TEAM_WAIT_BLOCK_MICROSECONDS));
                 }
-                return req;
-            }
-        };
+            };
+        }
 
-        namespace helper
+        class shm
         {
+        public:
+#ifdef __linux__
             /**
-             * @brief safely copy values
-             * @param dest
-             * @param src
-             * @param size
+             * @brief shm id
              */
-            FC2T_FUNCTION void safe_copy(char* dest, const char* src, const std::size_t size)
-            {
-                /**
-                 * @brief prevent exceeding in length
-                 */
-                std::size_t l = strlen(src) + 1;
-                l = std::min(l, size);
+            int id = -1;
+#else
+            HANDLE shm_handle = nullptr;
+#endif
 
-                /**
-                 * @brief cpy
-                 */
-                memcpy(dest, src, l);
+            /**
+             * @brief lock of the request segment (0) and of every lane (1 + lane). the local flag orders threads of this process, the lock file or owner token orders processes.
+             *
+             * none of them belongs to a thread. a request may be started on one thread and finished on another, which is what the reactor does.
+             */
+            static constexpr int lock_count = 1 + FC2_TEAM_LANE_COUNT;
 
-                /**
-                 * @brief null-terminator
-                 */
-                dest[l - 1] = '\0';
-            }
+            std::atomic_flag local_lock[lock_count];
+#ifdef __linux__
+            int lock_file[lock_count];
+#else
+            HANDLE lock_handle = nullptr;
+            std::uint64_t* lock_owner = nullptr;
+#endif
 
-            FC2T_FUNCTION void safe_copy(char* dest, const std::string& src, const std::size_t size)
-            {
-                safe_copy(dest, src.c_str(), size);
-            }
-        }
-    } // end detail
+            /**
+             * @brief last caught error. atomic because the error is usually checked on another thread than the one sending requests.
+             */
+            std::atomic< FC2_TEAM_ERROR_CODES > last_error = FC2_TEAM_ERROR_NO_ERROR;
 
-    /**
-     * @brief data type aliases
-     */
-    typedef fc2::detail::requests::draw::detail render;
+            /**
+             * @brief data being sent/rec
+             */
+            void* data = nullptr;
 
-    /**
-     * @brief get FC2T version compiled with
-     * @return
-     */
-    FC2T_FUNCTION auto get_version() -> std::pair< unsigned int, unsigned int >
-    {
-        return std::make_pair(FC2_TEAM_VERSION_MAJOR, FC2_TEAM_VERSION_MINOR);
-    }
+#ifdef __linux__
+            int extension_id = -1;
+#else
+            HANDLE extension_handle = nullptr;
+#endif
 
-    /**
-     * @brief get the last error FC2T invoked. use this function to check if the FC2 solution has been closed or isn't open to begin with.
-     * @return
+            /**
+             * @brief optional extension segment, nullptr if the server doesn't provide one
+             */
+            void* extension = nullptr;
+            std::size_t extension_size = 0;
+
+            /**
+             * @brief request buffer of every lane, nullptr if the lane shares the request segment
+             */
+            void* lanes[FC2_TEAM_LANE_COUNT] = {};
+
+            /**
+             * @brief the slot ring, nullptr if the server doesn't provide one
+             */
+            extension::slots* slots = nullptr;
+            std::atomic< std::uint32_t > tokens{ 0 };
+
+            /**
+             * @brief last drawing feed frame seen and when it was seen. a feed that stops advancing is treated as gone.
+             */
+            std::uint64_t feed_number = 0;
+            std::chrono::steady_clock::time_point feed_seen{};
+
+            /**
+             * @brief bumped on every successful (re)connect
+             */
+            std::atomic< std::uint64_t > generation{ 0 };
+
+            /**
+             * @brief bumped on every `engine::attach`, the attached process and its memory may be different afterwards
+             */
+            std::atomic< std::uint64_t > attachments{ 0 };
+
+            /**
+             * @brief how many `access` objects are alive, or -1 while reconnecting. detaching is only allowed while nobody uses the segments.
+             */
+            std::atomic< int > users{ 0 };
+
+            /**
+             * @brief only one thread reconnects at a time. the others keep failing fast.
+             */
+            std::mutex reconnect_mutex;
+            std::chrono::steady_clock::time_point next_attempt{};
+            std::chrono::milliseconds retry_delay{ FC2_TEAM_RECONNECT_MIN_MILLISECONDS };
+
+            /**
+             * @brief capability mask of the extension segment, copied so checking it never touches a mapping that may go away
+             */
+            std::atomic< std::uint32_t > capabilities{ 0 };
+
+        public:
+            /**
+             * @brief keeps the segments attached while it is alive. only counts users, so it may be destroyed on another thread than the one that created it.
+             */
+            class access
+            {
+                shm* c;
+
+            public:
+                FC2_TEAM_FORCE_INLINE explicit access(shm* c) : c(c)
+                {
+                    auto count = c->users.load(std::memory_order_relaxed);
+                    for (;;)
+                    {
+                        /**
+                         * @brief a reconnect is in progress, it never takes long
+                         */
+                        if (count < 0)
+                        {
+                            c->users.wait(count, std::memory_order_relaxed);
+                            count = c->users.load(std::memory_order_relaxed);
+                            continue;
+                        }
+
+                        if (c->users.compare_exchange_weak(count, count + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                        {
+                            return;
+                        }
+                    }
+                }
+
+                FC2_TEAM_FORCE_INLINE ~access()
+                {
+                    c->users.fetch_sub(1, std::memory_order_release);
+                }
+
+                access(const access&) = delete;
+                access& operator=(const access&) = delete;
+            };
+
+            FC2_TEAM_FORCE_INLINE shm()
+            {
+#ifdef __linux__
+                std::fill(std::begin(lock_file), std::end(lock_file), -1);
+#endif
+                connect();
+            }
+
+            /**
+             * @brief reconnect if the last request failed. attempts are spaced out with an exponential backoff, in between every request fails right away.
+             */
+            FC2_TEAM_FORCE_INLINE void maintain()
+            {
+                if (last_error.load(std::memory_order_relaxed) == FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR)
+                {
+                    return;
+                }
+
+                std::unique_lock< std::mutex > attempt(reconnect_mutex, std::try_to_lock);
+                if (!attempt)
+                {
+                    return;
+                }
+
+                const auto now = std::chrono::steady_clock::now();
+                if (now < next_attempt)
+                {
+                    return;
+                }
+
+                /**
+                 * @brief requests still in flight, on this thread or another one. try again on the next call.
+                 */
+                int idle = 0;
+                if (!users.compare_exchange_strong(idle, -1, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return;
+                }
+
+                disconnect();
+                const bool connected = connect();
+
+                users.store(0, std::memory_order_release);
+                users.notify_all();
+
+                if (connected)
+                {
+                    retry_delay = std::chrono::milliseconds(FC2_TEAM_RECONNECT_MIN_MILLISECONDS);
+                    return;
+                }
+
+                next_attempt = now + retry_delay;
+                retry_delay = std::min(retry_delay * 2, std::chrono::milliseconds(FC2_TEAM_RECONNECT_MAX_MILLISECONDS));
+            }
+
+        private:
+            /**
+             * @brief create whatever lock isn't open yet
+             * @return
+             */
+            FC2_TEAM_FORCE_INLINE auto open_locks() -> bool
+            {
+#ifdef __linux__
+                /**
+                 * @brief a lock that can't be created only loses protection against other processes, not between threads of this one
+                 */
+                for (int i = 0; i < lock_count; ++i)
+                {
+                    if (lock_file[i] >= 0)
+                    {
+                        continue;
+                    }
+
+                    char path[64];
+                    snprintf(path, sizeof path, SHM_LOCK_PREFIX_LINUX "%d-%d.lock", static_cast<int>(SHM_KEY), i);
+
+                    lock_file[i] = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+                    if (lock_file[i] >= 0)
+                    {
+                        /**
+                         * @brief the umask of whoever creates it first shouldn't lock everybody else out
+                         */
+                        fchmod(lock_file[i], 0666);
+                    }
+                }
+#else
+                /**
+                 * @brief named, so every client of the same solution shares them. a new mapping is zeroed, so every lock starts out free.
+                 */
+                if (lock_owner != nullptr)
+                {
+                    return true;
+                }
+
+                lock_handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(std::uint64_t) * lock_count, SHM_KEY SHM_LOCK_SUFFIX_WIN);
+                if (lock_handle == nullptr)
+                {
+                    return false;
+                }
+
+                lock_owner = static_cast<std::uint64_t*>(MapViewOfFile(lock_handle, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(std::uint64_t) * lock_count));
+                if (lock_owner == nullptr)
+                {
+                    CloseHandle(lock_handle);
+                    lock_handle = nullptr;
+                    return false;
+                }
+#endif
+
+                return true;
+            }
+
+            /**
+             * @brief attach to the server's segments
+             * @return
+             */
+            FC2_TEAM_FORCE_INLINE auto connect() -> bool
+            {
+#ifdef __linux__
+                /**
+                 * @brief find server
+                 */
+                id = shmget(SHM_KEY, FC2_TEAM_BUFFER_SIZE, 0666);
+
+                if (id < 0)
+                {
+                    /**
+                     * @brief universe4 isn't open. cant connect to server.
+                     */
+                    last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_FC2_SOLUTION_OPEN;
+                    return false;
+                }
+
+                /**
+                 * @brief attach to data
+                 */
+                data = shmat(id, nullptr, 0);
+                if (static_cast <char*>(data) == reinterpret_cast <char*>(-1))
+                {
+                    /**
+                     * @brief memory failed to attach
+                     */
+                    data = nullptr;
+                    id = -1;
+                    last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_MEMORY_FAILED_TO_ATTACH;
+                    return false;
+                }
+
+                open_locks();
+#else
+                /**
+                 * @brief find mapping
+                 *
+                 * on Windows, OpenFileMapping will succeed even if it doesn't have FILE_MAP_ALL_ACCESS permissions. this is extremely misleading. if you notice your projects not working, it is important to note that you should execute it with administrator permissions.
+                 */
+                shm_handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, SHM_KEY);
+
+                /**
+                 * @brief universe4 isn't open. cant connect to server.
+                 */
+                if (shm_handle == nullptr || GetLastError() == ERROR_ALREADY_EXISTS)
+                {
+                    last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_FC2_SOLUTION_OPEN;
+                    return false;
+                }
+
+                /**
+                 * @brief attach to data
+                 */
+                data = MapViewOfFile(shm_handle, FILE_MAP_ALL_ACCESS, 0, 0, FC2_TEAM_BUFFER_SIZE);
+
+                if (data == nullptr)
+                {
+                    last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_MEMORY_FAILED_TO_ATTACH;
+                    return false;
+                }
+
+                if (!open_locks())
+                {
+                    last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_FAILED_SEMAPHORE;
+                    return false;
+                }
+#endif
+
+                attach_extension();
+
+                /**
+                 * @brief set success
+                 */
+                generation.fetch_add(1, std::memory_order_release);
+                last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR;
+                return true;
+            }
+
+            /**
+             * @brief detach from every segment. the locks stay open, they don't belong to the server.
+             */
+            FC2_TEAM_FORCE_INLINE void disconnect()
+            {
+                capabilities = 0;
+                slots = nullptr;
+                for (auto& lane : lanes)
+                {
+                    lane = nullptr;
+                }
+
+                feed_number = 0;
+                feed_seen = {};
+
+#ifdef __linux__
+                if (extension)
+                {
+                    shmdt(extension);
+                }
+
+                if (data)
+                {
+                    shmdt(data);
+                }
+
+                extension_id = -1;
+                id = -1;
+#else
+                if (extension)
+                {
+                    UnmapViewOfFile(extension);
+                }
+
+                if (extension_handle != nullptr)
+                {
+                    CloseHandle(extension_handle);
+                }
+
+                if (data)
+                {
+                    UnmapViewOfFile(data);
+                }
+
+                if (shm_handle != nullptr)
+                {
+                    CloseHandle(shm_handle);
+                }
+
+                extension_handle = nullptr;
+                shm_handle = nullptr;
+#endif
+
+                extension = nullptr;
+                extension_size = 0;
+                data = nullptr;
+            }
+
+            /**
+             * @brief attach to the extension segment if the server created one. not having one is not an error.
+             */
+            FC2_TEAM_FORCE_INLINE void attach_extension()
+            {
+                void* mapping = nullptr;
+                std::size_t mapping_size = 0;
+
+#ifdef __linux__
+                extension_id = shmget(SHM_EXTENSION_KEY, 0, 0666);
+                if (extension_id < 0)
+                {
+                    return;
+                }
+
+                shmid_ds ds{};
+                if (shmctl(extension_id, IPC_STAT, &ds) < 0)
+                {
+                    extension_id = -1;
+                    return;
+                }
+
+                mapping = shmat(extension_id, nullptr, 0);
+                if (static_cast<char*>(mapping) == reinterpret_cast<char*>(-1))
+                {
+                    extension_id = -1;
+                    return;
+                }
+
+                mapping_size = ds.shm_segsz;
+#else
+                extension_handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, SHM_EXTENSION_KEY);
+                if (extension_handle == nullptr)
+                {
+                    return;
+                }
+
+                mapping = MapViewOfFile(extension_handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+                if (mapping == nullptr)
+                {
+                    CloseHandle(extension_handle);
+                    extension_handle = nullptr;
+                    return;
+                }
+
+                MEMORY_BASIC_INFORMATION mbi{};
+                VirtualQuery(mapping, &mbi, sizeof mbi);
+                mapping_size = mbi.RegionSize;
+#endif
+
+                /**
+                 * @brief make sure it's a layout we understand. otherwise let go of it entirely, nothing may be left open that `disconnect` doesn't know about.
+                 */
+                const auto hdr = static_cast<const extension::header*>(mapping);
+                if (mapping_size < sizeof(extension::header) || hdr->magic != extension::magic || hdr->version != extension::version || hdr->size > mapping_size)
+                {
+#ifdef __linux__
+                    shmdt(mapping);
+                    extension_id = -1;
+#else
+                    UnmapViewOfFile(mapping);
+                    CloseHandle(extension_handle);
+                    extension_handle = nullptr;
+#endif
+                    return;
+                }
+
+                extension = mapping;
+                extension_size = hdr->size;
+                capabilities = hdr->capabilities;
+
+                attach_lanes();
+                attach_slots();
+            }
+
+            /**
+             * @brief locate the slot ring. it is only used if every slot fits a full request.
+             */
+            FC2_TEAM_FORCE_INLINE void attach_slots()
+            {
+                const auto region = this->region< extension::slots >(FC2_TEAM_EXTENSION_SLOTS);
+                if (!region || reinterpret_cast<std::uintptr_t>(region) % alignof(std::uint64_t) || region->count == 0 || region->stride < sizeof(extension::slot) + FC2_TEAM_BUFFER_SIZE || region->stride % alignof(std::uint64_t))
+                {
+                    return;
+                }
+
+                const auto base = reinterpret_cast<char*>(region) + sizeof(extension::slots);
+                if (base + static_cast<std::size_t>(region->count) * region->stride > static_cast<char*>(extension) + extension_size)
+                {
+                    return;
+                }
+
+                slots = region;
+            }
+
+            /**
+             * @brief locate the lane buffers. lanes are only used if every one of them fits a full request.
+             */
+            FC2_TEAM_FORCE_INLINE void attach_lanes()
+            {
+                const auto region = this->region< extension::lanes >(FC2_TEAM_EXTENSION_LANES);
+                if (!region || region->count < FC2_TEAM_LANE_COUNT || region->stride < FC2_TEAM_BUFFER_SIZE)
+                {
+                    return;
+                }
+
+                const auto base = reinterpret_cast<char*>(region) + sizeof(extension::lanes);
+                if (base + static_cast<std::size_t>(FC2_TEAM_LANE_COUNT) * region->stride > static_cast<char*>(extension) + extension_size)
+                {
+                    return;
+                }
+
+                for (int i = 0; i < FC2_TEAM_LANE_COUNT; ++i)
+                {
+                    lanes[i] = base + static_cast<std::size_t>(i) * region->stride;
+                }
+            }
+
+        public:
+            /**
+             * @brief get an extension's region if the server advertises it. only valid while holding `access`.
+             * @tparam t
+             * @param index
+             * @return nullptr if not supported
+             */
+            template< typename t >
+            FC2_TEAM_FORCE_INLINE auto region(const FC2_TEAM_EXTENSION index) const -> t*
+            {
+                if (!extension)
+                {
+                    return nullptr;
+                }
+
+                if (!supports(index))
+                {
+                    return nullptr;
+                }
+
+                const auto hdr = static_cast<const extension::header*>(extension);
+                const std::size_t offset = hdr->regions[index];
+                if (offset < sizeof(extension::header) || offset + sizeof(t) > extension_size)
+                {
+                    return nullptr;
+                }
+
+                return reinterpret_cast<t*>(static_cast<char*>(extension) + offset);
+            }
+
+            /**
+             * @brief does the server advertise an extension
+             * @param index
+             * @return
+             */
+            FC2_TEAM_FORCE_INLINE auto supports(const FC2_TEAM_EXTENSION index) const -> bool
+            {
+                return capabilities.load(std::memory_order_relaxed) & (1u << index);
+            }
+
+            /**
+             * @brief a claimed request buffer
+             */
+            struct ownership
+            {
+                /**
+                 * @brief nullptr if nothing was claimed
+                 */
+                void* buffer = nullptr;
+
+                /**
+                 * @brief index of the lock that is held, or -1 for a slot
+                 */
+                int lock = -1;
+
+                std::uint64_t* owner = nullptr;
+            };
+
+            /**
+             * @brief claim a request buffer for a lane. uses a free slot if the server provides a slot ring, otherwise the lane's buffer (or the request segment) under its lock.
+             * @param lane
+             * @param block wait until a buffer is free
+             * @return an empty ownership if `block` is false and nothing was free
+             */
+            FC2_TEAM_FORCE_INLINE auto acquire(const FC2_TEAM_LANE lane, const bool block) -> ownership
+            {
+                if (slots)
+                {
+                    return claim_slot(block);
+                }
+
+                const int lock = lanes[lane] ? 1 + lane : 0;
+                if (!lock_buffer(lock, block))
+                {
+                    return {};
+                }
+
+                return { lanes[lane] ? lanes[lane] : data, lock, nullptr };
+            }
+
+            /**
+             * @brief give a claimed request buffer back
+             * @param claim
+             */
+            FC2_TEAM_FORCE_INLINE void release(const ownership& claim)
+            {
+                if (claim.owner)
+                {
+                    std::atomic_ref< std::uint64_t >(*claim.owner).store(0, std::memory_order_release);
+                    wait::wake(claim.owner);
+                    return;
+                }
+
+                if (claim.lock >= 0)
+                {
+                    unlock_buffer(claim.lock);
+                }
+            }
+
+        private:
+            FC2T_FUNCTION auto process_id() -> std::uint32_t
+            {
+#ifdef __linux__
+                return static_cast<std::uint32_t>(getpid());
+#else
+                return static_cast<std::uint32_t>(GetCurrentProcessId());
+#endif
+            }
+
+            /**
+             * @brief is the process that owns a slot still around
+             * @param pid
+             * @return
+             */
+            FC2T_FUNCTION auto alive(const std::uint32_t pid) -> bool
+            {
+#ifdef __linux__
+                return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#else
+                const auto process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+                if (process == nullptr)
+                {
+                    return GetLastError() == ERROR_ACCESS_DENIED;
+                }
+
+                DWORD code = 0;
+                const bool running = GetExitCodeProcess(process, &code) && code == STILL_ACTIVE;
+                CloseHandle(process);
+                return running;
+#endif
+            }
+
+            /**
+             * @brief swap our token into a free slot of the ring
+             * @param block
+             * @return
+             */
+            FC2_TEAM_FORCE_INLINE auto claim_slot(const bool block) -> ownership
+            {
+                const auto pid = process_id();
+                const auto base = reinterpret_cast<char*>(slots) + sizeof(extension::slots);
+                const auto count = slots->count;
+                const auto stride = slots->stride;
+
+                wait::backoff backoff;
+                for (bool reclaim = false;; reclaim = true)
+                {
+                    const std::uint64_t token = static_cast<std::uint64_t>(pid) << 32 | tokens.fetch_add(1, std::memory_order_relaxed);
+                    const auto start = std::atomic_ref< std::uint32_t >(slots->next).fetch_add(1, std::memory_order_relaxed);
+
+                    /**
+                     * @brief the slot to wait for if every one is taken
+                     */
+                    std::uint64_t* busy = nullptr;
+                    std::uint64_t held = 0;
+
+                    for (std::uint32_t i = 0; i < count; ++i)
+                    {
+                        const auto slot = base + static_cast<std::size_t>((start + i) % count) * stride;
+                        auto& owner = reinterpret_cast<extension::slot*>(slot)->owner;
+
+                        std::atomic_ref< std::uint64_t > ref(owner);
+                        std::uint64_t expected = ref.load(std::memory_order_relaxed);
+
+                        /**
+                         * @brief once every slot was taken, look for slots still held by processes that died with them
+                         */
+                        if (expected != 0 && !(reclaim && !alive(static_cast<std::uint32_t>(expected >> 32))))
+                        {
+                            if (!busy)
+                            {
+                                busy = &owner;
+                                held = expected;
+                            }
+
+                            continue;
+                        }
+
+                        if (ref.compare_exchange_strong(expected, token, std::memory_order_acquire, std::memory_order_relaxed))
+                        {
+                            return { slot + sizeof(extension::slot), -1, &owner };
+                        }
+                    }
+
+                    if (!block)
+                    {
+                        return {};
+                    }
+
+                    backoff.pause([busy, held](const std::chrono::microseconds duration)
+                        {
+                            if (busy)
+                            {
+                                wait::block(busy, held, duration);
+                            }
+                        });
+                }
+            }
+
+            /**
+             * @brief lock one of the request buffers against other threads and other processes
+             * @param index
+             * @param block
+             * @return
+             */
+            FC2_TEAM_FORCE_INLINE auto lock_buffer(const int index, const bool block) -> bool
+            {
+                while (local_lock[index].test_and_set(std::memory_order_acquire))
+                {
+                    if (!block)
+                    {
+                        return false;
+                    }
+
+                    local_lock[index].wait(true, std::memory_order_relaxed);
+                }
+
+#ifdef __linux__
+                if (lock_file[index] < 0)
+                {
+                    return true;
+                }
+
+                int result;
+                do
+                {
+                    result = flock(lock_file[index], LOCK_EX | (block ? 0 : LOCK_NB));
+                } while (result < 0 && errno == EINTR);
+
+                if (result == 0 || errno != EWOULDBLOCK)
+                {
+                    return true;
+                }
+#else
+                /**
+                 * @brief same as a slot: swap our token in, and once that failed, take over tokens of clients that died mid request. the request is rewritten anyway.
+                 */
+                std::atomic_ref< std::uint64_t > owner(lock_owner[index]);
+                const std::uint64_t token = static_cast<std::uint64_t>(process_id()) << 32 | tokens.fetch_add(1, std::memory_order_relaxed);
+
+                wait::backoff backoff;
+                for (bool reclaim = false;; reclaim = true)
+                {
+                    std::uint64_t expected = owner.load(std::memory_order_relaxed);
+                    if ((expected == 0 || (reclaim && !alive(static_cast<std::uint32_t>(expected >> 32)))) && owner.compare_exchange_strong(expected, token, std::memory_order_acquire, std::memory_order_relaxed))
+                    {
+                        return true;
+                    }
+
+                    if (!block)
+                    {
+                        break;
+                    }
+
+                    backoff.pause([this, index, expected](const std::chrono::microseconds duration) { wait::block(&lock_owner[index], expected, duration); });
+                }
+#endif
+
+                local_lock[index].clear(std::memory_order_release);
+                local_lock[index].notify_one();
+                return false;
+            }
+
+            FC2_TEAM_FORCE_INLINE void unlock_buffer(const int index)
+            {
+#ifdef __linux__
+                if (lock_file[index] >= 0)
+                {
+                    flock(lock_file[index], LOCK_UN);
+                }
+#else
+                std::atomic_ref< std::uint64_t >(lock_owner[index]).store(0, std::memory_order_release);
+                wait::wake(&lock_owner[index]);
+#endif
+
+                local_lock[index].clear(std::memory_order_release);
+                local_lock[index].notify_one();
+            }
+        };
+
+        class client
+        {
+        public:
+            /**
+             * @brief create our client
+             * @return
+             */
+            FC2T_FUNCTION auto get()
+            {
+                /**
+                 * @brief create object
+                 */
+                static auto obj = std::make_unique< shm >();
+
+                /**
+                 * @brief reconnect if the server went away
+                 */
+                obj->maintain();
+
+                /**
+                 * @brief get client
+                 */
+                return obj.get();
+            }
+
+            /**
+             * @brief send to universe4
+             *
+             * the request is copied into the segment once and the reply is copied out once. use `transaction` to skip both copies.
+             *
+             * @tparam t
+             * @param id
+             * @param req
+             * @return
+             */
+            template< typename t >
+            FC2T_FUNCTION auto send(const int id, t req) -> t;
+        };
+
+        /**
+         * @brief tag for requests whose payload is written field by field
+         */
+        struct no_init_t {};
+        constexpr no_init_t no_init{};
+
+        /**
+         * @brief tag for requests that should not wait if another request is in flight
+         */
+        struct try_lock_t {};
+        constexpr try_lock_t try_lock{};
+
+        /**
+         * @brief the lane a request is sent on
+         * @param id
+         * @return
+         */
+        FC2T_FUNCTION auto lane_of(const int id) -> FC2_TEAM_LANE
+        {
+            switch (id)
+            {
+            case FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_API:
+            case FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_LUA:
+            case FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_ATTACH:
+            case FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_PATTERN:
+            case FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_HTTP_REQUEST:
+            case FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_HTTP_ESCAPE:
+            case FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_HTTP_STREAM:
+            case FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_SETUP:
+                return FC2_TEAM_LANE_BULK;
+            default:
+                return FC2_TEAM_LANE_LATENCY;
+            }
+        }
+
+        /**
+         * @brief latency of every round trip, per request type. recording is a handful of relaxed atomic adds, so it is always on.
+         */
+        namespace statistics
+        {
+            constexpr int max_requests = 32;
+
+            /**
+             * @brief the histogram splits every power of two into this many buckets, so percentiles are accurate to about 25%.
+             */
+            constexpr int sub_buckets = 4;
+            constexpr int buckets = 64 * sub_buckets;
+
+            FC2T_FUNCTION auto bucket_of(const std::uint64_t ns) -> int
+            {
+                if (ns < sub_buckets)
+                {
+                    return static_cast<int>(ns);
+                }
+
+                const int top = static_cast<int>(std::bit_width(ns)) - 1;
+                return top * sub_buckets + static_cast<int>((ns >> (top - 2)) & (sub_buckets - 1));
+            }
+
+            /**
+             * @brief largest value that falls into a bucket
+             * @param bucket
+             * @return
+             */
+            FC2T_FUNCTION auto upper_bound(const int bucket) -> std::uint64_t
+            {
+                if (bucket < sub_buckets)
+                {
+                    return static_cast<std::uint64_t>(bucket);
+                }
+
+                const int top = bucket / sub_buckets;
+                const std::uint64_t sub = bucket % sub_buckets;
+                return ((sub_buckets + sub + 1) << (top - 2)) - 1;
+            }
+
+            /**
+             * @brief cpu time the calling thread used so far
+             * @return
+             */
+            FC2T_FUNCTION auto thread_cpu_time() -> std::chrono::nanoseconds
+            {
+#ifdef __linux__
+                timespec ts{};
+                clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+                return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+#else
+                FILETIME creation{}, exit{}, kernel{}, user{};
+                GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+
+                const auto ticks = (static_cast<std::uint64_t>(kernel.dwHighDateTime) << 32 | kernel.dwLowDateTime) + (static_cast<std::uint64_t>(user.dwHighDateTime) << 32 | user.dwLowDateTime);
+                return std::chrono::nanoseconds(ticks * 100);
+#endif
+            }
+
+            struct counters
+            {
+                std::atomic< std::uint64_t > failed{ 0 };
+                std::atomic< std::uint64_t > total{ 0 };
+                std::atomic< std::uint64_t > cpu{ 0 };
+                std::atomic< std::uint64_t > max{ 0 };
+                std::atomic< std::uint32_t > histogram[buckets]{};
+            };
+
+            class recorder
+            {
+            public:
+                counters requests[max_requests];
+
+                FC2T_FUNCTION auto get() -> recorder*
+                {
+                    static recorder obj;
+                    return &obj;
+                }
+
+                /**
+                 * @brief add one round trip
+                 * @param id
+                 * @param elapsed from posting the request to seeing the answer
+                 * @param cpu cpu time the client spent on it, zero if nobody was waiting for it
+                 * @param ok did the server answer in time
+                 */
+                FC2_TEAM_FORCE_INLINE void record(const int id, const std::chrono::nanoseconds elapsed, const std::chrono::nanoseconds cpu, const bool ok)
+                {
+                    if (id < 0 || id >= max_requests)
+                    {
+                        return;
+                    }
+
+                    auto& r = requests[id];
+                    const auto ns = static_cast<std::uint64_t>(std::max< std::chrono::nanoseconds::rep >(elapsed.count(), 0));
+
+                    if (!ok)
+                    {
+                        r.failed.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    r.total.fetch_add(ns, std::memory_order_relaxed);
+                    r.cpu.fetch_add(static_cast<std::uint64_t>(std::max< std::chrono::nanoseconds::rep >(cpu.count(), 0)), std::memory_order_relaxed);
+                    r.histogram[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+
+                    auto max = r.max.load(std::memory_order_relaxed);
+                    while (ns > max && !r.max.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+                    {
+                    }
+                }
+            };
+        }
+
+        /**
+         * @brief one round trip through the shared memory segment, without knowing the request type.
+         *
+         * the request buffer stays claimed for the whole lifetime of the object. `submit` blocks until the server answers, `post` and `poll` let the caller do something else in the meantime.
+         */
+        class round_trip
+        {
+        protected:
+            shm* c = nullptr;
+            std::optional< shm::access > guard;
+            shm::ownership claim{};
+            information* info = nullptr;
+            char* payload = nullptr;
+            int id = FC2_TEAM_REQUESTS_NONE;
+            FC2_TEAM_LANE lane = FC2_TEAM_LANE_LATENCY;
+            bool busy = false;
+
+            std::chrono::steady_clock::time_point deadline{};
+            std::chrono::steady_clock::time_point posted{};
+
+            /**
+             * @brief claim a request buffer and locate the payload inside it
+             * @param block wait for a buffer if another request is in flight
+             * @return
+             */
+            FC2_TEAM_FORCE_INLINE auto acquire(const bool block) -> bool
+            {
+                c = client::get();
+                guard.emplace(c);
+
+#ifdef __linux__
+                if (c->id < 0 || c->last_error != FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR)
+#else
+                if (c->shm_handle == nullptr || c->shm_handle == INVALID_HANDLE_VALUE || c->last_error != FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR)
+#endif
+                {
+                    c->last_error = FC2_TEAM_ERROR_NO_FC2_SOLUTION_OPEN;
+                    c = nullptr;
+                    return false;
+                }
+
+                claim = c->acquire(lane, block);
+                if (!claim.buffer)
+                {
+                    busy = true;
+                    c = nullptr;
+                    return false;
+                }
+
+                info = static_cast<information*>(claim.buffer);
+                payload = static_cast<char*>(claim.buffer) + offsetof(information, data);
+                return true;
+            }
+
+        public:
+            FC2_TEAM_FORCE_INLINE explicit round_trip(const int id) : id(id), lane(lane_of(id))
+            {
+                acquire(true);
+            }
+
+            FC2_TEAM_FORCE_INLINE round_trip(const int id, try_lock_t) : id(id), lane(lane_of(id))
+            {
+                acquire(false);
+            }
+
+            round_trip(const round_trip&) = delete;
+            round_trip& operator=(const round_trip&) = delete;
+
+            FC2_TEAM_FORCE_INLINE ~round_trip()
+            {
+                if (c)
+                {
+                    c->release(claim);
+                }
+            }
+
+            /**
+             * @brief false if there is no connection to the server, or if another request was in flight when using `try_lock`
+             */
+            FC2_TEAM_FORCE_INLINE explicit operator bool() const
+            {
+                return c != nullptr;
+            }
+
+            /**
+             * @brief true if `try_lock` failed because another request was in flight
+             */
+            FC2_TEAM_FORCE_INLINE auto is_busy() const -> bool
+            {
+                return busy;
+            }
+
+            /**
+             * @brief the status word the server flips once it is done
+             */
+            FC2_TEAM_FORCE_INLINE auto status_word() const -> const information*
+            {
+                return info;
+            }
+
+            /**
+             * @brief the request payload inside the segment
+             */
+            FC2_TEAM_FORCE_INLINE auto data() const -> void*
+            {
+                return payload;
+            }
+
+            /**
+             * @brief hand the request to universe4 without waiting for the answer
+             */
+            FC2_TEAM_FORCE_INLINE void post()
+            {
+                if (!c)
+                {
+                    return;
+                }
+
+                /**
+                 * @brief publish the payload before flipping the status, the server starts working as soon as it sees it pending.
+                 */
+                info->id = id;
+                std::atomic_thread_fence(std::memory_order_release);
+                *reinterpret_cast<volatile int*>(&info->status) = FC2_TEAM_STATUS::FC2_TEAM_SERVER_PENDING;
+
+                posted = std::chrono::steady_clock::now();
+                deadline = posted + std::chrono::seconds(id == FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_API || id == FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_HTTP_REQUEST || id == FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_HTTP_STREAM ? FC2_TEAM_REQUESTS_API_TIMEOUT : FC2_TEAM_REQUESTS_TIMEOUT);
+            }
+
+            /**
+             * @brief same as `post`, but give up earlier than usual
+             * @param until
+             */
+            FC2_TEAM_FORCE_INLINE void post(const std::chrono::steady_clock::time_point until)
+            {
+                post();
+                deadline = std::min(deadline, until);
+            }
+
+            /**
+             * @brief check on a posted request without blocking
+             * @return FC2_TEAM_SERVER_PENDING while the server is still working on it
+             */
+            FC2_TEAM_FORCE_INLINE auto poll() -> FC2_TEAM_STATUS
+            {
+                if (!c)
+                {
+                    return FC2_TEAM_STATUS::FC2_TEAM_SERVER_TIMEOUT;
+                }
+
+                const auto status = static_cast<FC2_TEAM_STATUS>(wait::status(info));
+                if (status != FC2_TEAM_STATUS::FC2_TEAM_SERVER_PENDING)
+                {
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    statistics::recorder::get()->record(id, std::chrono::steady_clock::now() - posted, {}, true);
+
+                    /**
+                     * @brief reset last error
+                     */
+                    if (status == FC2_TEAM_STATUS::FC2_TEAM_SERVER_DONE)
+                    {
+                        c->last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR;
+                    }
+
+                    return status;
+                }
+
+                if (const auto now = std::chrono::steady_clock::now(); now >= deadline)
+                {
+                    info->status = FC2_TEAM_STATUS::FC2_TEAM_SERVER_TIMEOUT;
+                    c->last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_FC2_SOLUTION_OPEN;
+                    statistics::recorder::get()->record(id, now - posted, {}, false);
+                    return FC2_TEAM_STATUS::FC2_TEAM_SERVER_TIMEOUT;
+                }
+
+                return FC2_TEAM_STATUS::FC2_TEAM_SERVER_PENDING;
+            }
+
+            /**
+             * @brief hand the request to universe4 and wait for the answer
+             * @return true if the server answered in time
+             */
+            FC2_TEAM_FORCE_INLINE auto submit() -> bool
+            {
+                if (!c)
+                {
+                    return false;
+                }
+
+                const auto cpu = statistics::thread_cpu_time();
+                post();
+
+                /**
+                 * @brief wait until completed
+                 */
+                const bool done = detail::wait::until_done(info, deadline);
+                statistics::recorder::get()->record(id, std::chrono::steady_clock::now() - posted, statistics::thread_cpu_time() - cpu, done);
+
+                if (!done)
+                {
+                    info->status = FC2_TEAM_STATUS::FC2_TEAM_SERVER_TIMEOUT;
+                    c->last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_FC2_SOLUTION_OPEN;
+                    return false;
+                }
+
+                /**
+                 * @brief reset last error
+                 */
+                if (info->status == FC2_TEAM_STATUS::FC2_TEAM_SERVER_DONE)
+                {
+                    c->last_error = FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR;
+                }
+
+                return true;
+            }
+        };
+
+        /**
+         * @brief a request that is built and read directly inside the shared memory segment.
+         *
+         * the reference handed out is only valid until the object is destroyed.
+         *
+         * @code
+         *
+         * detail::transaction< detail::requests::read_memory > tx(FC2_TEAM_REQUESTS_READ_MEMORY);
+         * if (tx)
+         * {
+         *      tx->address = address;
+         *      tx->size = sizeof(t);
+         *
+         *      if (tx.submit())
+         *          use(tx->data);
+         * }
+         *
+         * @endcode
+         *
+         * @tparam t
+         */
+        template< typename t >
+        class transaction : public round_trip
+        {
+            static_assert(std::is_trivially_copyable_v< t >, "requests are copied between processes as raw bytes");
+            static_assert(offsetof(information, data) + sizeof(t) <= FC2_TEAM_BUFFER_SIZE, "request does not fit into the shared memory segment");
+
+        public:
+            /**
+             * @brief start a request with a value-initialized payload
+             * @param id
+             */
+            FC2_TEAM_FORCE_INLINE explicit transaction(const int id) : round_trip(id)
+            {
+                if (c)
+                {
+                    new (payload) t{};
+                }
+            }
+
+            /**
+             * @brief start a request without touching the payload. for large requests where only a small header is filled in.
+             * @param id
+             */
+            FC2_TEAM_FORCE_INLINE transaction(const int id, no_init_t) : round_trip(id)
+            {
+            }
+
+            /**
+             * @brief start a request with a copy of an existing payload
+             * @param id
+             * @param req
+             */
+            FC2_TEAM_FORCE_INLINE transaction(const int id, const t& req) : round_trip(id)
+            {
+                if (c)
+                {
+                    memcpy(static_cast<void*>(payload), static_cast<const void*>(&req), sizeof(t));
+                }
+            }
+
+            FC2_TEAM_FORCE_INLINE auto operator*() const -> t&
+            {
+                return *reinterpret_cast<t*>(payload);
+            }
+
+            FC2_TEAM_FORCE_INLINE auto operator->() const -> t*
+            {
+                return reinterpret_cast<t*>(payload);
+            }
+        };
+
+        template< typename t >
+        FC2_TEAM_FORCE_INLINE auto client::send(const int id, t req) -> t
+        {
+            transaction< t > tx(id, req);
+
+            /**
+             * @brief did something break
+             */
+            if (!tx)
+            {
+                return req;
+            }
+
+            tx.submit();
+
+            /**
+             * @brief return data
+             */
+            memcpy(static_cast<void*>(&req), static_cast<const void*>(&*tx), sizeof(t));
+            return req;
+        }
+
+        namespace extension
+        {
+            /**
+             * @brief copy the latest complete frame out of the drawing feed. this never takes the client lock and never wakes the server.
+             * @param output
+             * @return false if the server has no (live) feed, or if it has more drawing requests than a frame holds. use the request path instead.
+             */
+            FC2T_FUNCTION auto read_drawing(std::vector< requests::draw::detail >& output) -> bool
+            {
+                auto c = client::get();
+                if (c->last_error != FC2_TEAM_ERROR_CODES::FC2_TEAM_ERROR_NO_ERROR)
+                {
+                    return false;
+                }
+
+                shm::access guard(c);
+                const auto feed = c->region< const drawing_feed >(FC2_TEAM_EXTENSION_DRAWING_FEED);
+                if (!feed)
+                {
+                    return false;
+                }
+
+                /**
+                 * @brief the producer only gets in the way if it laps us twice, a handful of tries is plenty
+                 */
+                for (int attempt = 0; attempt < 8; ++attempt)
+                {
+                    const auto latest = *reinterpret_cast<const volatile std::uint32_t*>(&feed->latest) % 3;
+                    const auto& frame = feed->frames[latest];
+
+                    const auto sequence = *reinterpret_cast<const volatile std::uint32_t*>(&frame.sequence);
+                    if (sequence & 1)
+                    {
+                        wait::relax();
+                        continue;
+                    }
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+
+                    const auto total = frame.count;
+                    const auto count = std::min< std::size_t >(total, std::size(frame.details));
+                    const auto number = frame.number;
+                    output.resize(count);
+                    memcpy(static_cast<void*>(output.data()), frame.details, count * sizeof(requests::draw::detail));
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (*reinterpret_cast<const volatile std::uint32_t*>(&frame.sequence) != sequence)
+                    {
+                        continue;
+                    }
+
+                    /**
+                     * @brief a producer that stopped publishing is most likely gone. fall back to a request so the error gets noticed.
+                     */
+                    const auto now = std::chrono::steady_clock::now();
+                    if (number != c->feed_number)
+                    {
+                        c->feed_number = number;
+                        c->feed_seen = now;
+                    }
+                    else if (now - c->feed_seen > std::chrono::seconds(FC2_TEAM_REQUESTS_TIMEOUT))
+                    {
+                        return false;
+                    }
+
+                    /**
+                     * @brief the frame only holds the first 100 of them
+                     */
+                    return total <= std::size(frame.details);
+                }
+
+                return false;
+            }
+
+            /**
+             * @brief pull every chunk of a chunked stream request
+             *
+             * every chunk is a separate round trip, the server's snapshot may expire in between. in that case it answers with a new frame id and offset 0, and the stream is restarted a few times before giving up.
+             *
+             * @tparam t request with frame, offset, total and count fields
+             * @tparam element
+             * @tparam n
+             * @param id
+             * @param items the request's chunk array
+             * @param output
+             * @param prepare called with every request before it is sent, to fill in request specific fields
+             * @param received called with every answer
+             * @return false if the server stopped answering
+             */
+            template< typename t, typename element, std::size_t n, typename prepare_t, typename received_t >
+            FC2T_FUNCTION auto read_chunks(const int id, element(t::* items)[n], std::vector< element >& output, prepare_t&& prepare, received_t&& received) -> bool
+            {
+                output.clear();
+
+                std::uint32_t frame = 0;
+                std::uint32_t offset = 0;
+
+                for (int restarts = 0, answers = 0; restarts < 4; ++answers)
+                {
+                    transaction< t > tx(id, no_init);
+                    if (!tx)
+                    {
+                        return false;
+                    }
+
+                    tx->frame = frame;
+                    tx->offset = offset;
+                    tx->total = 0;
+                    tx->count = 0;
+                    prepare(*tx);
+
+                    if (!tx.submit())
+                    {
+                        return false;
+                    }
+
+                    received(std::as_const(*tx));
+
+                    /**
+                     * @brief new snapshot, start over. the first answer only tells us the frame, every later one counts, even one that goes back to frame 0.
+                     */
+                    if (tx->frame != frame || tx->offset != offset)
+                    {
+                        if (answers != 0)
+                        {
+                            ++restarts;
+                        }
+
+                        frame = tx->frame;
+                        offset = 0;
+                        output.clear();
+
+                        if (tx->offset != 0)
+                        {
+                            continue;
+                        }
+                    }
+
+                    const auto& chunk = (*tx).*items;
+                    const auto count = std::min< std::size_t >(tx->count, n);
+                    output.insert(output.end(), chunk, chunk + count);
+                    offset += static_cast<std::uint32_t>(count);
+
+                    if (offset >= tx->total || count == 0)
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            template< typename t, typename element, std::size_t n >
+            FC2T_FUNCTION auto read_chunks(const int id, element(t::* items)[n], std::vector< element >& output) -> bool
+            {
+                return read_chunks(id, items, output, [](t&) {}, [](const t&) {});
+            }
+
+            /**
+             * @brief pull every chunk of the current drawing stream
+             * @param output
+             * @return false if the server doesn't support the stream or stopped answering
+             */
+            FC2T_FUNCTION auto read_drawing_stream(std::vector< requests::draw::detail >& output) -> bool
+            {
+                if (!client::get()->supports(FC2_TEAM_EXTENSION_DRAWING_STREAM))
+                {
+                    return false;
+                }
+
+                return read_chunks(FC2_TEAM_REQUESTS_GET_DRAWING_STREAM, &requests::draw_stream::details, output);
+            }
+
+            /**
+             * @brief pull the current drawing requests in the compact encoding and decode them
+             * @param output
+             * @return false if the server doesn't support the compact encoding or stopped answering
+             */
+            FC2T_FUNCTION auto read_drawing_compact(std::vector< requests::draw::detail >& output) -> bool
+            {
+                if (!client::get()->supports(FC2_TEAM_EXTENSION_DRAWING_COMPACT))
+                {
+                    return false;
+                }
+
+                /**
+                 * @brief reused between frames so the encoded bytes don't allocate every time
+                 */
+                thread_local std::vector< std::uint8_t > encoded;
+                if (!read_chunks(FC2_TEAM_REQUESTS_GET_DRAWING_COMPACT, &requests::draw_compact::data, encoded))
+                {
+                    return false;
+                }
+
+                return compact::decode(encoded.data(), encoded.size(), output);
+            }
+        }
+
+        namespace helper
+        {
+            /**
+             * @brief safely copy values
+             * @param dest
+             * @param src
+             * @param size
+             */
+            FC2T_FUNCTION void safe_copy(char* dest, const char* src, const std::size_t size)
+            {
+                /**
+                 * @brief prevent exceeding in length
+                 */
+                std::size_t l = strlen(src) + 1;
+                l = std::min(l, size);
+
+                /**
+                 * @brief cpy
+                 */
+                memcpy(dest, src, l);
+
+                /**
+                 * @brief null-terminator
+                 */
+                dest[l - 1] = '\0';
+            }
+
+            FC2T_FUNCTION void safe_copy(char* dest, const std::string& src, const std::size_t size)
+            {
+                safe_copy(dest, src.c_str(), size);
+            }
+
+            /**
+             * @brief 64-bit FNV-1a
+             * @param data
+             * @param size
+             * @param seed previous hash to continue from
+             */
+            FC2T_FUNCTION auto hash(const void* data, const std::size_t size, std::uint64_t seed = 0xcbf29ce484222325ULL) -> std::uint64_t
+            {
+                const auto bytes = static_cast<const unsigned char*>(data);
+                for (std::size_t i = 0; i < size; i++)
+                {
+                    seed = (seed ^ bytes[i]) * 0x100000001b3ULL;
+                }
+
+                return seed;
+            }
+
+            /**
+             * @brief directory of the running executable, empty if unknown
+             */
+            FC2T_FUNCTION auto executable_directory() -> std::filesystem::path
+            {
+                std::error_code error;
+#ifdef _WIN32
+                std::wstring buffer(32768, L'\0');
+                const auto length = GetModuleFileNameW(nullptr, buffer.data(), static_cast<DWORD>(buffer.size()));
+                if (!length || length >= buffer.size())
+                {
+                    return {};
+                }
+
+                buffer.resize(length);
+                const std::filesystem::path executable(buffer);
+#else
+                const auto executable = std::filesystem::read_symlink("/proc/self/exe", error);
+                if (error)
+                {
+                    return {};
+                }
+#endif
+                return executable.parent_path();
+            }
+        }
+
+        namespace async
+        {
+            /**
+             * @brief one queued request of the reactor. `prepare` writes the request into the segment, `read` copies the answer out of it.
+             */
+            class operation
+            {
+                std::mutex m;
+                bool done = false;
+
+#ifdef FC2_TEAM_COROUTINES
+                std::coroutine_handle<> waiter{};
+#endif
+
+            protected:
+                virtual void read(const void* payload) = 0;
+
+            public:
+                const int id;
+                const std::chrono::steady_clock::time_point deadline;
+
+                std::atomic< bool > cancelled{ false };
+
+                FC2_TEAM_FORCE_INLINE explicit operation(const int id, const std::chrono::steady_clock::duration timeout) : id(id), deadline(std::chrono::steady_clock::now() + timeout)
+                {
+                }
+
+                virtual ~operation() = default;
+
+                virtual void prepare(void* payload) = 0;
+
+                /**
+                 * @brief copy the answer out of the segment while it is still locked
+                 * @param payload
+                 */
+                FC2_TEAM_FORCE_INLINE void store(const void* payload)
+                {
+                    if (!cancelled)
+                    {
+                        read(payload);
+                    }
+                }
+
+                /**
+                 * @brief mark the operation as done and wake whoever is waiting on it
+                 */
+                FC2_TEAM_FORCE_INLINE void finish()
+                {
+#ifdef FC2_TEAM_COROUTINES
+                    std::coroutine_handle<> resume{};
+#endif
+                    {
+                        std::lock_guard< std::mutex > guard(m);
+                        done = true;
+#ifdef FC2_TEAM_COROUTINES
+                        std::swap(resume, waiter);
+#endif
+                    }
+
+#ifdef FC2_TEAM_COROUTINES
+                    if (resume)
+                    {
+                        resume.resume();
+                    }
+#endif
+                }
+
+                FC2_TEAM_FORCE_INLINE auto is_done() -> bool
+                {
+                    std::lock_guard< std::mutex > guard(m);
+                    return done;
+                }
+
+#ifdef FC2_TEAM_COROUTINES
+                /**
+                 * @brief park a coroutine until the operation finishes
+                 * @return false if it already finished and the coroutine should just continue
+                 */
+                FC2_TEAM_FORCE_INLINE auto suspend(const std::coroutine_handle<> handle) -> bool
+                {
+                    std::lock_guard< std::mutex > guard(m);
+                    if (done)
+                    {
+                        return false;
+                    }
+
+                    waiter = handle;
+                    return true;
+                }
+#endif
+            };
+
+            /**
+             * @brief operation built from two callables, keeping the result next to it. `read` may return `r` or `std::optional< r >`.
+             * @tparam r result type
+             */
+            template< typename r, typename prepare_t, typename read_t >
+            class basic_operation final : public operation
+            {
+                prepare_t prepare_fn;
+                read_t read_fn;
+
+            protected:
+                void read(const void* payload) override
+                {
+                    result = read_fn(payload);
+                }
+
+            public:
+                std::optional< r > result;
+
+                FC2_TEAM_FORCE_INLINE basic_operation(const int id, const std::chrono::steady_clock::duration timeout, prepare_t prepare, read_t read) : operation(id, timeout), prepare_fn(std::move(prepare)), read_fn(std::move(read))
+                {
+                }
+
+                void prepare(void* payload) override
+                {
+                    prepare_fn(payload);
+                }
+            };
+
+            /**
+             * @brief drives queued operations through the segment without ever blocking on the server. one operation is in flight per lane, operations on the same lane are sent in the order they were queued.
+             *
+             * a lane stays locked while an operation is in flight on it. blocking calls from other threads simply wait for it, blocking calls on the same lane from the thread that calls `poll` would wait forever.
+             * none of what an operation holds in between belongs to a thread, so `poll` may be called from whichever thread is free.
+             */
+            class reactor
+            {
+                std::mutex m;
+                std::deque< std::shared_ptr< operation > > queue;
+                std::shared_ptr< operation > active[FC2_TEAM_LANE_COUNT];
+                std::optional< round_trip > trip[FC2_TEAM_LANE_COUNT];
+
+            public:
+                FC2T_FUNCTION auto get() -> reactor*
+                {
+                    static reactor obj;
+                    return &obj;
+                }
+
+                FC2_TEAM_FORCE_INLINE void push(std::shared_ptr< operation > op)
+                {
+                    std::lock_guard< std::mutex > guard(m);
+                    queue.push_back(std::move(op));
+                }
+
+                /**
+                 * @brief advance the operation in flight and start the next one. never waits for the server.
+                 * @return true if there is still work left
+                 */
+                FC2_TEAM_FORCE_INLINE auto poll() -> bool
+                {
+                    /**
+                     * @brief answers are copied out under the lock, but waiters only run once it is released so they can queue new work
+                     */
+                    std::vector< std::shared_ptr< operation > > finished;
+                    bool pending;
+                    {
+                        std::lock_guard< std::mutex > guard(m);
+
+                        for (int lane = 0; lane < FC2_TEAM_LANE_COUNT; ++lane)
+                        {
+                            if (!active[lane])
+                            {
+                                continue;
+                            }
+
+                            /**
+                             * @brief a cancelled request still owns its lane until the server is done with it
+                             */
+                            const auto status = trip[lane]->poll();
+                            if (status != FC2_TEAM_STATUS::FC2_TEAM_SERVER_PENDING)
+                            {
+                                if (status == FC2_TEAM_STATUS::FC2_TEAM_SERVER_DONE)
+                                {
+                                    active[lane]->store(trip[lane]->data());
+                                }
+
+                                finished.push_back(std::move(active[lane]));
+                                trip[lane].reset();
+                            }
+                        }
+
+                        /**
+                         * @brief drop what was cancelled or waited too long for its turn
+                         */
+                        const auto now = std::chrono::steady_clock::now();
+                        for (auto it = queue.begin(); it != queue.end();)
+                        {
+                            if ((*it)->cancelled || now >= (*it)->deadline)
+                            {
+                                finished.push_back(std::move(*it));
+                                it = queue.erase(it);
+                            }
+                            else
+                            {
+                                ++it;
+                            }
+                        }
+
+                        /**
+                         * @brief start the oldest operation of every idle lane
+                         */
+                        bool waiting[FC2_TEAM_LANE_COUNT] = {};
+                        for (auto it = queue.begin(); it != queue.end();)
+                        {
+                            const auto lane = lane_of((*it)->id);
+                            if (active[lane] || waiting[lane])
+                            {
+                                ++it;
+                                continue;
+                            }
+
+                            trip[lane].emplace((*it)->id, try_lock);
+                            if (*trip[lane])
+                            {
+                                active[lane] = std::move(*it);
+                                it = queue.erase(it);
+
+                                active[lane]->prepare(trip[lane]->data());
+                                trip[lane]->post(active[lane]->deadline);
+                            }
+                            else if (!trip[lane]->is_busy())
+                            {
+                                /**
+                                 * @brief no connection, nothing queued can succeed
+                                 */
+                                trip[lane].reset();
+                                for (auto& op : queue)
+                                {
+                                    finished.push_back(std::move(op));
+                                }
+
+                                queue.clear();
+                                break;
+                            }
+                            else
+                            {
+                                /**
+                                 * @brief someone else is using the lane, try again on the next poll
+                                 */
+                                trip[lane].reset();
+                                waiting[lane] = true;
+                                ++it;
+                            }
+                        }
+
+                        pending = !queue.empty();
+                        for (const auto& op : active)
+                        {
+                            pending |= op != nullptr;
+                        }
+                    }
+
+                    for (const auto& op : finished)
+                    {
+                        op->finish();
+                    }
+
+                    return pending;
+                }
+
+                /**
+                 * @brief sleep until a request in flight is answered, for at most the given duration
+                 * @param duration
+                 */
+                FC2_TEAM_FORCE_INLINE void idle(const std::chrono::microseconds duration)
+                {
+                    /**
+                     * @brief the latency lane is the one worth waking up for
+                     */
+                    const information* info = nullptr;
+                    {
+                        std::lock_guard< std::mutex > guard(m);
+                        for (int lane = 0; lane < FC2_TEAM_LANE_COUNT && !info; ++lane)
+                        {
+                            if (active[lane])
+                            {
+                                info = trip[lane]->status_word();
+                            }
+                        }
+                    }
+
+                    /**
+                     * @brief the segment outlives the request, so the status word can be waited on without the lock
+                     */
+                    if (info)
+                    {
+                        wait::block(info, duration);
+                    }
+                    else
+                    {
+                        std::this_thread::sleep_for(duration);
+                    }
+                }
+            };
+
+            /**
+             * @brief queue a request with the reactor
+             * @tparam r result type
+             * @param id
+             * @param timeout how long the request may take, including waiting for its turn
+             * @param prepare writes the request into the segment
+             * @param read turns the answer into the result
+             * @return
+             */
+            template< typename r, typename prepare_t, typename read_t >
+            FC2T_FUNCTION auto make(const int id, const std::chrono::steady_clock::duration timeout, prepare_t prepare, read_t read)
+            {
+                auto op = std::make_shared< basic_operation< r, prepare_t, read_t > >(id, timeout, std::move(prepare), std::move(read));
+                reactor::get()->push(op);
+                return op;
+            }
+
+            /**
+             * @brief an operation that is done before it was ever queued
+             * @tparam r
+             * @param value
+             * @return
+             */
+            template< typename r >
+            FC2T_FUNCTION auto make_ready(r value)
+            {
+                const auto none = [](void*) {};
+                const auto fail = [](const void*) -> r { return r{}; };
+
+                auto op = std::make_shared< basic_operation< r, decltype(none), decltype(fail) > >(FC2_TEAM_REQUESTS_NONE, std::chrono::steady_clock::duration::zero(), none, fail);
+                op->result = std::move(value);
+                op->finish();
+                return op;
+            }
+
+            /**
+             * @brief timeout used by the blocking version of a request
+             * @param id
+             * @return
+             */
+            FC2T_FUNCTION auto default_timeout(const int id) -> std::chrono::steady_clock::duration
+            {
+                return std::chrono::seconds(id == FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_API || id == FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_HTTP_REQUEST || id == FC2_TEAM_REQUESTS::FC2_TEAM_REQUESTS_HTTP_STREAM ? FC2_TEAM_REQUESTS_API_TIMEOUT : FC2_TEAM_REQUESTS_TIMEOUT);
+            }
+        }
+
+        namespace stream
+        {
+            /**
+             * @brief pull a whole api or http response through FC2_TEAM_REQUESTS_HTTP_STREAM. the request buffer stays claimed until the last chunk arrived.
+             * @param source FC2_TEAM_REQUESTS_API or FC2_TEAM_REQUESTS_HTTP_REQUEST
+             * @param url
+             * @param post
+             * @param sink called with every chunk, in order
+             * @return false if the request failed or the stream broke off. `sink` may have seen part of the response.
+             */
+            template< typename sink_t >
+            FC2T_FUNCTION auto receive(const int source, const std::string& url, const std::string& post, sink_t&& sink) -> bool
+            {
+                transaction< requests::http_stream > tx(FC2_TEAM_REQUESTS_HTTP_STREAM, no_init);
+                if (!tx)
+                {
+                    return false;
+                }
+
+                tx->source = static_cast<std::uint32_t>(source);
+                tx->stream = 0;
+                helper::safe_copy(tx->url, url, sizeof tx->url);
+                helper::safe_copy(tx->post, post, sizeof tx->post);
+
+                std::uint64_t received = 0;
+                for (;;)
+                {
+                    tx->offset = received;
+                    tx->total = 0;
+                    tx->size = 0;
+                    tx->end = false;
+                    tx->failed = false;
+
+                    if (!tx.submit() || tx->failed)
+                    {
+                        return false;
+                    }
+
+                    /**
+                     * @brief the server lost the stream and started somewhere else
+                     */
+                    if (tx->offset != received || tx->size > sizeof tx->data)
+                    {
+                        return false;
+                    }
+
+                    if (tx->size)
+                    {
+                        sink(static_cast<const char*>(tx->data), static_cast<std::size_t>(tx->size));
+                        received += tx->size;
+                    }
+
+                    if (tx->end)
+                    {
+                        return true;
+                    }
+
+                    /**
+                     * @brief an empty chunk that isn't the end would never finish
+                     */
+                    if (!tx->size)
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            /**
+             * @brief collect a whole response into a string
+             * @return nothing if the request failed or the stream broke off. the single buffer requests return an empty string then, with no way to tell it from an empty response.
+             */
+            FC2T_FUNCTION auto collect(const int source, const std::string& url, const std::string& post) -> std::optional< std::string >
+            {
+                std::string output;
+                const auto ok = receive(source, url, post, [&output](const char* data, const std::size_t size)
+                    {
+                        output.append(data, size);
+                    });
+
+                if (!ok)
+                {
+                    return std::nullopt;
+                }
+
+                return output;
+            }
+        }
+
+        /**
+         * @brief in-process cache of `api` and `http::get` responses
+         *
+         * entries are keyed by request type and url. every caller passes how old a response may be, so the same url can be polled with different max ages. a request that is already in flight is shared with everyone asking for the same url meanwhile.
+         */
+        class responses
+        {
+            struct entry
+            {
+                std::shared_future< std::string > response;
+                std::chrono::steady_clock::time_point fetched;
+                bool ready = false;
+                std::size_t bytes = 0;
+                std::list< std::string >::iterator recent;
+            };
+
+            std::mutex mutex;
+            std::unordered_map< std::string, entry > entries;
+
+            /**
+             * @brief most recently used first
+             */
+            std::list< std::string > recent;
+            std::size_t bytes = 0;
+
+            FC2_TEAM_FORCE_INLINE void erase(const std::unordered_map< std::string, entry >::iterator it)
+            {
+                bytes -= it->second.bytes;
+                recent.erase(it->second.recent);
+                entries.erase(it);
+            }
+
+        public:
+            std::atomic< std::uint64_t > hits{ 0 };
+            std::atomic< std::uint64_t > misses{ 0 };
+            std::atomic< std::uint64_t > coalesced{ 0 };
+
+            FC2T_FUNCTION auto get() -> responses*
+            {
+                static responses obj;
+                return &obj;
+            }
+
+            /**
+             * @brief answer from the cache or perform the request once
+             * @param id FC2_TEAM_REQUESTS_API or FC2_TEAM_REQUESTS_HTTP_REQUEST
+             * @param url
+             * @param max_age
+             * @param fetch performs the request, returns the response and whether it succeeded
+             * @return
+             */
+            template< typename fetch_t >
+            FC2_TEAM_FORCE_INLINE auto request(const int id, const std::string& url, const std::chrono::steady_clock::duration max_age, fetch_t&& fetch) -> std::string
+            {
+                auto key = std::to_string(id) + ':' + url;
+
+                std::promise< std::string > promise;
+                {
+                    std::unique_lock lock(mutex);
+
+                    if (const auto it = entries.find(key); it != entries.end())
+                    {
+                        if (!it->second.ready)
+                        {
+                            coalesced.fetch_add(1, std::memory_order_relaxed);
+
+                            auto response = it->second.response;
+                            lock.unlock();
+                            return response.get();
+                        }
+
+                        if (std::chrono::steady_clock::now() - it->second.fetched < max_age)
+                        {
+                            hits.fetch_add(1, std::memory_order_relaxed);
+                            recent.splice(recent.begin(), recent, it->second.recent);
+                            return it->second.response.get();
+                        }
+
+                        erase(it);
+                    }
+
+                    misses.fetch_add(1, std::memory_order_relaxed);
+
+                    recent.push_front(key);
+
+                    entry e;
+                    e.response = promise.get_future().share();
+                    e.recent = recent.begin();
+                    entries.emplace(key, std::move(e));
+                }
+
+                /**
+                 * @brief the request itself runs without the lock, it may take up to FC2_TEAM_REQUESTS_API_TIMEOUT
+                 */
+                std::string response;
+                bool ok = false;
+                try
+                {
+                    std::tie(response, ok) = fetch();
+                }
+                catch (...)
+                {
+                    /**
+                     * @brief requests that waited for this one get the same exception, the next one tries again
+                     */
+                    {
+                        std::lock_guard lock(mutex);
+                        if (const auto it = entries.find(key); it != entries.end())
+                        {
+                            erase(it);
+                        }
+                    }
+
+                    promise.set_exception(std::current_exception());
+                    throw;
+                }
+
+                promise.set_value(response);
+
+                std::lock_guard lock(mutex);
+
+                const auto it = entries.find(key);
+                if (it == entries.end())
+                {
+                    return response;
+                }
+
+                /**
+                 * @brief failures are only shared with the requests that waited for them
+                 */
+                if (!ok || response.size() > FC2_TEAM_RESPONSE_CACHE_BYTES)
+                {
+                    erase(it);
+                    return response;
+                }
+
+                it->second.ready = true;
+                it->second.fetched = std::chrono::steady_clock::now();
+                it->second.bytes = key.size() + response.size();
+                bytes += it->second.bytes;
+
+                while (bytes > FC2_TEAM_RESPONSE_CACHE_BYTES && !recent.empty())
+                {
+                    const auto victim = entries.find(recent.back());
+
+                    /**
+                     * @brief requests in flight don't count towards the size yet
+                     */
+                    if (!victim->second.ready)
+                    {
+                        recent.splice(recent.begin(), recent, victim->second.recent);
+                        continue;
+                    }
+
+                    erase(victim);
+                }
+
+                return response;
+            }
+
+            FC2_TEAM_FORCE_INLINE void clear()
+            {
+                std::lock_guard lock(mutex);
+
+                /**
+                 * @brief requests in flight stay, their callers still wait for them
+                 */
+                std::erase_if(entries, [this](const auto& e)
+                    {
+                        if (!e.second.ready)
+                        {
+                            return false;
+                        }
+
+                        bytes -= e.second.bytes;
+                        recent.erase(e.second.recent);
+                        return true;
+                    });
+            }
+        };
+    } // end detail
+
+    /**
+     * @brief round trip latency per request type, measured in this process
+     *
+     * @code
+     *
+     * const auto draw = fc2::stats::get( FC2_TEAM_REQUESTS_GET_DRAWING );
+     * printf( "%llu requests, p99 %lld ns\n", draw.count, draw.p99.count() );
+     *
+     * @endcode
+     */
+    namespace stats
+    {
+        struct summary
+        {
+            std::uint64_t count = 0;
+
+            /**
+             * @brief requests the server didn't answer in time. they are included in every other number.
+             */
+            std::uint64_t failed = 0;
+
+            std::chrono::nanoseconds total{};
+            std::chrono::nanoseconds mean{};
+
+            /**
+             * @brief cpu time spent by the waiting thread. requests sent through `fc2::async` don't count towards it.
+             */
+            std::chrono::nanoseconds cpu{};
+
+            std::chrono::nanoseconds p50{};
+            std::chrono::nanoseconds p99{};
+            std::chrono::nanoseconds p999{};
+            std::chrono::nanoseconds max{};
+        };
+
+        /**
+         * @brief summarize every round trip of one request type so far
+         * @param id
+         * @return
+         */
+        FC2T_FUNCTION auto get(const int id) -> summary
+        {
+            summary output;
+            if (id < 0 || id >= detail::statistics::max_requests)
+            {
+                return output;
+            }
+
+            const auto& r = detail::statistics::recorder::get()->requests[id];
+
+            /**
+             * @brief the histogram is the source of truth for the count, so percentiles always add up even while requests are recorded
+             */
+            std::uint32_t histogram[detail::statistics::buckets];
+            std::uint64_t count = 0;
+            for (int i = 0; i < detail::statistics::buckets; ++i)
+            {
+                histogram[i] = r.histogram[i].load(std::memory_order_relaxed);
+                count += histogram[i];
+            }
+
+            if (!count)
+            {
+                return output;
+            }
+
+            output.count = count;
+            output.failed = r.failed.load(std::memory_order_relaxed);
+            output.total = std::chrono::nanoseconds(r.total.load(std::memory_order_relaxed));
+            output.mean = output.total / count;
+            output.cpu = std::chrono::nanoseconds(r.cpu.load(std::memory_order_relaxed));
+            output.max = std::chrono::nanoseconds(r.max.load(std::memory_order_relaxed));
+
+            const auto percentile = [&](const double q)
+                {
+                    const auto rank = std::max< std::uint64_t >(1, static_cast<std::uint64_t>(q * static_cast<double>(count) + 0.999999));
+
+                    std::uint64_t seen = 0;
+                    for (int i = 0; i < detail::statistics::buckets; ++i)
+                    {
+                        seen += histogram[i];
+                        if (seen >= rank)
+                        {
+                            return std::min(std::chrono::nanoseconds(detail::statistics::upper_bound(i)), output.max);
+                        }
+                    }
+
+                    return output.max;
+                };
+
+            output.p50 = percentile(0.5);
+            output.p99 = percentile(0.99);
+            output.p999 = percentile(0.999);
+            return output;
+        }
+
+        /**
+         * @brief forget everything recorded so far
+         */
+        FC2T_FUNCTION auto reset() -> void
+        {
+            for (auto& r : detail::statistics::recorder::get()->requests)
+            {
+                r.failed = 0;
+                r.total = 0;
+                r.cpu = 0;
+                r.max = 0;
+
+                for (auto& bucket : r.histogram)
+                {
+                    bucket = 0;
+                }
+            }
+        }
+
+        /**
+         * @brief readable name of a request type
+         * @param id
+         * @return
+         */
+        FC2T_FUNCTION auto name(const int id) -> const char*
+        {
+            switch (id)
+            {
+            case FC2_TEAM_REQUESTS_PING: return "ping";
+            case FC2_TEAM_REQUESTS_API: return "api";
+            case FC2_TEAM_REQUESTS_LUA: return "lua";
+            case FC2_TEAM_REQUESTS_ATTACH: return "attach";
+            case FC2_TEAM_REQUESTS_GET_MODULE: return "get_module";
+            case FC2_TEAM_REQUESTS_PATTERN: return "pattern";
+            case FC2_TEAM_REQUESTS_READ_MEMORY: return "read_memory";
+            case FC2_TEAM_REQUESTS_CALL: return "call";
+            case FC2_TEAM_REQUESTS_HTTP_REQUEST: return "http";
+            case FC2_TEAM_REQUESTS_HTTP_ESCAPE: return "http_escape";
+            case FC2_TEAM_REQUESTS_SETUP: return "setup";
+            case FC2_TEAM_REQUESTS_INPUT: return "input";
+            case FC2_TEAM_REQUESTS_GET_DRAWING: return "get_drawing";
+            case FC2_TEAM_REQUESTS_SESSION: return "session";
+            case FC2_TEAM_REQUESTS_DRAW: return "draw";
+            case FC2_TEAM_REQUESTS_GET_DRAWING_STREAM: return "get_drawing_stream";
+            case FC2_TEAM_REQUESTS_GET_DRAWING_COMPACT: return "get_drawing_compact";
+            case FC2_TEAM_REQUESTS_GET_DRAWING_DELTA: return "get_drawing_delta";
+            case FC2_TEAM_REQUESTS_CALL_MANY: return "call_many";
+            case FC2_TEAM_REQUESTS_DRAW_BATCH: return "draw_batch";
+            case FC2_TEAM_REQUESTS_READ_MEMORY_MANY: return "read_memory_many";
+            case FC2_TEAM_REQUESTS_HTTP_STREAM: return "http_stream";
+            default: return "unknown";
+            }
+        }
+    }
+
+    /**
+     * @brief non-blocking requests. they are queued and sent one after another by `poll`, which never waits for the server. call it once per frame, or use `get` on a request to wait for it.
+     *
+     * @code
+     *
+     * auto name = fc2::async::call< std::string >( "directx_overlay_window_name", FC2_LUA_TYPE_STRING );
+     *
+     * while ( !name.ready() )
+     * {
+     *      fc2::async::poll();
+     *      do_other_work();
+     * }
+     *
+     * if ( auto value = name.get() )
+     *      use( *value );
+     *
+     * @endcode
+     *
+     * inside a coroutine a request can also be awaited with `co_await`. the coroutine is resumed from `poll`.
+     */
+    namespace async
+    {
+        /**
+         * @brief advance queued requests. never waits for the server.
+         * @return true if requests are still queued or in flight
+         */
+        FC2T_FUNCTION auto poll() -> bool
+        {
+            return detail::async::reactor::get()->poll();
+        }
+
+        /**
+         * @brief handle to a queued request
+         * @tparam r result type. the result is empty if the request failed, timed out or was cancelled.
+         */
+        template< typename r >
+        class request
+        {
+            using operation = detail::async::operation;
+
+            std::shared_ptr< operation > op;
+            const std::optional< r >* result = nullptr;
+
+        public:
+            request() = default;
+
+            template< typename o >
+            FC2_TEAM_FORCE_INLINE explicit request(std::shared_ptr< o > op) : op(op), result(&op->result)
+            {
+            }
+
+            /**
+             * @brief did the request finish, successfully or not
+             */
+            FC2_TEAM_FORCE_INLINE auto ready() const -> bool
+            {
+                return !op || op->is_done();
+            }
+
+            /**
+             * @brief wait for the request, driving the queue in the meantime
+             * @return
+             */
+            FC2_TEAM_FORCE_INLINE auto get() const -> std::optional< r >
+            {
+                detail::wait::backoff backoff;
+                while (!ready())
+                {
+                    if (poll())
+                    {
+                        backoff.pause([](const std::chrono::microseconds duration) { detail::async::reactor::get()->idle(duration); });
+                    }
+                }
+
+                return op ? *result : std::nullopt;
+            }
+
+            /**
+             * @brief give up on the request. if it is already in flight, the answer is thrown away once it arrives.
+             */
+            FC2_TEAM_FORCE_INLINE void cancel() const
+            {
+                if (op)
+                {
+                    op->cancelled = true;
+                }
+            }
+
+#ifdef FC2_TEAM_COROUTINES
+            FC2_TEAM_FORCE_INLINE auto await_ready() const -> bool
+            {
+                return ready();
+            }
+
+            FC2_TEAM_FORCE_INLINE auto await_suspend(const std::coroutine_handle<> handle) const -> bool
+            {
+                return op && op->suspend(handle);
+            }
+
+            FC2_TEAM_FORCE_INLINE auto await_resume() const -> std::optional< r >
+            {
+                return op ? *result : std::nullopt;
+            }
+#endif
+        };
+
+        /**
+         * @brief non-blocking version of `fc2::call`
+         * @tparam t
+         * @param identifier
+         * @param typing
+         * @param json
+         * @param timeout
+         * @return
+         */
+        template< typename t >
+        FC2T_FUNCTION auto call(const std::string& identifier, FC2_LUA_TYPE typing = FC2_LUA_TYPE::FC2_LUA_TYPE_NONE, const std::string& json = "", const std::chrono::steady_clock::duration timeout = detail::async::default_timeout(FC2_TEAM_REQUESTS_CALL)) -> request< t >
+        {
+            static_assert(std::is_same_v< t, std::string > || sizeof(t) <= sizeof detail::requests::call::data, "result type doesn't fit into a call request");
+
+            return request< t >(detail::async::make< t >(FC2_TEAM_REQUESTS_CALL, timeout,
+                [identifier, typing, json](void* payload)
+                {
+                    auto call = new (payload) detail::requests::call{};
+                    detail::helper::safe_copy(call->identifier, identifier, sizeof call->identifier);
+                    if (!json.empty())
+                    {
+                        detail::helper::safe_copy(call->args, json, sizeof call->args);
+                    }
+
+                    call->typing = typing;
+                },
+                [](const void* payload) -> t
+                {
+                    const auto data = static_cast<const detail::requests::call*>(payload)->data;
+
+                    if constexpr (std::is_same_v< t, std::string >)
+                    {
+                        return std::string(reinterpret_cast<const char*>(data), strnlen(reinterpret_cast<const char*>(data), sizeof detail::requests::call::data));
+                    }
+                    else
+                    {
+                        t output;
+                        memcpy(&output, data, sizeof(t));
+                        return output;
+                    }
+                }));
+        }
+    }
+
+    /**
+     * @brief data type aliases
+     */
+    typedef fc2::detail::requests::draw::detail render;
+
+    /**
+     * @brief get FC2T version compiled with
+     * @return
+     */
+    FC2T_FUNCTION auto get_version() -> std::pair< unsigned int, unsigned int >
+    {
+        return std::make_pair(FC2_TEAM_VERSION_MAJOR, FC2_TEAM_VERSION_MINOR);
+    }
+
+    /**
+     * @brief get the last error FC2T invoked. use this function to check if the FC2 solution has been closed or isn't open to begin with.
+     * @return
+     */
+    FC2T_FUNCTION auto get_error() -> FC2_TEAM_ERROR_CODES
+    {
+        auto c = detail::client::get();
+        return c->last_error;
+    }
+
+    /**
+     * @brief how many times FC2T connected to the FC2 solution. changes whenever it reconnected, for example after Constellation was restarted, so anything fetched from the old session can be refreshed.
+     * @return 0 if it never connected
+     */
+    FC2T_FUNCTION auto get_generation() -> std::uint64_t
+    {
+        auto c = detail::client::get();
+        return c->generation.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief this will return the time difference in Universe4 logs. if you want to test how fast fc2.hpp team is for you, use this.
+     */
+    FC2T_FUNCTION auto ping() -> std::pair< unsigned long long, unsigned long long >
+    {
+        detail::requests::ping_pong data{};
+        {
+            const auto now = std::chrono::high_resolution_clock::now();
+            const auto epoch = now.time_since_epoch();
+            const auto ticks = std::chrono::duration_cast<std::chrono::microseconds>(epoch).count();
+
+            data.ping = static_cast<unsigned long long>(ticks);
+        }
+
+        const auto [ping, pong] = detail::client::send< detail::requests::ping_pong >(FC2_TEAM_REQUESTS_PING, data);
+
+        return std::make_pair(ping, pong);
+    }
+
+    /**
+     * @brief if you don't feel like installing your own http library for the Web API, this can be useful.
+     *
+     * this does have a limit on the buffer size. simply be aware of that (see buffer size pre-definitions).
+     * this method also does not parse the JSON data returned from the Web API, you will need to do that alone.
+     *      - https://github.com/nlohmann/json (FC2 uses this library)
+     *      - https://github.com/json-c/json-c (used this before for another project. prefer nlohmann)
+     *
+     * this is essentially a wrapper for:
+     *      - https://constelia.ai/api.php?key=KEY&cmd=
+     *      - the key value is automatically placed.
+     *      - 'url' starts right after "cmd=" when you call this method.
+     *
+     * @code
+     *
+     *      fc2::api( "toggleScriptStatus&id=150" );
+     *      fc2::api( "resetConfiguration" );
+     *      fc2::api( "getMember&steam&history" ); <--- truncated to FC2_TEAM_MAX_DATA_BUFFER unless the server supports FC2_TEAM_EXTENSION_HTTP_STREAM
+     *      fc2::api( "getConfiguration" );
+     *
+     * @endcode
+     *
+     * @param url
+     * @return
+     */
+    FC2T_FUNCTION auto api(const std::string& url) -> std::string
+    {
+        if (detail::client::get()->supports(FC2_TEAM_EXTENSION_HTTP_STREAM))
+        {
+            return detail::stream::collect(FC2_TEAM_REQUESTS_API, url, {}).value_or(std::string());
+        }
+
+        detail::requests::api data;
+        {
+            detail::helper::safe_copy(data.url, url, sizeof data.url);
+        }
+
+        auto [_, buffer] = detail::client::send(FC2_TEAM_REQUESTS_API, data);
+        return buffer;
+    }
+
+    /**
+     * @brief same as `api`, but answered from memory if the same url was requested less than `max_age` ago. identical requests that run at the same time share one round trip.
+     *
+     * only use this for requests without side effects.
+     *
+     * @code
+     *
+     *      const auto configuration = fc2::api( "getConfiguration", std::chrono::seconds( 10 ) );
+     *
+     * @endcode
+     *
+     * @param url
+     * @param max_age
+     * @return
+     */
+    FC2T_FUNCTION auto api(const std::string& url, const std::chrono::steady_clock::duration max_age) -> std::string
+    {
+        return detail::responses::get()->request(FC2_TEAM_REQUESTS_API, url, max_age, [&url]
+            {
+                /**
+                 * @brief a stream the server broke off returns an empty string without an error, it must not be cached as an empty response
+                 */
+                if (detail::client::get()->supports(FC2_TEAM_EXTENSION_HTTP_STREAM))
+                {
+                    auto response = detail::stream::collect(FC2_TEAM_REQUESTS_API, url, {});
+                    const auto ok = response.has_value();
+                    return std::make_pair(std::move(response).value_or(std::string()), ok);
+                }
+
+                auto response = api(url);
+                return std::make_pair(std::move(response), get_error() == FC2_TEAM_ERROR_NO_ERROR);
+            });
+    }
+
+    /**
+     * @brief same as `api`, but hands the response to `sink` chunk by chunk instead of building one string
+     *
+     * @code
+     *
+     *      std::ofstream file( "history.json" );
+     *      fc2::api_stream( "getMember&steam&history", [ & ]( const char* data, std::size_t size ) { file.write( data, size ); } );
+     *
+     * @endcode
+     *
+     * @param url
+     * @param sink called with `( const char* data, std::size_t size )` for every chunk, in order
+     * @return false if the request failed
+     */
+    template< typename sink_t >
+    FC2T_FUNCTION auto api_stream(const std::string& url, sink_t&& sink) -> bool
+    {
+        if (detail::client::get()->supports(FC2_TEAM_EXTENSION_HTTP_STREAM))
+        {
+            return detail::stream::receive(FC2_TEAM_REQUESTS_API, url, {}, sink);
+        }
+
+        const auto response = api(url);
+        sink(response.data(), response.size());
+        return get_error() == FC2_TEAM_ERROR_NO_ERROR;
+    }
+
+    /**
+     * @brief most behaviors from FC2 can be executed through Lua code honestly.
+     *
+     * this method will either create a dummy create or execute lua code on another actively running script.
+     * FC2 team is designed to interact with FC2; doing basic requests and not caring about the return result should depend on this method.
+     *
+     * https://constelia.ai/sdk/FC2/
+     *
+     * @code
+     * fc2::lua( "print( \"hello world \" )" );
+     * fc2::lua( "fantasy.configuration():save()" ); // save our configuration to cloud (https://constelia.ai/sdk/FC2/modules/configuration/#save).
+     * fc2::lua( R"(
+     *      local input = fantasy.input()
+     *      input:click( 1 ) -- left click
+     *
+     *      fantasy.log("we just left clicked!" )
+     * )" );
+     * @endcode
+     *
+     * @param code
+     */
+    FC2T_FUNCTION auto lua(const std::string& code) -> void
+    {
+        detail::requests::lua data;
+        {
+            detail::helper::safe_copy(data.buffer, code, sizeof data.buffer);
+        }
+
+        detail::client::send(FC2_TEAM_REQUESTS_LUA, data);
+    }
+
+
+    /**
+     * @brief makes all universe4 scripts invoke "on_team_call". this is a faster version of /luar
+     * @tparam t
+     * @param identifier this helps "on_team_call" identify the script or action.
+     * @param typing
+     * @param json
+     *
+     * @code
+     *
+     * function test_script.on_team_call( identifier )
+     *      if identifier == "hello_world" then
+     *          fantasy.log("Hello World")
+     *          return 1337
+     *      end
+     * end
+     *
+     * @endcode
+     *
+     * @return
+     */
+    template< typename t >
+    FC2T_FUNCTION auto call(const std::string& identifier, FC2_LUA_TYPE typing = FC2_LUA_TYPE::FC2_LUA_TYPE_NONE, const std::string& json = "") -> t
+    {
+        detail::transaction< detail::requests::call > tx(FC2_TEAM_REQUESTS_CALL);
+        if (tx)
+        {
+            detail::helper::safe_copy(tx->identifier, identifier, sizeof tx->identifier);
+            if (!json.empty())
+            {
+                detail::helper::safe_copy(tx->args, json, sizeof tx->args);
+            }
+
+            tx->typing = typing;
+            tx.submit();
+        }
+
+        /**
+         * @brief nothing was sent, the result stays zeroed
+         */
+        static constexpr unsigned char empty[sizeof detail::requests::call::data]{};
+        const unsigned char* data = tx ? tx->data : empty;
+
+        /**
+         * @brief compile-time typing support for std::string
+         */
+        if constexpr (std::is_same_v<t, std::string>)
+        {
+            return std::string(reinterpret_cast<const char*>(data), strnlen(reinterpret_cast<const char*>(data), sizeof empty));
+        }
+        else
+        {
+            t output;
+            memcpy(&output, data, sizeof(t));
+            return output;
+        }
+    }
+
+    FC2T_FUNCTION auto call(const std::string& identifier, const std::string& json = "")
+    {
+        detail::requests::call data;
+        {
+            detail::helper::safe_copy(data.identifier, identifier, sizeof data.identifier);
+            if (!json.empty())
+            {
+                detail::helper::safe_copy(data.args, json, sizeof data.args);
+            }
+        }
+
+        detail::client::send(FC2_TEAM_REQUESTS_CALL, data);
+    }
+
+    /**
+     * @brief identifier and lua type of one `call_many` entry
+     * @tparam t
+     */
+    template< typename t >
+    struct call_entry
+    {
+        std::string identifier;
+        FC2_LUA_TYPE typing = FC2_LUA_TYPE::FC2_LUA_TYPE_NONE;
+    };
+
+    /**
+     * @brief same as calling `call` for every identifier, but in a single round trip if the server supports it.
+     *
+     * @code
+     *
+     * auto [streamproof, fps, name] = fc2::call_many< BOOL, uint32_t, std::string >(
+     *      { "directx_overlay_streamproof", FC2_LUA_TYPE_BOOLEAN },
+     *      { "directx_overlay_target_fps", FC2_LUA_TYPE_INT },
+     *      { "directx_overlay_window_name", FC2_LUA_TYPE_STRING }
+     * );
+     *
+     * @endcode
+     *
+     * @tparam t result type of every identifier
+     * @return
+     */
+    template< typename... t >
+    FC2T_FUNCTION auto call_many(const call_entry< t >&... calls) -> std::tuple< t... >
+    {
+        constexpr auto count = sizeof...(t);
+        static_assert(count <= std::extent_v< decltype(detail::requests::call_many::entries) >, "too many identifiers for one call_many request");
+        static_assert(((std::is_same_v< t, std::string > || sizeof(t) <= sizeof detail::requests::call_many::entry::data) && ...), "result type doesn't fit into a call_many entry");
+
+        /**
+         * @brief old servers only understand one identifier per request
+         */
+        if (!detail::client::get()->supports(FC2_TEAM_EXTENSION_CALL_MANY))
+        {
+            return std::tuple< t... >{ call< t >(calls.identifier, calls.typing)... };
+        }
+
+        detail::transaction< detail::requests::call_many > tx(FC2_TEAM_REQUESTS_CALL_MANY, detail::no_init);
+        if (tx)
+        {
+            tx->count = static_cast<std::uint32_t>(count);
+
+            std::size_t i = 0;
+            ((
+                detail::helper::safe_copy(tx->entries[i].identifier, calls.identifier, sizeof tx->entries[i].identifier),
+                tx->entries[i].typing = calls.typing,
+                memset(tx->entries[i].data, 0, sizeof tx->entries[i].data),
+                ++i
+            ), ...);
+
+            tx.submit();
+        }
+
+        /**
+         * @brief nothing was sent, every result stays zeroed
+         */
+        static constexpr unsigned char empty[sizeof detail::requests::call_many::entry::data]{};
+
+        std::size_t i = 0;
+        const auto unpack = [&](auto tag)
+            {
+                using r = typename decltype(tag)::type;
+                const unsigned char* data = tx ? tx->entries[i++].data : empty;
+
+                if constexpr (std::is_same_v< r, std::string >)
+                {
+                    return std::string(reinterpret_cast<const char*>(data), strnlen(reinterpret_cast<const char*>(data), sizeof empty));
+                }
+                else
+                {
+                    r output;
+                    memcpy(&output, data, sizeof(r));
+                    return output;
+                }
+            };
+
+        /**
+         * @brief braced initialization keeps the left to right order
+         */
+        return std::tuple< t... >{ unpack(std::type_identity< t >{})... };
+    }
+
+    /**
+     * @brief installs fc2k or zombiefc2
+     * @return
      */
-    FC2T_FUNCTION auto get_error() -> FC2_TEAM_ERROR_CODES
+    FC2T_FUNCTION auto setup() -> bool
     {
-        auto c = detail::client::get();
-        return c->last_error;
+        constexpr detail::requests::setup data;
+        auto [result] = detail::client::send(FC2_TEAM_REQUESTS_SETUP, data);
+        return result;
     }
 
+
+
     /**
-     * @brief this will return the time difference in Universe4 logs. if you want to test how fast fc2.hpp team is for you, use this.
+     * @brief this will get the bare essential information about a member. you should use "getMember" on the Web API to get detailed information about the user running the FC2T project. https://constelia.ai/sdk/Web%20API/methods/#getmember
+     * @return
      */
-    FC2T_FUNCTION auto ping() -> std::pair< unsigned long long, unsigned long long >
+    FC2T_FUNCTION auto get_session() -> detail::requests::session
     {
-        detail::requests::ping_pong data{};
+        constexpr detail::requests::session data;
+        const auto ret = detail::client::send(FC2_TEAM_REQUESTS_SESSION, data);
+        return ret;
+    }
+
+    namespace draw
+    {
+        /**
+         * @brief this function will add a drawing request to the queue. if on windows, and using fc2kv, it will render whatever is requested to be immediately.
+         */
+        FC2T_FUNCTION auto render(const fc2::detail::requests::draw::detail& data) -> void
+        {
+            detail::transaction< fc2::detail::requests::draw::detail > tx(FC2_TEAM_REQUESTS_DRAW, data);
+            tx.submit();
+        }
+
+        /**
+         * @brief this gets the current drawing requests inside of FC2. the original plan was to simply create an array and always have a static return result. however, this would not only increase the buffer size of FC2T, but it's less reliable.
+         *
+         * @return
+         */
+        FC2T_FUNCTION auto get() -> std::vector< fc2::detail::requests::draw::detail >
+        {
+            std::vector< fc2::detail::requests::draw::detail > output;
+
+            const auto unused = [](const fc2::detail::requests::draw::detail& o)
+                {
+                    return o.style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_NONE;
+                };
+
+            /**
+             * @brief servers that publish a drawing feed can be read without a round trip, as long as they have no more than 100 drawing requests. servers that stream drawing requests, compact or not, aren't limited to 100 entries and only send what is used.
+             */
+            if (detail::extension::read_drawing(output) || detail::extension::read_drawing_compact(output) || detail::extension::read_drawing_stream(output))
+            {
+                output.erase(std::remove_if(output.begin(), output.end(), unused), output.end());
+                return output;
+            }
+
+            /**
+             * @brief read the answer straight out of the segment instead of copying all 100 entries out first
+             */
+            detail::transaction< detail::requests::draw > tx(FC2_TEAM_REQUESTS_GET_DRAWING);
+            if (!tx.submit())
+            {
+                return output;
+            }
+
+            const auto& details = tx->details;
+            std::copy_if(
+                std::begin(details),
+                std::end(details),
+                std::back_inserter(output),
+                [](const fc2::detail::requests::draw::detail& o)
+                {
+                    return o.style[FC2_TEAM_DRAW_STYLE_TYPE] != FC2_TEAM_DRAW_TYPE_NONE;
+                }
+            );
+            return output;
+        }
+
+        /**
+         * @brief non-blocking version of `get`. servers that publish a drawing feed answer immediately. otherwise a single request is queued, which is limited to 100 entries. streamed and compact transfers take several round trips and are only done by `get`.
+         * @param timeout
+         * @return
+         */
+        FC2T_FUNCTION auto get_async(const std::chrono::steady_clock::duration timeout = detail::async::default_timeout(FC2_TEAM_REQUESTS_GET_DRAWING)) -> async::request< std::vector< fc2::detail::requests::draw::detail > >
+        {
+            using result = std::vector< fc2::detail::requests::draw::detail >;
+
+            const auto unused = [](const fc2::detail::requests::draw::detail& o)
+                {
+                    return o.style[FC2_TEAM_DRAW_STYLE_TYPE] == FC2_TEAM_DRAW_TYPE_NONE;
+                };
+
+            if (result output; detail::extension::read_drawing(output))
+            {
+                output.erase(std::remove_if(output.begin(), output.end(), unused), output.end());
+                return async::request< result >(detail::async::make_ready(std::move(output)));
+            }
+
+            return async::request< result >(detail::async::make< result >(FC2_TEAM_REQUESTS_GET_DRAWING, timeout,
+                [](void* payload)
+                {
+                    new (payload) detail::requests::draw{};
+                },
+                [unused](const void* payload)
+                {
+                    const auto& details = static_cast<const detail::requests::draw*>(payload)->details;
+
+                    result output;
+                    std::remove_copy_if(std::begin(details), std::end(details), std::back_inserter(output), unused);
+                    return output;
+                }));
+        }
+
+        /**
+         * @brief drawing requests kept in slots and patched in place every update, instead of rebuilt from scratch.
+         *
+         * if the server supports deltas only the slots that changed since the last update are transferred. otherwise the whole set is fetched and compared to the previous one, so `changed` works either way.
+         */
+        class table
+        {
+            std::vector< fc2::detail::requests::draw::detail > slots;
+            std::vector< std::uint32_t > dirty;
+            std::uint32_t frame = 0;
+
+        public:
+            /**
+             * @brief every slot, including empty ones (FC2_TEAM_DRAW_TYPE_NONE)
+             */
+            FC2_TEAM_FORCE_INLINE auto entries() const -> const std::vector< fc2::detail::requests::draw::detail >&
+            {
+                return slots;
+            }
+
+            /**
+             * @brief slots that changed in the last update
+             */
+            FC2_TEAM_FORCE_INLINE auto changed() const -> const std::vector< std::uint32_t >&
+            {
+                return dirty;
+            }
+
+            /**
+             * @brief get the changes since the last update and apply them
+             * @return true if any slot changed
+             */
+            FC2_TEAM_FORCE_INLINE auto update() -> bool
+            {
+                dirty.clear();
+
+                if (detail::client::get()->supports(FC2_TEAM_EXTENSION_DRAWING_DELTA))
+                {
+                    thread_local std::vector< detail::requests::draw_delta::change > changes;
+
+                    std::uint32_t answered = 0;
+                    std::uint32_t base = 0;
+                    std::uint32_t count = 0;
+
+                    const auto ok = detail::extension::read_chunks(FC2_TEAM_REQUESTS_GET_DRAWING_DELTA, &detail::requests::draw_delta::changes, changes,
+                        [this](detail::requests::draw_delta& req)
+                        {
+                            req.acknowledged = frame;
+                        },
+                        [&](const detail::requests::draw_delta& ret)
+                        {
+                            answered = ret.frame;
+                            base = ret.base;
+                            count = ret.slots;
+                        });
+
+                    if (ok)
+                    {
+                        /**
+                         * @brief not relative to what we have, start from empty slots
+                         */
+                        if (base == 0 || base != frame)
+                        {
+                            for (std::uint32_t i = 0; i < slots.size(); ++i)
+                            {
+                                if (slots[i].style[FC2_TEAM_DRAW_STYLE_TYPE] != FC2_TEAM_DRAW_TYPE_NONE)
+                                {
+                                    dirty.push_back(i);
+                                }
+                            }
+
+                            slots.assign(count, fc2::detail::requests::draw::detail{});
+                        }
+                        else
+                        {
+                            /**
+                             * @brief same as above, dropping a slot only changes something if it held a drawing
+                             */
+                            for (std::uint32_t i = count; i < slots.size(); ++i)
+                            {
+                                if (slots[i].style[FC2_TEAM_DRAW_STYLE_TYPE] != FC2_TEAM_DRAW_TYPE_NONE)
+                                {
+                                    dirty.push_back(i);
+                                }
+                            }
+
+                            slots.resize(count, fc2::detail::requests::draw::detail{});
+                        }
+
+                        for (const auto& [slot, entry] : changes)
+                        {
+                            if (slot < slots.size())
+                            {
+                                slots[slot] = entry;
+                                dirty.push_back(slot);
+                            }
+                        }
+
+                        frame = answered;
+
+                        std::sort(dirty.begin(), dirty.end());
+                        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+                        return !dirty.empty();
+                    }
+                }
+
+                /**
+                 * @brief no deltas, compare the full set slot by slot
+                 */
+                frame = 0;
+
+                const auto current = get();
+                const fc2::detail::requests::draw::detail empty{};
+
+                /**
+                 * @brief removed slots stay in the table as empty ones until the set grows again
+                 */
+                slots.resize(std::max(current.size(), slots.size()), empty);
+
+                for (std::uint32_t i = 0; i < slots.size(); ++i)
+                {
+                    const auto& next = i < current.size() ? current[i] : empty;
+                    if (memcmp(&next, &slots[i], sizeof next) != 0)
+                    {
+                        slots[i] = next;
+                        dirty.push_back(i);
+                    }
+                }
+
+                return !dirty.empty();
+            }
+        };
+
+        /**
+         * @brief build drawing requests without sending them
+         */
+        namespace primitive
+        {
+            FC2T_FUNCTION auto box(const std::int32_t x, const std::int32_t y, const std::int32_t w, const std::int32_t h, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a, const std::int32_t thickness) -> fc2::render
+            {
+                fc2::render d{};
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_LEFT] = x;
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_TOP] = y;
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_RIGHT] = w;
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_BOTTOM] = h;
+
+                d.style[FC2_TEAM_DRAW_STYLE_RED] = r;
+                d.style[FC2_TEAM_DRAW_STYLE_GREEN] = g;
+                d.style[FC2_TEAM_DRAW_STYLE_BLUE] = b;
+                d.style[FC2_TEAM_DRAW_STYLE_ALPHA] = a;
+                d.style[FC2_TEAM_DRAW_STYLE_THICKNESS] = thickness;
+                d.style[FC2_TEAM_DRAW_STYLE_TYPE] = FC2_TEAM_DRAW_TYPE_BOX;
+                return d;
+            }
+
+            FC2T_FUNCTION auto line(const std::int32_t x, const std::int32_t y, const std::int32_t x2, const std::int32_t y2, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a, const std::int32_t thickness) -> fc2::render
+            {
+                fc2::render d{};
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_LEFT] = x;
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_TOP] = y;
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_RIGHT] = x2;
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_BOTTOM] = y2;
+
+                d.style[FC2_TEAM_DRAW_STYLE_RED] = r;
+                d.style[FC2_TEAM_DRAW_STYLE_GREEN] = g;
+                d.style[FC2_TEAM_DRAW_STYLE_BLUE] = b;
+                d.style[FC2_TEAM_DRAW_STYLE_ALPHA] = a;
+                d.style[FC2_TEAM_DRAW_STYLE_THICKNESS] = thickness;
+                d.style[FC2_TEAM_DRAW_STYLE_TYPE] = FC2_TEAM_DRAW_TYPE_LINE;
+                return d;
+            }
+
+            FC2T_FUNCTION auto box_filled(const std::int32_t x, const std::int32_t y, const std::int32_t w, const std::int32_t h, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a) -> fc2::render
+            {
+                fc2::render d{};
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_LEFT] = x;
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_TOP] = y;
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_RIGHT] = w;
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_BOTTOM] = h;
+
+                d.style[FC2_TEAM_DRAW_STYLE_RED] = r;
+                d.style[FC2_TEAM_DRAW_STYLE_GREEN] = g;
+                d.style[FC2_TEAM_DRAW_STYLE_BLUE] = b;
+                d.style[FC2_TEAM_DRAW_STYLE_ALPHA] = a;
+                d.style[FC2_TEAM_DRAW_STYLE_TYPE] = FC2_TEAM_DRAW_TYPE_BOX_FILLED;
+                return d;
+            }
+
+            /**
+             * @brief text longer than `fc2::render::text` is cut off. `draw::text` refuses it instead.
+             */
+            FC2T_FUNCTION auto text(const std::string& buf, const std::int32_t size, const std::int32_t x, const std::int32_t y, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a) -> fc2::render
+            {
+                fc2::render d{};
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_LEFT] = x;
+                d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_TOP] = y;
+
+                detail::helper::safe_copy(d.text, buf, sizeof d.text);
+                d.style[FC2_TEAM_DRAW_STYLE_FONT_SIZE] = size;
+
+                d.style[FC2_TEAM_DRAW_STYLE_RED] = r;
+                d.style[FC2_TEAM_DRAW_STYLE_GREEN] = g;
+                d.style[FC2_TEAM_DRAW_STYLE_BLUE] = b;
+                d.style[FC2_TEAM_DRAW_STYLE_ALPHA] = a;
+                d.style[FC2_TEAM_DRAW_STYLE_TYPE] = FC2_TEAM_DRAW_TYPE_TEXT;
+                return d;
+            }
+        }
+
+        FC2T_FUNCTION auto box(const std::int32_t x, const std::int32_t y, const std::int32_t w, const std::int32_t h, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a, const std::int32_t thickness) -> void
+        {
+            render(primitive::box(x, y, w, h, r, g, b, a, thickness));
+        }
+
+        FC2T_FUNCTION auto line(const std::int32_t x, const std::int32_t y, const std::int32_t x2, const std::int32_t y2, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a, const std::int32_t thickness) -> void
+        {
+            render(primitive::line(x, y, x2, y2, r, g, b, a, thickness));
+        }
+
+        FC2T_FUNCTION auto box_filled(const std::int32_t x, const std::int32_t y, const std::int32_t w, const std::int32_t h, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a) -> void
+        {
+            render(primitive::box_filled(x, y, w, h, r, g, b, a));
+        }
+
+        FC2T_FUNCTION auto text(const std::string& buf, const std::int32_t size, const std::int32_t x, const std::int32_t y, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a) -> void
+        {
+            if (buf.length() > sizeof(fc2::render::text)) return;
+
+            render(primitive::text(buf, size, x, y, r, g, b, a));
+        }
+
+        /**
+         * @brief collects drawing requests and sends them together instead of one round trip per primitive.
+         *
+         * @code
+         *
+         * fc2::draw::batch batch;
+         * for ( const auto& player : players )
+         *      batch.box( player.x, player.y, player.w, player.h, 255, 0, 0, 255, 1 );
+         *
+         * batch.submit();
+         *
+         * @endcode
+         *
+         * servers without FC2_TEAM_EXTENSION_DRAW_BATCH get every primitive through `render`, in the same order.
+         */
+        class batch
+        {
+            std::vector< fc2::render > entries;
+
+        public:
+            FC2_TEAM_FORCE_INLINE auto add(const fc2::render& data) -> batch&
+            {
+                entries.push_back(data);
+                return *this;
+            }
+
+            FC2_TEAM_FORCE_INLINE auto box(const std::int32_t x, const std::int32_t y, const std::int32_t w, const std::int32_t h, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a, const std::int32_t thickness) -> batch&
+            {
+                return add(primitive::box(x, y, w, h, r, g, b, a, thickness));
+            }
+
+            FC2_TEAM_FORCE_INLINE auto line(const std::int32_t x, const std::int32_t y, const std::int32_t x2, const std::int32_t y2, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a, const std::int32_t thickness) -> batch&
+            {
+                return add(primitive::line(x, y, x2, y2, r, g, b, a, thickness));
+            }
+
+            FC2_TEAM_FORCE_INLINE auto box_filled(const std::int32_t x, const std::int32_t y, const std::int32_t w, const std::int32_t h, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a) -> batch&
+            {
+                return add(primitive::box_filled(x, y, w, h, r, g, b, a));
+            }
+
+            /**
+             * @brief same as `draw::text`, text that doesn't fit is skipped
+             */
+            FC2_TEAM_FORCE_INLINE auto text(const std::string& buf, const std::int32_t size, const std::int32_t x, const std::int32_t y, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a) -> batch&
+            {
+                if (buf.length() > sizeof(fc2::render::text)) return *this;
+
+                return add(primitive::text(buf, size, x, y, r, g, b, a));
+            }
+
+            FC2_TEAM_FORCE_INLINE auto size() const -> std::size_t
+            {
+                return entries.size();
+            }
+
+            FC2_TEAM_FORCE_INLINE auto empty() const -> bool
+            {
+                return entries.empty();
+            }
+
+            FC2_TEAM_FORCE_INLINE void clear()
+            {
+                entries.clear();
+            }
+
+            /**
+             * @brief send everything collected so far. batches larger than one request are split into several.
+             * @return true if everything was sent. otherwise what wasn't stays in the batch, so calling `submit` again later sends only the rest.
+             */
+            FC2_TEAM_FORCE_INLINE auto submit() -> bool
+            {
+                std::size_t sent = 0;
+
+                if (!detail::client::get()->supports(FC2_TEAM_EXTENSION_DRAW_BATCH))
+                {
+                    for (; sent < entries.size(); ++sent)
+                    {
+                        detail::transaction< fc2::detail::requests::draw::detail > tx(FC2_TEAM_REQUESTS_DRAW, entries[sent]);
+                        if (!tx || !tx.submit())
+                        {
+                            break;
+                        }
+                    }
+                }
+                else
+                {
+                    constexpr auto capacity = std::extent_v< decltype(detail::requests::draw_batch::details) >;
+
+                    while (sent < entries.size())
+                    {
+                        const auto count = std::min(capacity, entries.size() - sent);
+
+                        detail::transaction< detail::requests::draw_batch > tx(FC2_TEAM_REQUESTS_DRAW_BATCH, detail::no_init);
+                        if (!tx)
+                        {
+                            break;
+                        }
+
+                        tx->count = static_cast<std::uint32_t>(count);
+                        memcpy(static_cast<void*>(tx->details), static_cast<const void*>(entries.data() + sent), count * sizeof(fc2::render));
+
+                        if (!tx.submit())
+                        {
+                            break;
+                        }
+
+                        sent += count;
+                    }
+                }
+
+                entries.erase(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(sent));
+                return entries.empty();
+            }
+        };
+    }
+
+    /**
+     * @brief engine module methods
+     */
+    namespace engine
+    {
+        /**
+     * @brief makes Universe4 attach to a process. attachment process is different based on protection mode.
+     * install_ipc is true by default. when true, FC2K or ZombieFC2 will automatically install itself if it hasn't been done already.
+     *
+     * @param value
+     * @param install_ipc
+     * @return
+     */
+        FC2T_FUNCTION auto attach(const std::variant< std::string, unsigned long>& value, bool install_ipc = true) -> bool
         {
-            const auto now = std::chrono::high_resolution_clock::now();
-            const auto epoch = now.time_since_epoch();
-            const auto ticks = std::chrono::duration_cast<std::chrono::microseconds>(epoch).count();
+            detail::requests::attach data;
+            {
+                data.install_ipc = install_ipc;
+            }
 
-            data.ping = static_cast<unsigned long long>(ticks);
-        }
+            /**
+             * @brief deduce argument type and assign based on type
+             */
+            const auto ret = std::visit([&data](auto&& arg) {
 
-        const auto [ping, pong] = detail::client::send< detail::requests::ping_pong >(FC2_TEAM_REQUESTS_PING, data);
+                using t = std::decay_t< decltype(arg) >;
 
-        return std::make_pair(ping, pong);
-    }
+                /**
+                 * @brief is std::string or unsigned long?
+                 */
+                if constexpr (std::is_same_v< t, std::string >)
+                {
+                    detail::helper::safe_copy(data.name, arg, sizeof data.name);
+                }
+                else if constexpr (std::is_same_v< t, unsigned long >)
+                {
+                    data.id = arg;
+                }
 
-    /**
-     * @brief if you don't feel like installing your own http library for the Web API, this can be useful.
-     *
-     * this does have a limit on the buffer size. simply be aware of that (see buffer size pre-definitions).
-     * this method also does not parse the JSON data returned from the Web API, you will need to do that alone.
-     *      - https://github.com/nlohmann/json (FC2 uses this library)
-     *      - https://github.com/json-c/json-c (used this before for another project. prefer nlohmann)
-     *
-     * this is essentially a wrapper for:
-     *      - https://constelia.ai/api.php?key=KEY&cmd=
-     *      - the key value is automatically placed.
-     *      - 'url' starts right after "cmd=" when you call this method.
-     *
-     * @code
-     *
-     *      fc2::api( "toggleScriptStatus&id=150" );
-     *      fc2::api( "resetConfiguration" );
-     *      fc2::api( "getMember&steam&history" ); <--- likely cause a size limit error in FC2. see buffer size predefs
-     *      fc2::api( "getConfiguration" );
-     *
-     * @endcode
-     *
-     * @param url
-     * @return
-     */
-    FC2T_FUNCTION auto api(const std::string& url) -> std::string
-    {
-        detail::requests::api data;
-        {
-            detail::helper::safe_copy(data.url, url, sizeof data.url);
-        }
+                /**
+                 * @brief send to universe4
+                 */
+                return detail::client::send(FC2_TEAM_REQUESTS_ATTACH, data);
+                }, value);
 
-        auto [_, buffer] = detail::client::send(FC2_TEAM_REQUESTS_API, data);
-        return buffer;
-    }
+            /**
+             * @brief even a failed attach may have detached from the previous process
+             */
+            detail::client::get()->attachments.fetch_add(1, std::memory_order_release);
 
-    /**
-     * @brief most behaviors from FC2 can be executed through Lua code honestly.
-     *
-     * this method will either create a dummy create or execute lua code on another actively running script.
-     * FC2 team is designed to interact with FC2; doing basic requests and not caring about the return result should depend on this method.
-     *
-     * https://constelia.ai/sdk/FC2/
-     *
-     * @code
-     * fc2::lua( "print( \"hello world \" )" );
-     * fc2::lua( "fantasy.configuration():save()" ); // save our configuration to cloud (https://constelia.ai/sdk/FC2/modules/configuration/#save).
-     * fc2::lua( R"(
-     *      local input = fantasy.input()
-     *      input:click( 1 ) -- left click
-     *
-     *      fantasy.log("we just left clicked!" )
-     * )" );
-     * @endcode
-     *
-     * @param code
-     */
-    FC2T_FUNCTION auto lua(const std::string& code) -> void
-    {
-        detail::requests::lua data;
+            return ret.status == 1;
+        }
+
+        /**
+         * @brief gets a module from an attached process.
+         *
+         * sometimes with FC2K, the module size may not be returned or will be "0". this happens with Constellation4 as well. to fix this,
+         * simply restart the attached process. this method will return also fail if there isn't an attached process.
+         *
+         * if you at one point, already called this method for a module, calling it again will always attempt to re-sync the base address and size.
+         * this is different than how the lua module handles this (modules are cached already).
+         *
+         * @param name
+         * @param partition
+         * on Linux, sometimes shared libraries are stored in different permission spaces. this parameter references the index of the mapped layout.
+         * if you don't understand, don't worry about it. if you need help for Linux and this method, ask on forums.
+         *
+         * Windows users should always ignore this parameter.
+         *
+         * @return
+         */
+        FC2T_FUNCTION auto get_module(const std::string& name, const int partition = 0) -> std::pair< unsigned long long, unsigned long long >
         {
-            detail::helper::safe_copy(data.buffer, code, sizeof data.buffer);
+            detail::requests::module data;
+            {
+                detail::helper::safe_copy(data.name, name, sizeof data.name);
+                data.partition = partition;
+            }
+
+            auto ret = detail::client::send(FC2_TEAM_REQUESTS_GET_MODULE, data);
+
+            /**
+             * @brief module not found or attach never worked.
+             */
+            if (!ret.status)
+            {
+                return std::make_pair(0ULL, 0ULL);
+            }
+
+            return std::make_pair(ret.base, ret.size);
         }
 
-        detail::client::send(FC2_TEAM_REQUESTS_LUA, data);
-    }
+        /**
+         * @brief pattern results that survive restarts, see FC2_TEAM_PATTERN_CACHE_FILE.
+         *
+         * results are stored relative to the module base, so they stay valid when the module is loaded somewhere else. every record carries the identity of the module (size and a hash of its first bytes, which contain the build timestamp on Windows), so a patched game is scanned again and its old records are dropped.
+         * records hold the module name, the pattern and every argument, a hit has to match all of them and not only their hash.
+         *
+         * the file is read with a stream once per process instead of being mapped. it only holds a few dozen small records, mapping it wouldn't save anything and would need a Windows and a POSIX version.
+         */
+        class patterns
+        {
+        public:
+            /**
+             * @brief a pattern lookup and, once scanned, its result relative to the module base
+             */
+            struct record
+            {
+                std::string module;
+                std::string pattern;
+                std::uint64_t identity = 0;
+                std::uint32_t offset = 0;
+                std::uint8_t flags = 0;
+                std::uint64_t result = 0;
+
+                FC2_TEAM_FORCE_INLINE auto key() const -> std::uint64_t
+                {
+                    auto h = detail::helper::hash(module.data(), module.size() + 1);
+                    h = detail::helper::hash(pattern.data(), pattern.size() + 1, h);
+                    h = detail::helper::hash(&identity, sizeof identity, h);
+                    h = detail::helper::hash(&offset, sizeof offset, h);
+                    return detail::helper::hash(&flags, sizeof flags, h);
+                }
+
+                FC2_TEAM_FORCE_INLINE auto same_lookup(const record& other) const -> bool
+                {
+                    return identity == other.identity && offset == other.offset && flags == other.flags && module == other.module && pattern == other.pattern;
+                }
+            };
+
+            /**
+             * @brief a module as `get_module` returned it, and its identity
+             */
+            struct module_info
+            {
+                unsigned long long base = 0;
+                unsigned long long size = 0;
+                std::uint64_t identity = 0;
+            };
+
+        private:
+            /**
+             * @brief fixed part of a record in the file, followed by `module_length` bytes of the module name and `pattern_length` bytes of the pattern
+             */
+            struct entry
+            {
+                std::uint64_t identity = 0;
+                std::uint64_t result = 0;
+                std::uint32_t offset = 0;
+                std::uint8_t flags = 0;
+                std::uint8_t reserved = 0;
+                std::uint16_t module_length = 0;
+                std::uint32_t pattern_length = 0;
+                std::uint32_t reserved2 = 0;
+            };
+
+            struct header
+            {
+                std::uint32_t magic = 0;
+                std::uint32_t version = 0;
+            };
+
+            static constexpr std::uint32_t magic = 0x50543246;
+            static constexpr std::uint32_t version = 2;
+
+            std::mutex mutex;
+            bool loaded = false;
+            std::filesystem::path file;
+
+            /**
+             * @brief keyed by the hash of the lookup, `find` still compares everything
+             */
+            std::unordered_multimap< std::uint64_t, record > records;
+
+            /**
+             * @brief modules already looked up and identified in this session and since the last `attach`
+             */
+            std::unordered_map< std::string, module_info > modules;
+            std::uint64_t generation = 0;
+            std::uint64_t attachments = 0;
+
+            FC2_TEAM_FORCE_INLINE void load()
+            {
+                if (loaded)
+                {
+                    return;
+                }
+
+                loaded = true;
+
+                const std::filesystem::path name(FC2_TEAM_PATTERN_CACHE_FILE);
+                if (name.empty())
+                {
+                    return;
+                }
+
+                file = name.is_absolute() ? name : detail::helper::executable_directory() / name;
+
+                /**
+                 * @brief a broken or foreign file is treated as empty and replaced on the next store
+                 */
+                std::ifstream in(file, std::ios::binary);
+                header h;
+                if (!in.read(reinterpret_cast<char*>(&h), sizeof h) || h.magic != magic || h.version != version)
+                {
+                    return;
+                }
+
+                /**
+                 * @brief a truncated last record is ignored
+                 */
+                entry e;
+                while (in.read(reinterpret_cast<char*>(&e), sizeof e))
+                {
+                    if (e.module_length >= FC2_TEAM_MAX_DATA_BUFFER || e.pattern_length >= FC2_TEAM_MAX_DATA_BUFFER)
+                    {
+                        return;
+                    }
+
+                    record r{ std::string(e.module_length, '\0'), std::string(e.pattern_length, '\0'), e.identity, e.offset, e.flags, e.result };
+                    if (!in.read(r.module.data(), e.module_length) || !in.read(r.pattern.data(), e.pattern_length))
+                    {
+                        return;
+                    }
+
+                    records.emplace(r.key(), std::move(r));
+                }
+            }
+
+            FC2_TEAM_FORCE_INLINE static void write(std::ofstream& out, const record& r)
+            {
+                entry e;
+                {
+                    e.identity = r.identity;
+                    e.result = r.result;
+                    e.offset = r.offset;
+                    e.flags = r.flags;
+                    e.module_length = static_cast<std::uint16_t>(r.module.size());
+                    e.pattern_length = static_cast<std::uint32_t>(r.pattern.size());
+                }
+
+                out.write(reinterpret_cast<const char*>(&e), sizeof e);
+                out.write(r.module.data(), static_cast<std::streamsize>(r.module.size()));
+                out.write(r.pattern.data(), static_cast<std::streamsize>(r.pattern.size()));
+            }
+
+            FC2_TEAM_FORCE_INLINE void rewrite()
+            {
+                std::ofstream out(file, std::ios::binary | std::ios::trunc);
+
+                const header h{ magic, version };
+                out.write(reinterpret_cast<const char*>(&h), sizeof h);
+
+                for (const auto& [key, r] : records)
+                {
+                    write(out, r);
+                }
+            }
+
+        public:
+            FC2T_FUNCTION auto get() -> patterns*
+            {
+                static patterns obj;
+                return &obj;
+            }
+
+            /**
+             * @brief identify a loaded module by its size and first bytes
+             * @return 0 if the module can't be read
+             */
+            FC2T_FUNCTION auto identify(const unsigned long long base, const unsigned long long size) -> std::uint64_t
+            {
+                detail::transaction< detail::requests::read_memory > tx(FC2_TEAM_REQUESTS_READ_MEMORY);
+                if (!tx)
+                {
+                    return 0;
+                }
+
+                tx->address = base;
+                tx->size = std::min< unsigned long long >(size, sizeof tx->data);
+
+                if (!tx.submit() || tx->bytes_read != tx->size)
+                {
+                    return 0;
+                }
+
+                const auto identity = detail::helper::hash(tx->data, static_cast<std::size_t>(tx->bytes_read), detail::helper::hash(&size, sizeof size));
+                return identity ? identity : 1;
+            }
+
+            FC2_TEAM_FORCE_INLINE auto enabled() -> bool
+            {
+                std::lock_guard lock(mutex);
+                load();
+                return !file.empty();
+            }
+
+            /**
+             * @brief base, size and identity of a module. only the first lookup of a module after FC2T (re)connects or `attach` is called costs round trips, a `get_module` and a read of its first bytes.
+             * @return an identity of 0 if the module isn't loaded or can't be read
+             */
+            FC2_TEAM_FORCE_INLINE auto lookup(const std::string& name) -> module_info
+            {
+                const auto c = detail::client::get();
+                const auto session = c->generation.load(std::memory_order_acquire);
+                const auto attached = c->attachments.load(std::memory_order_acquire);
+
+                {
+                    std::lock_guard lock(mutex);
+                    if (session != generation || attached != attachments)
+                    {
+                        modules.clear();
+                        generation = session;
+                        attachments = attached;
+                    }
+
+                    if (const auto it = modules.find(name); it != modules.end())
+                    {
+                        return it->second;
+                    }
+                }
+
+                module_info m;
+                std::tie(m.base, m.size) = get_module(name);
+                m.identity = m.base ? identify(m.base, m.size) : 0;
+
+                /**
+                 * @brief only remembered if nothing changed while it was looked up
+                 */
+                std::lock_guard lock(mutex);
+                if (m.identity && session == c->generation.load(std::memory_order_acquire) && attached == c->attachments.load(std::memory_order_acquire))
+                {
+                    modules[name] = m;
+                }
+
+                return m;
+            }
+
+            /**
+             * @brief the cached result of a lookup, relative to the module base
+             */
+            FC2_TEAM_FORCE_INLINE auto find(const record& lookup) -> std::optional< std::uint64_t >
+            {
+                std::lock_guard lock(mutex);
+                load();
+
+                const auto [first, last] = records.equal_range(lookup.key());
+                for (auto it = first; it != last; ++it)
+                {
+                    if (it->second.same_lookup(lookup))
+                    {
+                        return it->second.result;
+                    }
+                }
 
+                return std::nullopt;
+            }
 
-    /**
-     * @brief makes all universe4 scripts invoke "on_team_call". this is a faster version of /luar
-     * @tparam t
-     * @param identifier this helps "on_team_call" identify the script or action.
-     * @param typing
-     * @param json
-     *
-     * @code
-     *
-     * function test_script.on_team_call( identifier )
-     *      if identifier == "hello_world" then
-     *          fantasy.log("Hello World")
-     *          return 1337
-     *      end
-     * end
-     *
-     * @endcode
-     *
-     * @return
-     */
-    template< typename t >
-    FC2T_FUNCTION auto call(const std::string& identifier, FC2_LUA_TYPE typing = FC2_LUA_TYPE::FC2_LUA_TYPE_NONE, const std::string& json = "") -> t
-    {
-        detail::requests::call data;
-        {
-            detail::helper::safe_copy(data.identifier, identifier, sizeof data.identifier);
-            if (!json.empty())
+            /**
+             * @brief remember a result. records of an older build of the same module are dropped.
+             */
+            FC2_TEAM_FORCE_INLINE void store(const record& r)
             {
-                detail::helper::safe_copy(data.args, json, sizeof data.args);
+                std::lock_guard lock(mutex);
+                load();
+
+                if (file.empty())
+                {
+                    return;
+                }
+
+                const auto stale = std::erase_if(records, [&](const auto& entry)
+                    {
+                        return entry.second.module == r.module && (entry.second.identity != r.identity || entry.second.same_lookup(r));
+                    });
+
+                const auto fresh = records.empty();
+                records.emplace(r.key(), r);
+
+                /**
+                 * @brief appending is enough unless something has to go
+                 */
+                std::error_code error;
+                if (stale || fresh || !std::filesystem::exists(file, error) || std::filesystem::file_size(file, error) < sizeof(header))
+                {
+                    rewrite();
+                    return;
+                }
+
+                std::ofstream out(file, std::ios::binary | std::ios::app);
+                write(out, r);
             }
 
-            data.typing = typing;
-        }
+            FC2_TEAM_FORCE_INLINE void clear()
+            {
+                std::lock_guard lock(mutex);
+                load();
 
-        auto ret = detail::client::send(FC2_TEAM_REQUESTS_CALL, data);
+                records.clear();
+                modules.clear();
+                if (!file.empty())
+                {
+                    std::error_code error;
+                    std::filesystem::remove(file, error);
+                }
+            }
+        };
 
         /**
-         * @brief compile-time typing support for std::string
+         * @brief pattern scan from a module retrieved from get_module (IDA-style only)
+         *
+         * @param module this should be the same module name from get_module.
+         * @param pattern IDA-style pattern only.
+         * @param offset
+         * @param is_x64 set this false if the target process is x86
+         * @param relative
+         * @param ds data segment
+         * @return
+         *
+         * results are cached on disk (see `patterns`), so only the first start after a game update has to wait for the scan.
+         * while the cache is enabled the first call for a module after FC2T connects or `attach` is called costs a `get_module` round trip and a read of the module's first FC2_TEAM_MAX_DATA_BUFFER bytes to identify it. later hits cost no round trip.
+         * results outside of the module (e.g. a relative address that resolves into another module) are never cached.
          */
-        if constexpr (std::is_same_v<t, std::string>)
-        {
-            return std::string(reinterpret_cast<char*>(ret.data));
-        }
-        else
+        FC2T_FUNCTION auto pattern(const std::string& module, const std::string& pattern, const unsigned int offset, const bool is_x64 = true, const bool relative = true, bool ds = false) -> unsigned long long
         {
-            t output;
-            memcpy(&output, ret.data, sizeof(t));
-            return output;
-        }
-    }
+            auto cache = patterns::get();
 
-    FC2T_FUNCTION auto call(const std::string& identifier, const std::string& json = "")
-    {
-        detail::requests::call data;
-        {
-            detail::helper::safe_copy(data.identifier, identifier, sizeof data.identifier);
-            if (!json.empty())
+            /**
+             * @brief the server only sees as much of the names as fits into the request
+             */
+            patterns::module_info loaded;
+            patterns::record lookup{ module.substr(0, FC2_TEAM_MAX_DATA_BUFFER - 1), pattern.substr(0, FC2_TEAM_MAX_DATA_BUFFER - 1), 0, offset, static_cast<std::uint8_t>(is_x64 | relative << 1 | ds << 2) };
+            if (cache->enabled())
             {
-                detail::helper::safe_copy(data.args, json, sizeof data.args);
+                loaded = cache->lookup(module);
+                lookup.identity = loaded.identity;
             }
-        }
 
-        detail::client::send(FC2_TEAM_REQUESTS_CALL, data);
-    }
+            if (lookup.identity)
+            {
+                if (const auto hit = cache->find(lookup))
+                {
+                    return loaded.base + *hit;
+                }
+            }
 
-    /**
-     * @brief installs fc2k or zombiefc2
-     * @return
-     */
-    FC2T_FUNCTION auto setup() -> bool
-    {
-        constexpr detail::requests::setup data;
-        auto [result] = detail::client::send(FC2_TEAM_REQUESTS_SETUP, data);
-        return result;
-    }
+            detail::requests::pattern data;
+            {
+                detail::helper::safe_copy(data.module, module, sizeof data.module);
+                detail::helper::safe_copy(data.sig_pattern, pattern, sizeof data.sig_pattern);
 
+                data.offset = offset;
+                data.is_x64 = is_x64;
+                data.relative = relative;
+                data.ds = ds;
+            }
 
+            auto ret = detail::client::send(FC2_TEAM_REQUESTS_PATTERN, data);
 
-    /**
-     * @brief this will get the bare essential information about a member. you should use "getMember" on the Web API to get detailed information about the user running the FC2T project. https://constelia.ai/sdk/Web%20API/methods/#getmember
-     * @return
-     */
-    FC2T_FUNCTION auto get_session() -> detail::requests::session
-    {
-        constexpr detail::requests::session data;
-        const auto ret = detail::client::send(FC2_TEAM_REQUESTS_SESSION, data);
-        return ret;
-    }
+            /**
+             * @brief misses aren't remembered, the pattern may still show up (e.g. a module that is unpacked at runtime). only offsets into the module stay valid once it is loaded elsewhere.
+             */
+            if (lookup.identity && ret.result >= loaded.base && ret.result - loaded.base < loaded.size)
+            {
+                lookup.result = ret.result - loaded.base;
+                cache->store(lookup);
+            }
 
-    namespace draw
-    {
-        /**
-         * @brief this function will add a drawing request to the queue. if on windows, and using fc2kv, it will render whatever is requested to be immediately.
-         */
-        FC2T_FUNCTION auto render(const fc2::detail::requests::draw::detail& data) -> void
-        {
-            detail::client::send(FC2_TEAM_REQUESTS_DRAW, data);
+            return ret.result;
         }
 
         /**
-         * @brief this gets the current drawing requests inside of FC2. the original plan was to simply create an array and always have a static return result. however, this would not only increase the buffer size of FC2T, but it's less reliable.
+         * @brief collects process memory reads and performs them in as few round trips as possible.
          *
-         * @return
+         * @code
+         *
+         * int health;
+         * float origin[3];
+         *
+         * fc2::engine::gather reads;
+         * const auto health_read = reads.add( player + 0x100, health );
+         * reads.add( player + 0x134, origin );
+         *
+         * // the same reads can be executed again every frame
+         * if ( reads.execute() && reads.succeeded( health_read ) ) ...
+         *
+         * @endcode
+         *
+         * servers without FC2_TEAM_EXTENSION_READ_MEMORY_MANY get one `read_memory` request per FC2_TEAM_MAX_DATA_BUFFER bytes.
          */
-        FC2T_FUNCTION auto get() -> std::vector< fc2::detail::requests::draw::detail >
+        class gather
         {
-            std::vector< fc2::detail::requests::draw::detail > output;
-            constexpr detail::requests::draw data;
+            /**
+             * @brief reads are split so every piece also fits into a single `read_memory` request
+             */
+            struct piece
+            {
+                unsigned long long address = 0;
+                std::uint32_t size = 0;
+                std::uint32_t target = 0;
+                unsigned char* output = nullptr;
+            };
 
-            auto [details] = detail::client::send(FC2_TEAM_REQUESTS_GET_DRAWING, data);
+            std::vector< piece > pieces;
+            std::vector< std::uint8_t > results;
+            std::size_t targets = 0;
 
-            std::copy_if(
-                std::begin(details),
-                std::end(details),
-                std::back_inserter(output),
-                [](const fc2::detail::requests::draw::detail& o)
+            /**
+             * @brief the serial fallback
+             */
+            FC2_TEAM_FORCE_INLINE static auto read_piece(const piece& p) -> bool
+            {
+                detail::transaction< detail::requests::read_memory > tx(FC2_TEAM_REQUESTS_READ_MEMORY);
+                if (!tx)
                 {
-                    return o.style[FC2_TEAM_DRAW_STYLE_TYPE] != FC2_TEAM_DRAW_TYPE_NONE;
+                    return false;
                 }
-            );
-            return output;
-        }
 
-        FC2T_FUNCTION auto box(const std::int32_t x, const std::int32_t y, const std::int32_t w, const std::int32_t h, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a, const std::int32_t thickness) -> void
-        {
-            fc2::render d;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_LEFT] = x;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_TOP] = y;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_RIGHT] = w;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_BOTTOM] = h;
+                tx->address = p.address;
+                tx->size = p.size;
 
-            d.style[FC2_TEAM_DRAW_STYLE_RED] = r;
-            d.style[FC2_TEAM_DRAW_STYLE_GREEN] = g;
-            d.style[FC2_TEAM_DRAW_STYLE_BLUE] = b;
-            d.style[FC2_TEAM_DRAW_STYLE_ALPHA] = a;
-            d.style[FC2_TEAM_DRAW_STYLE_THICKNESS] = thickness;
-            d.style[FC2_TEAM_DRAW_STYLE_TYPE] = FC2_TEAM_DRAW_TYPE_BOX;
+                if (!tx.submit() || tx->bytes_read != p.size)
+                {
+                    return false;
+                }
 
-            render(d);
-        }
+                memcpy(p.output, tx->data, p.size);
+                return true;
+            }
 
-        FC2T_FUNCTION auto line(const std::int32_t x, const std::int32_t y, const std::int32_t x2, const std::int32_t y2, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a, const std::int32_t thickness) -> void
-        {
-            fc2::render d;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_LEFT] = x;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_TOP] = y;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_RIGHT] = x2;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_BOTTOM] = y2;
+        public:
+            /**
+             * @brief queue a read of `size` bytes at `address` into `output`
+             * @return index to pass to `succeeded`
+             */
+            FC2_TEAM_FORCE_INLINE auto add(const unsigned long long address, void* output, const std::size_t size) -> std::size_t
+            {
+                const auto target = targets++;
+                auto bytes = static_cast<unsigned char*>(output);
 
-            d.style[FC2_TEAM_DRAW_STYLE_RED] = r;
-            d.style[FC2_TEAM_DRAW_STYLE_GREEN] = g;
-            d.style[FC2_TEAM_DRAW_STYLE_BLUE] = b;
-            d.style[FC2_TEAM_DRAW_STYLE_ALPHA] = a;
-            d.style[FC2_TEAM_DRAW_STYLE_THICKNESS] = thickness;
-            d.style[FC2_TEAM_DRAW_STYLE_TYPE] = FC2_TEAM_DRAW_TYPE_LINE;
+                for (std::size_t offset = 0; offset < size; offset += FC2_TEAM_MAX_DATA_BUFFER)
+                {
+                    const auto length = std::min< std::size_t >(FC2_TEAM_MAX_DATA_BUFFER, size - offset);
+                    pieces.push_back({ address + offset, static_cast<std::uint32_t>(length), static_cast<std::uint32_t>(target), bytes + offset });
+                }
 
-            render(d);
-        }
+                return target;
+            }
 
-        FC2T_FUNCTION auto box_filled(const std::int32_t x, const std::int32_t y, const std::int32_t w, const std::int32_t h, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a) -> void
-        {
-            fc2::render d;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_LEFT] = x;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_TOP] = y;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_RIGHT] = w;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_BOTTOM] = h;
+            template< typename t >
+            FC2_TEAM_FORCE_INLINE auto add(const unsigned long long address, t& output) -> std::size_t
+            {
+                static_assert(std::is_trivially_copyable_v< t >, "gather can only read trivially copyable types");
+                return add(address, std::addressof(output), sizeof(t));
+            }
 
-            d.style[FC2_TEAM_DRAW_STYLE_RED] = r;
-            d.style[FC2_TEAM_DRAW_STYLE_GREEN] = g;
-            d.style[FC2_TEAM_DRAW_STYLE_BLUE] = b;
-            d.style[FC2_TEAM_DRAW_STYLE_ALPHA] = a;
-            d.style[FC2_TEAM_DRAW_STYLE_TYPE] = FC2_TEAM_DRAW_TYPE_BOX_FILLED;
+            /**
+             * @brief perform every queued read. outputs of failed reads may be partially written.
+             * @return true if every read succeeded
+             */
+            FC2_TEAM_FORCE_INLINE auto execute() -> bool
+            {
+                results.assign(targets, 1);
 
-            render(d);
-        }
+                const auto fail = [this](const piece& p)
+                    {
+                        results[p.target] = 0;
+                    };
 
-        FC2T_FUNCTION auto text(const std::string& buf, const std::int32_t size, const std::int32_t x, const std::int32_t y, const std::int32_t r, const std::int32_t g, const std::int32_t b, const std::int32_t a) -> void
-        {
-            if (buf.length() > sizeof(fc2::render::text)) return;
+                if (!detail::client::get()->supports(FC2_TEAM_EXTENSION_READ_MEMORY_MANY))
+                {
+                    for (const auto& p : pieces)
+                    {
+                        if (!read_piece(p)) fail(p);
+                    }
+                }
+                else
+                {
+                    constexpr auto capacity = std::extent_v< decltype(detail::requests::read_memory_many::entries) >;
+                    constexpr auto space = sizeof detail::requests::read_memory_many::data;
 
-            fc2::render d;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_LEFT] = x;
-            d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_TOP] = y;
+                    for (std::size_t first = 0; first < pieces.size(); )
+                    {
+                        /**
+                         * @brief take as many pieces as there are entries and data left
+                         */
+                        std::size_t last = first;
+                        std::size_t used = 0;
+                        while (last < pieces.size() && last - first < capacity && used + pieces[last].size <= space)
+                        {
+                            used += pieces[last++].size;
+                        }
+
+                        detail::transaction< detail::requests::read_memory_many > tx(FC2_TEAM_REQUESTS_READ_MEMORY_MANY, detail::no_init);
+                        if (!tx)
+                        {
+                            std::for_each(pieces.begin() + first, pieces.end(), fail);
+                            break;
+                        }
+
+                        tx->count = static_cast<std::uint32_t>(last - first);
+
+                        /**
+                         * @brief the server can write to the entries, so the answer is copied from where we put each piece and never from offsets or sizes read back from the segment
+                         */
+                        std::uint32_t offsets[capacity];
+                        std::uint32_t offset = 0;
+                        for (std::size_t i = first; i < last; i++)
+                        {
+                            auto& entry = tx->entries[i - first];
+                            entry.address = pieces[i].address;
+                            entry.size = pieces[i].size;
+                            entry.offset = offset;
+                            entry.bytes_read = 0;
+                            offsets[i - first] = offset;
+                            offset += pieces[i].size;
+                        }
+
+                        if (!tx.submit())
+                        {
+                            std::for_each(pieces.begin() + first, pieces.end(), fail);
+                            break;
+                        }
+
+                        for (std::size_t i = first; i < last; i++)
+                        {
+                            const auto& entry = tx->entries[i - first];
+                            if (entry.bytes_read != pieces[i].size)
+                            {
+                                fail(pieces[i]);
+                                continue;
+                            }
+
+                            memcpy(pieces[i].output, tx->data + offsets[i - first], pieces[i].size);
+                        }
+
+                        first = last;
+                    }
+                }
 
-            detail::helper::safe_copy(d.text, buf, sizeof d.text);
-            d.style[FC2_TEAM_DRAW_STYLE_FONT_SIZE] = size;
+                return std::find(results.begin(), results.end(), 0) == results.end();
+            }
 
-            d.style[FC2_TEAM_DRAW_STYLE_RED] = r;
-            d.style[FC2_TEAM_DRAW_STYLE_GREEN] = g;
-            d.style[FC2_TEAM_DRAW_STYLE_BLUE] = b;
-            d.style[FC2_TEAM_DRAW_STYLE_ALPHA] = a;
-            d.style[FC2_TEAM_DRAW_STYLE_TYPE] = FC2_TEAM_DRAW_TYPE_TEXT;
+            /**
+             * @brief whether the read returned by `add` succeeded during the last `execute`
+             */
+            FC2_TEAM_FORCE_INLINE auto succeeded(const std::size_t index) const -> bool
+            {
+                return index < results.size() && results[index];
+            }
 
-            render(d);
-        }
-    }
+            FC2_TEAM_FORCE_INLINE auto size() const -> std::size_t
+            {
+                return targets;
+            }
+
+            FC2_TEAM_FORCE_INLINE void clear()
+            {
+                pieces.clear();
+                results.clear();
+                targets = 0;
+            }
+        };
 
-    /**
-     * @brief engine module methods
-     */
-    namespace engine
-    {
         /**
-     * @brief makes Universe4 attach to a process. attachment process is different based on protection mode.
-     * install_ipc is true by default. when true, FC2K or ZombieFC2 will automatically install itself if it hasn't been done already.
-     *
-     * @param value
-     * @param install_ipc
-     * @return
-     */
-        FC2T_FUNCTION auto attach(const std::variant< std::string, unsigned long>& value, bool install_ipc = true) -> bool
+         * @brief optional read-through cache for `read_memory`.
+         *
+         * memory is fetched in aligned lines of FC2_TEAM_READ_CACHE_LINE_SIZE bytes, so reads close to each other (an entity, the view matrix) only cost one round trip per frame. lines expire when `next_frame` is called, after the ttl, when FC2T reconnects or when `attach` is called.
+         *
+         * @code
+         *
+         * fc2::engine::cache::enable( true );
+         *
+         * while ( running )
+         * {
+         *      fc2::engine::cache::next_frame();
+         *      // read_memory calls...
+         * }
+         *
+         * @endcode
+         */
+        namespace cache
         {
-            detail::requests::attach data;
+            static_assert((FC2_TEAM_READ_CACHE_LINE_SIZE & (FC2_TEAM_READ_CACHE_LINE_SIZE - 1)) == 0 && FC2_TEAM_READ_CACHE_LINE_SIZE <= FC2_TEAM_MAX_DATA_BUFFER, "FC2_TEAM_READ_CACHE_LINE_SIZE has to be a power of two and fit into a read_memory request");
+
+            struct summary
             {
-                data.install_ipc = install_ipc;
-            }
+                /**
+                 * @brief reads answered without a round trip
+                 */
+                std::uint64_t hits = 0;
+                std::uint64_t misses = 0;
 
-            /**
-             * @brief deduce argument type and assign based on type
-             */
-            const auto ret = std::visit([&data](auto&& arg) {
+                /**
+                 * @brief bytes of hits, that didn't have to be transferred
+                 */
+                std::uint64_t bytes_saved = 0;
+
+                /**
+                 * @brief bytes of whole lines transferred for misses
+                 */
+                std::uint64_t bytes_fetched = 0;
+
+                FC2_TEAM_FORCE_INLINE auto hit_rate() const -> double
+                {
+                    return hits + misses ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0;
+                }
+            };
+
+            class table
+            {
+                struct line
+                {
+                    std::uint64_t epoch = 0;
+                    std::chrono::steady_clock::time_point fetched;
+                    unsigned char data[FC2_TEAM_READ_CACHE_LINE_SIZE];
+                };
+
+                std::mutex mutex;
+                std::unordered_map< unsigned long long, line > lines;
+                std::uint64_t generation = 0;
+                std::uint64_t attachments = 0;
+
+            public:
+                std::atomic< bool > enabled{ false };
+                std::atomic< std::uint64_t > epoch{ 0 };
+                std::atomic< std::chrono::steady_clock::rep > ttl{ 0 };
 
-                using t = std::decay_t< decltype(arg) >;
+                std::atomic< std::uint64_t > hits{ 0 };
+                std::atomic< std::uint64_t > misses{ 0 };
+                std::atomic< std::uint64_t > bytes_saved{ 0 };
+                std::atomic< std::uint64_t > bytes_fetched{ 0 };
 
-                /**
-                 * @brief is std::string or unsigned long?
-                 */
-                if constexpr (std::is_same_v< t, std::string >)
+                FC2T_FUNCTION auto get() -> table*
                 {
-                    detail::helper::safe_copy(data.name, arg, sizeof data.name);
+                    static table obj;
+                    return &obj;
                 }
-                else if constexpr (std::is_same_v< t, unsigned long >)
+
+                FC2_TEAM_FORCE_INLINE void clear()
                 {
-                    data.id = arg;
+                    std::lock_guard lock(mutex);
+                    lines.clear();
                 }
 
                 /**
-                 * @brief send to universe4
+                 * @brief serve a read from cached lines, fetching the missing ones together
+                 * @return false if a line couldn't be read, the caller has to read the exact range itself
                  */
-                return detail::client::send(FC2_TEAM_REQUESTS_ATTACH, data);
-                }, value);
+                FC2_TEAM_FORCE_INLINE auto read(const unsigned long long address, void* output, const std::size_t size) -> bool
+                {
+                    constexpr unsigned long long mask = ~static_cast<unsigned long long>(FC2_TEAM_READ_CACHE_LINE_SIZE - 1);
 
-            return ret.status == 1;
-        }
+                    const auto first = address & mask;
+                    const auto last = (address + size - 1) & mask;
+                    const auto now = std::chrono::steady_clock::now();
+                    const auto current = epoch.load(std::memory_order_relaxed);
+                    const auto lifetime = std::chrono::steady_clock::duration(ttl.load(std::memory_order_relaxed));
 
-        /**
-         * @brief gets a module from an attached process.
-         *
-         * sometimes with FC2K, the module size may not be returned or will be "0". this happens with Constellation4 as well. to fix this,
-         * simply restart the attached process. this method will return also fail if there isn't an attached process.
-         *
-         * if you at one point, already called this method for a module, calling it again will always attempt to re-sync the base address and size.
-         * this is different than how the lua module handles this (modules are cached already).
-         *
-         * @param name
-         * @param partition
-         * on Linux, sometimes shared libraries are stored in different permission spaces. this parameter references the index of the mapped layout.
-         * if you don't understand, don't worry about it. if you need help for Linux and this method, ask on forums.
-         *
-         * Windows users should always ignore this parameter.
-         *
-         * @return
-         */
-        FC2T_FUNCTION auto get_module(const std::string& name, const int partition = 0) -> std::pair< unsigned long long, unsigned long long >
-        {
-            detail::requests::module data;
+                    const auto fresh = [&](const line& l)
+                        {
+                            return l.epoch == current && (lifetime.count() == 0 || now - l.fetched < lifetime);
+                        };
+
+                    const auto c = detail::client::get();
+                    const auto session = c->generation.load(std::memory_order_acquire);
+                    const auto attached = c->attachments.load(std::memory_order_acquire);
+
+                    std::vector< unsigned long long > missing;
+                    {
+                        std::lock_guard lock(mutex);
+
+                        /**
+                         * @brief nothing from a previous session or a previously attached process is worth keeping
+                         */
+                        if (session > generation || attached > attachments)
+                        {
+                            lines.clear();
+                            generation = std::max(generation, session);
+                            attachments = std::max(attachments, attached);
+                        }
+
+                        for (auto base = first; base <= last; base += FC2_TEAM_READ_CACHE_LINE_SIZE)
+                        {
+                            const auto it = lines.find(base);
+                            if (it == lines.end() || !fresh(it->second))
+                            {
+                                missing.push_back(base);
+                            }
+                        }
+
+                        if (missing.empty())
+                        {
+                            copy(first, last, address, output, size);
+                            hits.fetch_add(1, std::memory_order_relaxed);
+                            bytes_saved.fetch_add(size, std::memory_order_relaxed);
+                            return true;
+                        }
+                    }
+
+                    misses.fetch_add(1, std::memory_order_relaxed);
+
+                    /**
+                     * @brief fetch outside the lock so other threads keep hitting the cache meanwhile
+                     */
+                    std::vector< line > fetched(missing.size());
+                    gather reads;
+                    for (std::size_t i = 0; i < missing.size(); i++)
+                    {
+                        fetched[i].epoch = current;
+                        fetched[i].fetched = now;
+                        reads.add(missing[i], fetched[i].data, FC2_TEAM_READ_CACHE_LINE_SIZE);
+                    }
+
+                    const auto complete = reads.execute();
+
+                    std::lock_guard lock(mutex);
+
+                    /**
+                     * @brief the lines may come from a process that got replaced while they were read
+                     */
+                    if (session != c->generation.load(std::memory_order_acquire) || attached != c->attachments.load(std::memory_order_acquire))
+                    {
+                        return false;
+                    }
+
+                    for (std::size_t i = 0; i < missing.size(); i++)
+                    {
+                        if (!reads.succeeded(i))
+                        {
+                            continue;
+                        }
+
+                        bytes_fetched.fetch_add(FC2_TEAM_READ_CACHE_LINE_SIZE, std::memory_order_relaxed);
+
+                        /**
+                         * @brief full tables start over, the working set of a frame is usually much smaller
+                         */
+                        if (lines.size() >= FC2_TEAM_READ_CACHE_LINES && !lines.contains(missing[i]))
+                        {
+                            lines.clear();
+                        }
+
+                        lines[missing[i]] = fetched[i];
+                    }
+
+                    /**
+                     * @brief the lines partially lie in memory that can't be read, e.g. the end of a page
+                     */
+                    if (!complete)
+                    {
+                        return false;
+                    }
+
+                    /**
+                     * @brief a concurrent clear may have dropped the lines again
+                     */
+                    for (auto base = first; base <= last; base += FC2_TEAM_READ_CACHE_LINE_SIZE)
+                    {
+                        if (!lines.contains(base))
+                        {
+                            return false;
+                        }
+                    }
+
+                    copy(first, last, address, output, size);
+                    return true;
+                }
+
+            private:
+                /**
+                 * @brief assemble the requested range from cached lines. the caller holds the lock.
+                 */
+                FC2_TEAM_FORCE_INLINE void copy(const unsigned long long first, const unsigned long long last, const unsigned long long address, void* output, const std::size_t size)
+                {
+                    auto out = static_cast<unsigned char*>(output);
+                    for (auto base = first; base <= last; base += FC2_TEAM_READ_CACHE_LINE_SIZE)
+                    {
+                        const auto begin = std::max(base, address);
+                        const auto end = std::min(base + FC2_TEAM_READ_CACHE_LINE_SIZE, address + size);
+                        memcpy(out + (begin - address), lines.at(base).data + (begin - base), static_cast<std::size_t>(end - begin));
+                    }
+                }
+            };
+
+            /**
+             * @brief turn caching of `read_memory` on or off. off by default.
+             */
+            FC2T_FUNCTION void enable(const bool value)
             {
-                detail::helper::safe_copy(data.name, name, sizeof data.name);
-                data.partition = partition;
+                table::get()->enabled.store(value, std::memory_order_relaxed);
+                if (!value)
+                {
+                    table::get()->clear();
+                }
             }
 
-            auto ret = detail::client::send(FC2_TEAM_REQUESTS_GET_MODULE, data);
+            FC2T_FUNCTION auto enabled() -> bool
+            {
+                return table::get()->enabled.load(std::memory_order_relaxed);
+            }
 
             /**
-             * @brief module not found or attach never worked.
+             * @brief everything read so far expires. call this once per frame.
              */
-            if (!ret.status)
+            FC2T_FUNCTION void next_frame()
             {
-                return std::make_pair(0ULL, 0ULL);
+                table::get()->epoch.fetch_add(1, std::memory_order_relaxed);
             }
 
-            return std::make_pair(ret.base, ret.size);
-        }
+            /**
+             * @brief lines also expire this long after they were fetched. zero (default) keeps them until `next_frame`.
+             */
+            FC2T_FUNCTION void set_ttl(const std::chrono::steady_clock::duration ttl)
+            {
+                table::get()->ttl.store(ttl.count(), std::memory_order_relaxed);
+            }
 
-        /**
-         * @brief pattern scan from a module retrieved from get_module (IDA-style only)
-         *
-         * @param module this should be the same module name from get_module.
-         * @param pattern IDA-style pattern only.
-         * @param offset
-         * @param is_x64 set this false if the target process is x86
-         * @param relative
-         * @param ds data segment
-         * @return
-         */
-        FC2T_FUNCTION auto pattern(const std::string& module, const std::string& pattern, const unsigned int offset, const bool is_x64 = true, const bool relative = true, bool ds = false) -> unsigned long long
-        {
-            detail::requests::pattern data;
+            FC2T_FUNCTION void clear()
             {
-                detail::helper::safe_copy(data.module, module, sizeof data.module);
-                detail::helper::safe_copy(data.sig_pattern, pattern, sizeof data.sig_pattern);
+                table::get()->clear();
+            }
 
-                data.offset = offset;
-                data.is_x64 = is_x64;
-                data.relative = relative;
-                data.ds = ds;
+            FC2T_FUNCTION auto get_stats() -> summary
+            {
+                const auto t = table::get();
+
+                summary output;
+                output.hits = t->hits.load(std::memory_order_relaxed);
+                output.misses = t->misses.load(std::memory_order_relaxed);
+                output.bytes_saved = t->bytes_saved.load(std::memory_order_relaxed);
+                output.bytes_fetched = t->bytes_fetched.load(std::memory_order_relaxed);
+                return output;
             }
 
-            auto ret = detail::client::send(FC2_TEAM_REQUESTS_PATTERN, data);
-            return ret.result;
+            FC2T_FUNCTION void reset_stats()
+            {
+                const auto t = table::get();
+                t->hits.store(0, std::memory_order_relaxed);
+                t->misses.store(0, std::memory_order_relaxed);
+                t->bytes_saved.store(0, std::memory_order_relaxed);
+                t->bytes_fetched.store(0, std::memory_order_relaxed);
+            }
         }
 
         /**
@@ -1204,18 +5533,30 @@ namespace fc2
         template< typename t >
         FC2T_FUNCTION auto read_memory(unsigned long long address) -> std::optional< t >
         {
-            detail::requests::read_memory data;
+            static_assert(sizeof(t) <= FC2_TEAM_MAX_DATA_BUFFER, "read_memory is limited to FC2_TEAM_MAX_DATA_BUFFER bytes");
+
+            if (cache::enabled())
+            {
+                t output;
+                if (cache::table::get()->read(address, &output, sizeof(t)))
+                {
+                    return output;
+                }
+            }
+
+            detail::transaction< detail::requests::read_memory > tx(FC2_TEAM_REQUESTS_READ_MEMORY);
+            if (!tx)
             {
-                data.address = address;
-                data.size = sizeof(t);
+                return std::nullopt;
             }
 
-            const auto ret = detail::client::send(FC2_TEAM_REQUESTS_READ_MEMORY, data);
+            tx->address = address;
+            tx->size = sizeof(t);
 
             /**
              * @brief operation failed.
              */
-            if (!ret.bytes_read)
+            if (!tx.submit() || !tx->bytes_read)
             {
                 return std::nullopt;
             }
@@ -1223,7 +5564,7 @@ namespace fc2
             /**
              * @brief data mismatch
              */
-            if (ret.bytes_read != data.size)
+            if (tx->bytes_read != sizeof(t))
             {
                 return std::nullopt;
             }
@@ -1232,10 +5573,127 @@ namespace fc2
             // return *reinterpret_cast< t * >( ret.data );
 
             t output;
-            memcpy(&output, ret.data, sizeof(t));
+            memcpy(&output, tx->data, sizeof(t));
             return output;
         }
 
+        /**
+         * @brief non-blocking version of `read_memory`
+         * @tparam t
+         * @param address
+         * @param timeout
+         * @return
+         */
+        template< typename t >
+        FC2T_FUNCTION auto read_memory_async(unsigned long long address, const std::chrono::steady_clock::duration timeout = detail::async::default_timeout(FC2_TEAM_REQUESTS_READ_MEMORY)) -> async::request< t >
+        {
+            static_assert(sizeof(t) <= FC2_TEAM_MAX_DATA_BUFFER, "read_memory is limited to FC2_TEAM_MAX_DATA_BUFFER bytes");
+
+            auto op = detail::async::make< t >(FC2_TEAM_REQUESTS_READ_MEMORY, timeout,
+                [address](void* payload)
+                {
+                    auto req = new (payload) detail::requests::read_memory{};
+                    req->address = address;
+                    req->size = sizeof(t);
+                },
+                [](const void* payload) -> std::optional< t >
+                {
+                    /**
+                     * @brief a failed read leaves the result empty, same as `read_memory`
+                     */
+                    const auto req = static_cast<const detail::requests::read_memory*>(payload);
+                    if (req->bytes_read != sizeof(t))
+                    {
+                        return std::nullopt;
+                    }
+
+                    t output;
+                    memcpy(&output, req->data, sizeof(t));
+                    return output;
+                });
+
+            return async::request< t >(op);
+        }
+
+        /**
+         * @brief reads the same type from many addresses, e.g. every entry of an entity list
+         * @tparam t
+         * @param addresses
+         * @return one result per address, empty if that read failed
+         */
+        template< typename t >
+        FC2T_FUNCTION auto read_memory_many(const std::vector< unsigned long long >& addresses) -> std::vector< std::optional< t > >
+        {
+            std::vector< t > values(addresses.size());
+
+            gather reads;
+            for (std::size_t i = 0; i < addresses.size(); i++)
+            {
+                reads.add(addresses[i], values[i]);
+            }
+
+            reads.execute();
+
+            std::vector< std::optional< t > > output(addresses.size());
+            for (std::size_t i = 0; i < addresses.size(); i++)
+            {
+                if (reads.succeeded(i))
+                {
+                    output[i] = values[i];
+                }
+            }
+
+            return output;
+        }
+
+        /**
+         * @brief where a member of `c` lives, relative to the remote object
+         */
+        template< typename c, typename m >
+        struct field
+        {
+            m c::* member;
+            unsigned long long offset = 0;
+        };
+
+        /**
+         * @brief reads a struct whose members are scattered across a remote object, in one round trip if the server supports it.
+         *
+         * @code
+         *
+         * struct player
+         * {
+         *      int health;
+         *      float origin[3];
+         * };
+         *
+         * auto p = fc2::engine::read_struct< player >( address,
+         *      fc2::engine::field< player, int >{ &player::health, 0x100 },
+         *      fc2::engine::field< player, float[3] >{ &player::origin, 0x134 }
+         * );
+         *
+         * @endcode
+         *
+         * @tparam c local layout, members not described keep their default value
+         * @return empty if any member couldn't be read
+         */
+        template< typename c, typename... m >
+        FC2T_FUNCTION auto read_struct(const unsigned long long address, const field< c, m >&... fields) -> std::optional< c >
+        {
+            static_assert((std::is_trivially_copyable_v< m > && ...), "read_struct can only read trivially copyable members");
+
+            c output{};
+
+            gather reads;
+            (reads.add(address + fields.offset, output.*(fields.member)), ...);
+
+            if (!reads.execute())
+            {
+                return std::nullopt;
+            }
+
+            return output;
+        }
     }
 
     /**
@@ -1250,6 +5708,11 @@ namespace fc2
          */
         FC2T_FUNCTION auto get(const std::string& url) -> std::string
         {
+            if (detail::client::get()->supports(FC2_TEAM_EXTENSION_HTTP_STREAM))
+            {
+                return detail::stream::collect(FC2_TEAM_REQUESTS_HTTP_REQUEST, url, {}).value_or(std::string());
+            }
+
             detail::requests::http data;
             {
                 detail::helper::safe_copy(data.url, url, sizeof data.url);
@@ -1259,6 +5722,52 @@ namespace fc2
             return ret.response;
         }
 
+        /**
+         * @brief GET request answered from memory if the same url was requested less than `max_age` ago, see `fc2::api`
+         * @param url
+         * @param max_age
+         * @return
+         */
+        FC2T_FUNCTION auto get(const std::string& url, const std::chrono::steady_clock::duration max_age) -> std::string
+        {
+            return detail::responses::get()->request(FC2_TEAM_REQUESTS_HTTP_REQUEST, url, max_age, [&url]
+                {
+                    /**
+                     * @brief a stream the server broke off returns an empty string without an error, it must not be cached as an empty response
+                     */
+                    if (detail::client::get()->supports(FC2_TEAM_EXTENSION_HTTP_STREAM))
+                    {
+                        auto response = detail::stream::collect(FC2_TEAM_REQUESTS_HTTP_REQUEST, url, {});
+                        const auto ok = response.has_value();
+                        return std::make_pair(std::move(response).value_or(std::string()), ok);
+                    }
+
+                    auto response = get(url);
+                    return std::make_pair(std::move(response), get_error() == FC2_TEAM_ERROR_NO_ERROR);
+                });
+        }
+
+        /**
+         * @brief non-blocking GET request
+         * @param url
+         * @param timeout
+         * @return
+         */
+        FC2T_FUNCTION auto get_async(const std::string& url, const std::chrono::steady_clock::duration timeout = detail::async::default_timeout(FC2_TEAM_REQUESTS_HTTP_REQUEST)) -> async::request< std::string >
+        {
+            return async::request< std::string >(detail::async::make< std::string >(FC2_TEAM_REQUESTS_HTTP_REQUEST, timeout,
+                [url](void* payload)
+                {
+                    auto req = new (payload) detail::requests::http{};
+                    detail::helper::safe_copy(req->url, url, sizeof req->url);
+                },
+                [](const void* payload)
+                {
+                    const auto& response = static_cast<const detail::requests::http*>(payload)->response;
+                    return std::string(response, strnlen(response, sizeof response));
+                }));
+        }
+
         /**
          * @brief POST request
          * @param url
@@ -1267,6 +5776,11 @@ namespace fc2
          */
         FC2T_FUNCTION auto post(const std::string& url, const std::string& post_data) -> std::string
         {
+            if (detail::client::get()->supports(FC2_TEAM_EXTENSION_HTTP_STREAM))
+            {
+                return detail::stream::collect(FC2_TEAM_REQUESTS_HTTP_REQUEST, url, post_data).value_or(std::string());
+            }
+
             detail::requests::http data;
             {
                 detail::helper::safe_copy(data.url, url, sizeof data.url);
@@ -1277,6 +5791,45 @@ namespace fc2
             return ret.response;
         }
 
+        /**
+         * @brief GET request that hands the response to `sink` chunk by chunk, see `fc2::api_stream`
+         * @param url
+         * @param sink called with `( const char* data, std::size_t size )` for every chunk, in order
+         * @return false if the request failed
+         */
+        template< typename sink_t >
+        FC2T_FUNCTION auto get_stream(const std::string& url, sink_t&& sink) -> bool
+        {
+            if (detail::client::get()->supports(FC2_TEAM_EXTENSION_HTTP_STREAM))
+            {
+                return detail::stream::receive(FC2_TEAM_REQUESTS_HTTP_REQUEST, url, {}, sink);
+            }
+
+            const auto response = get(url);
+            sink(response.data(), response.size());
+            return get_error() == FC2_TEAM_ERROR_NO_ERROR;
+        }
+
+        /**
+         * @brief POST request that hands the response to `sink` chunk by chunk, see `fc2::api_stream`
+         * @param url
+         * @param post_data
+         * @param sink
+         * @return false if the request failed
+         */
+        template< typename sink_t >
+        FC2T_FUNCTION auto post_stream(const std::string& url, const std::string& post_data, sink_t&& sink) -> bool
+        {
+            if (detail::client::get()->supports(FC2_TEAM_EXTENSION_HTTP_STREAM))
+            {
+                return detail::stream::receive(FC2_TEAM_REQUESTS_HTTP_REQUEST, url, post_data, sink);
+            }
+
+            const auto response = post(url, post_data);
+            sink(response.data(), response.size());
+            return get_error() == FC2_TEAM_ERROR_NO_ERROR;
+        }
+
         /**
          * @brief escapes a string so it can be properly encoded for GET or POST requests
          * @param str
@@ -1294,6 +5847,50 @@ namespace fc2
         }
     }
 
+    /**
+     * @brief counters of the response cache behind `fc2::api( url, max_age )` and `fc2::http::get( url, max_age )`
+     */
+    namespace response_cache
+    {
+        struct summary
+        {
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+
+            /**
+             * @brief requests that waited for an identical request already in flight
+             */
+            std::uint64_t coalesced = 0;
+        };
+
+        FC2T_FUNCTION auto get_stats() -> summary
+        {
+            const auto r = detail::responses::get();
+
+            summary output;
+            output.hits = r->hits.load(std::memory_order_relaxed);
+            output.misses = r->misses.load(std::memory_order_relaxed);
+            output.coalesced = r->coalesced.load(std::memory_order_relaxed);
+            return output;
+        }
+
+        FC2T_FUNCTION void reset_stats()
+        {
+            const auto r = detail::responses::get();
+            r->hits.store(0, std::memory_order_relaxed);
+            r->misses.store(0, std::memory_order_relaxed);
+            r->coalesced.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief forget every cached response
+         */
+        FC2T_FUNCTION void clear()
+        {
+            detail::responses::get()->clear();
+        }
+    }
+
     /**
      * @brief mouse simulation
      */
@@ -1,5 +1,6 @@
 #include "UI.hpp"
 #include "Config.hpp"
+#include "Health.hpp"
 
 int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPWSTR lpCmdLine, _In_ int nShowCmd)
 {
@@ -21,6 +22,9 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     // since Windows 10 version 2004 this doesn't affect the global timer resolution anymore
     timeBeginPeriod(1);
 
+    // keep an eye on the connection to Constellation in the background
+    Health::Start();
+
     // create settings window
     UI::RenderSettingsWindow();
 
@@ -28,6 +32,8 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     if (Config::bCreateOverlay)
         UI::RenderOverlay();
 
+    Health::Stop();
+
     // close mutex so new instances can get launched
     CloseHandle(mutex);
 
@@ -0,0 +1,141 @@
+/**
+ * @brief fc2::async requests against the stand-in server: many in flight from several threads, cancellation and timeouts
+ *
+ * the reactor locks a lane in one `poll` and unlocks it in a later one, which may run on another thread. every test
+ * here drives it from several threads on purpose.
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    auto label(const int thread, const int i) -> std::string
+    {
+        return "thread " + std::to_string(thread) + " request " + std::to_string(i);
+    }
+
+    /**
+     * @brief every thread queues its own requests and waits for them with `get`, which polls on that thread. one more thread sends blocking calls on the same lane.
+     */
+    void concurrent(standin::server& server)
+    {
+        constexpr int threads = 4;
+        constexpr int count = 50;
+
+        server.set_latency(std::chrono::microseconds(200), std::chrono::microseconds(200));
+        const auto served = server.served(FC2_TEAM_REQUESTS_CALL);
+
+        std::atomic< int > wrong{ 0 };
+        std::vector< std::thread > workers;
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([t, &wrong]
+                {
+                    std::vector< fc2::async::request< std::string > > pending;
+                    for (int i = 0; i < count; ++i)
+                    {
+                        pending.push_back(fc2::async::call< std::string >(label(t, i), FC2_LUA_TYPE_STRING));
+                    }
+
+                    for (int i = 0; i < count; ++i)
+                    {
+                        wrong += pending[i].get() != label(t, i);
+                    }
+                });
+        }
+
+        workers.emplace_back([&wrong]
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    wrong += fc2::call< std::string >(label(threads, i), FC2_LUA_TYPE_STRING) != label(threads, i);
+                }
+            });
+
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        CHECK(wrong == 0);
+        CHECK(server.served(FC2_TEAM_REQUESTS_CALL) - served == (threads + 1) * count);
+        CHECK(!fc2::async::poll());
+
+        server.set_latency(std::chrono::microseconds(0));
+    }
+
+    /**
+     * @brief a cancelled request that is in flight keeps its lane until it is answered, one that is still queued is never sent
+     */
+    void cancellation(standin::server& server)
+    {
+        server.set_latency(std::chrono::milliseconds(30));
+        const auto served = server.served(FC2_TEAM_REQUESTS_CALL);
+
+        const auto first = fc2::async::call< std::string >("first", FC2_LUA_TYPE_STRING);
+        const auto second = fc2::async::call< std::string >("second", FC2_LUA_TYPE_STRING);
+
+        CHECK(fc2::async::poll());
+        first.cancel();
+        second.cancel();
+
+        std::thread([&]
+            {
+                while (fc2::async::poll())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }).join();
+
+        CHECK(first.ready());
+        CHECK(second.ready());
+        CHECK(!first.get());
+        CHECK(!second.get());
+        CHECK(server.served(FC2_TEAM_REQUESTS_CALL) - served == 1);
+
+        server.set_latency(std::chrono::microseconds(0));
+        CHECK(fc2::async::call< std::string >("third", FC2_LUA_TYPE_STRING).get() == "third");
+    }
+
+    /**
+     * @brief a request in flight times out at its deadline, one queued behind it times out while waiting for its turn. the client reconnects afterwards.
+     */
+    void timeouts(standin::server& server)
+    {
+        server.hold(true);
+
+        const auto generation = fc2::get_generation();
+        const auto start = std::chrono::steady_clock::now();
+        const auto posted = fc2::async::call< std::string >("posted", FC2_LUA_TYPE_STRING, "", std::chrono::milliseconds(100));
+        const auto queued = fc2::async::call< std::string >("queued", FC2_LUA_TYPE_STRING, "", std::chrono::milliseconds(50));
+
+        std::optional< std::string > results[2];
+        std::thread other([&] { results[1] = queued.get(); });
+        results[0] = posted.get();
+        other.join();
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        CHECK(!results[0]);
+        CHECK(!results[1]);
+        CHECK(elapsed >= std::chrono::milliseconds(100));
+        CHECK(elapsed < std::chrono::seconds(1));
+
+        server.hold(false);
+
+        CHECK(fc2::async::call< std::string >("after", FC2_LUA_TYPE_STRING).get() == "after");
+        CHECK(fc2::get_error() == FC2_TEAM_ERROR_NO_ERROR);
+        CHECK(fc2::get_generation() > generation);
+    }
+}
+
+int main()
+{
+    standin::server server;
+    CHECK(static_cast<bool>(server));
+
+    concurrent(server);
+    cancellation(server);
+    timeouts(server);
+
+    return check::result();
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+/**
+ * @brief fc2::engine::cache serves repeated reads of a frame from its lines and drops them when they may be stale
+ *
+ * a read is fetched once per frame, and again after `next_frame`, after the ttl and after `engine::attach`, which may
+ * have replaced the process the lines were read from.
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    constexpr unsigned long long base = 0x140001000ull;
+
+    auto round_trips(standin::server& server) -> std::uint64_t
+    {
+        return server.served(FC2_TEAM_REQUESTS_READ_MEMORY) + server.served(FC2_TEAM_REQUESTS_READ_MEMORY_MANY);
+    }
+
+    /**
+     * @brief reads the same int and a neighbour of it, both have to hold what the image holds
+     * @return round trips they took
+     */
+    auto read_twice(standin::server& server) -> std::uint64_t
+    {
+        const auto before = round_trips(server);
+
+        for (const auto address : { base, base + 4 })
+        {
+            const auto value = fc2::engine::read_memory< std::uint32_t >(address);
+            CHECK(value.has_value());
+
+            std::uint32_t expected = 0;
+            for (unsigned long long i = 0; i < sizeof expected; ++i)
+            {
+                expected |= static_cast<std::uint32_t>(standin::byte_at(address + i)) << (i * 8);
+            }
+
+            CHECK(value && *value == expected);
+        }
+
+        return round_trips(server) - before;
+    }
+}
+
+int main()
+{
+    standin::options opts;
+    opts.capabilities = 1u << FC2_TEAM_EXTENSION_READ_MEMORY_MANY;
+
+    standin::server server(opts);
+    CHECK(static_cast<bool>(server));
+
+    fc2::ping();
+    CHECK(fc2::get_error() == FC2_TEAM_ERROR_NO_ERROR);
+
+    // without the cache every read is a round trip
+    CHECK(read_twice(server) == 2);
+
+    fc2::engine::cache::enable(true);
+    fc2::engine::cache::next_frame();
+
+    CHECK(read_twice(server) == 1);
+    CHECK(read_twice(server) == 0);
+
+    fc2::engine::cache::next_frame();
+    CHECK(read_twice(server) == 1);
+
+    // attaching to a process, even the same one, leaves nothing cached from before
+    CHECK(fc2::engine::attach(std::string("game.exe")));
+    CHECK(read_twice(server) == 1);
+    CHECK(read_twice(server) == 0);
+
+    fc2::engine::cache::set_ttl(std::chrono::milliseconds(20));
+    CHECK(read_twice(server) == 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    CHECK(read_twice(server) == 1);
+
+    const auto stats = fc2::engine::cache::get_stats();
+    CHECK(stats.hits > 0 && stats.misses > 0);
+
+    return check::result();
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+/**
+ * @brief the smallest test harness that does the job: CHECK reports every condition that doesn't hold, a test passes if none failed
+ */
+#ifndef FC2T_CHECK_HPP
+#define FC2T_CHECK_HPP
+
+#include <cstdio>
+
+namespace check
+{
+    inline int failures = 0;
+
+    /**
+     * @brief exit code of a test
+     */
+    inline auto result() -> int
+    {
+        if (failures)
+        {
+            fprintf(stderr, "%d check(s) failed\n", failures);
+        }
+
+        return failures ? 1 : 0;
+    }
+}
+
+#define CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            ++check::failures; \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+        } \
+    } while (0)
+
+#endif
\ No newline at end of file
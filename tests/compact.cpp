@@ -0,0 +1,163 @@
+/**
+ * @brief round trips through the compact drawing encoding, on its own and through the stand-in server
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    using fc2::detail::compact::decode;
+    using fc2::detail::compact::encode;
+
+    auto text(const std::string& value, const std::int32_t size, const std::int32_t x, const std::int32_t y) -> fc2::render
+    {
+        return fc2::draw::primitive::text(value, size, x, y, 10, 20, 30, 40);
+    }
+
+    auto same(const std::vector< fc2::render >& a, const std::vector< fc2::render >& b) -> bool
+    {
+        return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(fc2::render)) == 0);
+    }
+
+    /**
+     * @brief every type with values inside the encoded ranges survives unchanged
+     */
+    void round_trip()
+    {
+        const std::vector< fc2::render > entries = {
+            fc2::draw::primitive::box(-32768, 0, 32767, 1080, 255, 0, 0, 255, 3),
+            fc2::draw::primitive::line(1, 2, 3, 4, 0, 255, 0, 128, 1),
+            fc2::draw::primitive::box_filled(100, 200, 50, 60, 0, 0, 255, 0),
+            text("hello", 26, 500, 600),
+            text("", 13, 0, 0),
+            text(std::string(127, 'x'), 48, -5, -6),
+            fc2::render{},
+        };
+
+        std::vector< std::uint8_t > encoded;
+        encode(entries.data(), entries.size(), encoded);
+
+        std::vector< fc2::render > decoded;
+        CHECK(decode(encoded.data(), encoded.size(), decoded));
+        CHECK(same(entries, decoded));
+
+        /**
+         * @brief only the text is in the pool
+         */
+        CHECK(encoded.size() == sizeof(fc2::detail::compact::header) + entries.size() * sizeof(fc2::detail::compact::primitive) + 5 + 127);
+    }
+
+    /**
+     * @brief values outside of the encoded ranges are clamped instead of wrapping around
+     */
+    void clamping()
+    {
+        const auto entry = fc2::draw::primitive::box(-100000, 100000, 40000, -40000, 300, -1, 256, 1000, 70000);
+
+        std::vector< std::uint8_t > encoded;
+        encode(&entry, 1, encoded);
+
+        std::vector< fc2::render > decoded;
+        CHECK(decode(encoded.data(), encoded.size(), decoded));
+        CHECK(decoded.size() == 1);
+
+        const auto& d = decoded[0];
+        CHECK(d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_LEFT] == INT16_MIN);
+        CHECK(d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_TOP] == INT16_MAX);
+        CHECK(d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_RIGHT] == INT16_MAX);
+        CHECK(d.dimensions[FC2_TEAM_DRAW_DIMENSIONS_BOTTOM] == INT16_MIN);
+        CHECK(d.style[FC2_TEAM_DRAW_STYLE_RED] == 255);
+        CHECK(d.style[FC2_TEAM_DRAW_STYLE_GREEN] == 0);
+        CHECK(d.style[FC2_TEAM_DRAW_STYLE_BLUE] == 255);
+        CHECK(d.style[FC2_TEAM_DRAW_STYLE_ALPHA] == 255);
+        CHECK(d.style[FC2_TEAM_DRAW_STYLE_THICKNESS] == INT16_MAX);
+    }
+
+    /**
+     * @brief version 1 dropped the text of everything past the first 64 KB of the pool
+     */
+    void large_pool()
+    {
+        std::vector< fc2::render > entries;
+        for (int i = 0; i < 2000; ++i)
+        {
+            auto label = std::to_string(i);
+            entries.push_back(text(label + std::string(127 - label.size(), 'a' + i % 26), 13, i, i));
+        }
+
+        std::vector< std::uint8_t > encoded;
+        encode(entries.data(), entries.size(), encoded);
+
+        fc2::detail::compact::header h;
+        memcpy(&h, encoded.data(), sizeof h);
+        CHECK(h.pool_size == 2000 * 127);
+
+        std::vector< fc2::render > decoded;
+        CHECK(decode(encoded.data(), encoded.size(), decoded));
+        CHECK(same(entries, decoded));
+    }
+
+    /**
+     * @brief truncated data, another version and text outside of the pool are rejected
+     */
+    void malformed()
+    {
+        const auto entry = text("label", 13, 1, 2);
+
+        std::vector< std::uint8_t > encoded;
+        encode(&entry, 1, encoded);
+
+        std::vector< fc2::render > decoded;
+        CHECK(!decode(encoded.data(), sizeof(fc2::detail::compact::header) - 1, decoded));
+        CHECK(!decode(encoded.data(), encoded.size() - 1, decoded));
+
+        auto old = encoded;
+        old[0] = 1;
+        CHECK(!decode(old.data(), old.size(), decoded));
+
+        auto outside = encoded;
+        fc2::detail::compact::primitive p;
+        memcpy(&p, outside.data() + sizeof(fc2::detail::compact::header), sizeof p);
+        p.text_offset = 1;
+        memcpy(outside.data() + sizeof(fc2::detail::compact::header), &p, sizeof p);
+        CHECK(!decode(outside.data(), outside.size(), decoded));
+
+        CHECK(decode(encoded.data(), encoded.size(), decoded));
+    }
+
+    /**
+     * @brief a scene whose encoding takes several chunks and whose pool is larger than 64 KB, pulled through the server
+     */
+    void through_server()
+    {
+        standin::options opts;
+        opts.capabilities = 1u << FC2_TEAM_EXTENSION_DRAWING_COMPACT;
+
+        standin::server server(opts);
+        CHECK(static_cast<bool>(server));
+
+        std::vector< fc2::render > scene;
+        for (int i = 0; i < 1500; ++i)
+        {
+            scene.push_back(i % 2 ? fc2::draw::primitive::box(i, i, 10, 10, 255, 0, 0, 255, 1) : text(std::string(100, 'a' + i % 26), 13, i, -i));
+        }
+
+        server.set_scene(scene);
+
+        const auto drawn = fc2::draw::get();
+        CHECK(same(scene, drawn));
+        CHECK(server.served(FC2_TEAM_REQUESTS_GET_DRAWING_COMPACT) > 1);
+        CHECK(server.served(FC2_TEAM_REQUESTS_GET_DRAWING) == 0);
+    }
+}
+
+int main()
+{
+    round_trip();
+    clamping();
+    large_pool();
+    malformed();
+    through_server();
+
+    return check::result();
+}
\ No newline at end of file
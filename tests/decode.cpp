@@ -0,0 +1,201 @@
+/**
+ * @brief Drawing::DecodeEntriesSSE2 has to give bit for bit what Drawing::DecodeEntry gives, for every drawing request
+ *
+ * the same slots are decoded once with DecodeEntry alone and once with DecodeEntriesSSE2 for every four of them, and
+ * every field is compared with memcmp. the requests are random, with the values that are easy to get wrong mixed in:
+ * colour channels outside of 0-255, font sizes of zero or below, unknown types and offsets of both signs.
+ */
+#include "check.hpp"
+
+// the decoders and their buckets are private to Drawing
+#define private public
+#include "headless.hpp"
+#undef private
+
+namespace
+{
+    std::mt19937 random(2468);
+
+    auto between(const int low, const int high) -> int
+    {
+        return std::uniform_int_distribution< int >(low, high)(random);
+    }
+
+    /**
+     * @brief a value that is mostly in range, sometimes at or far beyond its edges
+     */
+    auto channel() -> int
+    {
+        switch (between(0, 5))
+        {
+        case 0:
+            return between(-100000, -1);
+        case 1:
+            return between(256, 100000);
+        case 2:
+            return between(0, 1) ? 0 : 255;
+        default:
+            return between(0, 255);
+        }
+    }
+
+    auto make_entry() -> fc2::render
+    {
+        static const int types[] = { FC2_TEAM_DRAW_TYPE_NONE, FC2_TEAM_DRAW_TYPE_BOX, FC2_TEAM_DRAW_TYPE_LINE, FC2_TEAM_DRAW_TYPE_BOX_FILLED,
+            FC2_TEAM_DRAW_TYPE_TEXT, FC2_TEAM_DRAW_TYPE_CIRCLE, FC2_TEAM_DRAW_TYPE_CIRCLE_FILLED, -1, 1000 };
+
+        fc2::render entry{};
+        entry.style[FC2_TEAM_DRAW_STYLE_TYPE] = types[between(0, static_cast<int>(std::size(types)) - 1)];
+        entry.style[FC2_TEAM_DRAW_STYLE_RED] = channel();
+        entry.style[FC2_TEAM_DRAW_STYLE_GREEN] = channel();
+        entry.style[FC2_TEAM_DRAW_STYLE_BLUE] = channel();
+        entry.style[FC2_TEAM_DRAW_STYLE_ALPHA] = channel();
+        entry.style[FC2_TEAM_DRAW_STYLE_THICKNESS] = between(0, 3) ? between(0, 50) : between(-(1 << 30), 1 << 30);
+        entry.style[FC2_TEAM_DRAW_STYLE_FONT_SIZE] = between(0, 2) ? between(-5, 60) : between(-(1 << 30), 1 << 30);
+
+        // large enough that the float conversions round, small enough that subtracting the offsets can't overflow
+        for (auto& dimension : entry.dimensions)
+        {
+            dimension = between(0, 3) ? between(-4000, 4000) : between(-(1 << 30), 1 << 30);
+        }
+
+        return entry;
+    }
+
+    auto same(const Drawing::PrimitiveBucket& a, const Drawing::PrimitiveBucket& b) -> bool
+    {
+        const auto equal = [](const auto& x, const auto& y)
+            {
+                return x.size() == y.size() && memcmp(x.data(), y.data(), x.size() * sizeof(x[0])) == 0;
+            };
+
+        return equal(a.left, b.left) && equal(a.top, b.top) && equal(a.right, b.right) && equal(a.bottom, b.bottom)
+            && equal(a.colors, b.colors) && equal(a.sizes, b.sizes) && equal(a.fontSizes, b.fontSizes);
+    }
+
+    /**
+     * @brief the bucket with its slots, and every field sized like DecodeBucket sizes them
+     */
+    auto make_bucket(const std::vector< std::uint32_t >& slots) -> Drawing::PrimitiveBucket
+    {
+        Drawing::PrimitiveBucket bucket;
+        bucket.slots = slots;
+        bucket.left.resize(slots.size());
+        bucket.top.resize(slots.size());
+        bucket.right.resize(slots.size());
+        bucket.bottom.resize(slots.size());
+        bucket.colors.resize(slots.size());
+        bucket.sizes.resize(slots.size());
+        bucket.fontSizes.resize(slots.size());
+        return bucket;
+    }
+
+#ifdef DRAWING_DECODE_SSE2
+    /**
+     * @brief decodes the same slots both ways under random offsets
+     * @return how many of the runs differed
+     */
+    auto compare(const int runs) -> int
+    {
+        constexpr std::size_t count = 1024;
+
+        int mismatches = 0;
+        for (int run = 0; run < runs; ++run)
+        {
+            Drawing::retainedEntries.clear();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Drawing::retainedEntries.push_back(make_entry());
+            }
+
+            Config::iOffsetLeft = between(-10000, 10000);
+            Config::iOffsetTop = between(-10000, 10000);
+
+            // buckets name their slots in any order, with gaps
+            std::vector< std::uint32_t > slots;
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                if (between(0, 3))
+                {
+                    slots.push_back(i);
+                }
+            }
+
+            std::shuffle(slots.begin(), slots.end(), random);
+            slots.resize(slots.size() / 4 * 4);
+
+            auto scalar = make_bucket(slots);
+            for (std::size_t i = 0; i < slots.size(); ++i)
+            {
+                Drawing::DecodeEntry(scalar, i);
+            }
+
+            auto sse2 = make_bucket(slots);
+            for (std::size_t i = 0; i < slots.size(); i += 4)
+            {
+                Drawing::DecodeEntriesSSE2(sse2, i);
+            }
+
+            if (!same(scalar, sse2) && ++mismatches <= 5)
+            {
+                fprintf(stderr, "run %d: the SSE2 decode differs, offsets %d %d\n", run, Config::iOffsetLeft, Config::iOffsetTop);
+            }
+        }
+
+        return mismatches;
+    }
+#endif
+
+    /**
+     * @brief DecodeBucket splits a bucket of any size into groups of four and a scalar tail, every split has to give the scalar result
+     */
+    void tails()
+    {
+        Config::iOffsetLeft = 7;
+        Config::iOffsetTop = -3;
+
+        Drawing::retainedEntries.clear();
+        for (int i = 0; i < 16; ++i)
+        {
+            Drawing::retainedEntries.push_back(make_entry());
+        }
+
+        for (std::uint32_t count = 0; count <= 16; ++count)
+        {
+            std::vector< std::uint32_t > slots;
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                slots.push_back(15 - i);
+            }
+
+            auto scalar = make_bucket(slots);
+            for (std::size_t i = 0; i < slots.size(); ++i)
+            {
+                Drawing::DecodeEntry(scalar, i);
+            }
+
+            Drawing::PrimitiveBucket bucket;
+            bucket.slots = slots;
+            Drawing::DecodeBucket(bucket);
+
+            CHECK(same(scalar, bucket));
+        }
+    }
+}
+
+int main()
+{
+    tails();
+
+#ifdef DRAWING_DECODE_SSE2
+    constexpr int runs = 200;
+    const auto mismatches = compare(runs);
+    CHECK(mismatches == 0);
+
+    printf("%d runs of 1024 slots: %d differ\n", runs, mismatches);
+#else
+    printf("built without DRAWING_DECODE_SSE2, only the scalar decode was checked\n");
+#endif
+
+    return check::result();
+}
\ No newline at end of file
@@ -0,0 +1,253 @@
+/**
+ * @brief replays frame sequences through Drawing::DrawOverlay and checks that the retained geometry it splices together
+ * is exactly what drawing every slot straight away gives
+ *
+ * after every frame the slots are drawn once more one by one through ImGui's own AddRect, AddLine and so on into a draw
+ * list of their own, and once more with DrawSlotsDirectly, which writes boxes and lines without ImGui. the lists are
+ * resolved into triangles through their commands and index buffers, so only the vertices, their clip rectangle and their
+ * texture have to match, not where the commands got split. some boxes and lines are too thick for ImGui's baked line
+ * texture and have to be left to ImGui. the sequences move, add, empty and drop slots, and change
+ * the window offsets and display size, which throws all retained geometry away.
+ */
+#include "check.hpp"
+
+// the retained state and the direct path are private to Drawing
+#define private public
+#include "headless.hpp"
+#undef private
+
+namespace
+{
+    std::mt19937 random(4321);
+
+    auto pick(const int n) -> int
+    {
+        return std::uniform_int_distribution< int >(0, n - 1)(random);
+    }
+
+    auto make_entry() -> fc2::render
+    {
+        const auto x = pick(2000) - 40;
+        const auto y = pick(1100) - 20;
+        const auto thickness = pick(10) == 0 ? 60 + pick(10) : 1 + pick(5);
+
+        fc2::render entry{};
+        switch (pick(7))
+        {
+        case 0:
+            return fc2::draw::primitive::box(x, y, pick(200), pick(200), pick(256), pick(256), pick(256), pick(256), thickness);
+        case 1:
+            return fc2::draw::primitive::line(x, y, pick(1900), pick(1060), pick(256), pick(256), pick(256), pick(256), thickness);
+        case 2:
+            return fc2::draw::primitive::box_filled(x, y, pick(200), pick(200), pick(256), pick(256), pick(256), pick(256));
+        case 3:
+            entry = fc2::draw::primitive::text("label " + std::to_string(pick(100000)), 0, x, y, pick(256), pick(256), pick(256), 255);
+            entry.style[FC2_TEAM_DRAW_STYLE_FONT_SIZE] = pick(4) == 0 ? pick(60) - 5 : 0;
+            return entry;
+        case 4:
+        case 5:
+            entry = fc2::draw::primitive::box(x, y, pick(200), 0, pick(256), pick(256), pick(256), 255, 1 + pick(5));
+            entry.style[FC2_TEAM_DRAW_STYLE_TYPE] = pick(2) ? FC2_TEAM_DRAW_TYPE_CIRCLE : FC2_TEAM_DRAW_TYPE_CIRCLE_FILLED;
+            return entry;
+        default:
+            // an unknown type draws nothing, like an empty slot
+            entry.style[FC2_TEAM_DRAW_STYLE_TYPE] = pick(2) ? FC2_TEAM_DRAW_TYPE_NONE : 1000;
+            return entry;
+        }
+    }
+
+    /**
+     * @brief what a game usually sends: most slots keep their content for a while, some move every frame, now and then
+     * slots appear, disappear or the whole set gets replaced
+     */
+    void mutate(std::vector< fc2::render >& entries, const int frame)
+    {
+        if (frame % 150 == 149)
+        {
+            for (auto& entry : entries)
+            {
+                entry = make_entry();
+            }
+
+            return;
+        }
+
+        for (int i = pick(10); i > 0 && !entries.empty(); --i)
+        {
+            auto& entry = entries[pick(static_cast<int>(entries.size()))];
+            entry.dimensions[0] += pick(9) - 4;
+            entry.dimensions[1] += pick(9) - 4;
+        }
+
+        switch (pick(8))
+        {
+        case 0:
+            for (int i = pick(8) + 1; i > 0; --i)
+            {
+                entries.push_back(make_entry());
+            }
+            break;
+        case 1:
+            entries.resize(entries.size() - std::min< std::size_t >(entries.size(), pick(8) + 1));
+            break;
+        case 2:
+            for (int i = pick(4) + 1; i > 0 && !entries.empty(); --i)
+            {
+                entries[pick(static_cast<int>(entries.size()))] = fc2::render{};
+            }
+            break;
+        case 3:
+            for (int i = pick(6) + 1; i > 0 && !entries.empty(); --i)
+            {
+                entries[pick(static_cast<int>(entries.size()))] = make_entry();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    /**
+     * @brief one vertex of a triangle and the state it gets drawn with
+     */
+    struct drawn
+    {
+        ImDrawVert vertex;
+        ImVec4 clip;
+        ImTextureID texture;
+    };
+
+    auto resolve(const ImDrawList& list) -> std::vector< drawn >
+    {
+        std::vector< drawn > output;
+        for (const auto& command : list.CmdBuffer)
+        {
+            for (unsigned int i = 0; i < command.ElemCount; ++i)
+            {
+                const auto index = list.IdxBuffer[static_cast<int>(command.IdxOffset + i)];
+                output.push_back({ list.VtxBuffer[static_cast<int>(command.VtxOffset + index)], command.ClipRect, command.TextureId });
+            }
+        }
+
+        return output;
+    }
+
+    auto same(const std::vector< drawn >& a, const std::vector< drawn >& b) -> bool
+    {
+        for (std::size_t i = 0; i < a.size() && i < b.size(); ++i)
+        {
+            if (memcmp(&a[i].vertex, &b[i].vertex, sizeof(ImDrawVert)) != 0 || memcmp(&a[i].clip, &b[i].clip, sizeof(ImVec4)) != 0 || a[i].texture != b[i].texture)
+            {
+                return false;
+            }
+        }
+
+        return a.size() == b.size();
+    }
+
+    /**
+     * @brief a draw list set up like the background list of this frame
+     */
+    void begin(ImDrawList& list)
+    {
+        const ImGuiIO& io = ImGui::GetIO();
+
+        list._ResetForNewFrame();
+        list.Flags = ImGui::GetBackgroundDrawList()->Flags;
+        list.PushTextureID(io.Fonts->TexID);
+        list.PushClipRectFullScreen();
+        list.PushClipRect({ 0.0f - Config::iOffsetLeft, 0.0f - Config::iOffsetTop }, { io.DisplaySize.x + Config::iOffsetRight, io.DisplaySize.y + Config::iOffsetBottom });
+    }
+
+    /**
+     * @brief the background list of this frame and the slots drawn with DrawSlotsDirectly against the same slots drawn
+     * one by one through ImGui
+     */
+    auto frame_matches() -> bool
+    {
+        ImDrawList direct(ImGui::GetDrawListSharedData());
+        begin(direct);
+        Drawing::DrawSlotsDirectly(&direct);
+        direct.PopClipRect();
+
+        // DrawSlotsDirectly left the slots decoded in retainedDirect
+        ImDrawList reference(ImGui::GetDrawListSharedData());
+        begin(reference);
+        const auto& bucket = Drawing::retainedDirect;
+        for (std::size_t i = 0; i < bucket.slots.size(); ++i)
+        {
+            Drawing::DrawPrimitive(&reference, Drawing::retainedEntries[bucket.slots[i]].style[FC2_TEAM_DRAW_STYLE_TYPE], bucket, i);
+        }
+        reference.PopClipRect();
+
+        const auto expected = resolve(reference);
+        return same(resolve(*ImGui::GetBackgroundDrawList()), expected) && same(resolve(direct), expected);
+    }
+
+    void replay(const char* name, const int frames, const bool window)
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        auto& entries = headless::snapshot.entries;
+
+        entries.clear();
+        for (int i = 0; i < 300; ++i)
+        {
+            entries.push_back(make_entry());
+        }
+
+        int mismatches = 0;
+        int spliced = 0;
+        int direct = 0;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            mutate(entries, frame);
+
+            // the target window moved or got resized
+            if (window && frame % 97 == 50)
+            {
+                Config::iOffsetLeft = pick(10);
+                Config::iOffsetTop = pick(10);
+                Config::iOffsetRight = pick(10);
+                Config::iOffsetBottom = pick(10);
+            }
+
+            if (window && frame % 131 == 70)
+            {
+                io.DisplaySize = ImVec2(static_cast<float>(1900 + pick(40)), static_cast<float>(1000 + pick(80)));
+            }
+
+            const auto hits = Drawing::retainedHits;
+
+            ImGui::NewFrame();
+            Drawing::DrawOverlay();
+
+            if (!frame_matches() && ++mismatches <= 5)
+            {
+                fprintf(stderr, "%s: frame %d differs from drawing it directly\n", name, frame);
+            }
+
+            (Drawing::retainedHits != hits ? spliced : direct)++;
+            ImGui::EndFrame();
+        }
+
+        CHECK(mismatches == 0);
+
+        // both paths have to be covered, otherwise the sequence compares the direct path with itself
+        CHECK(spliced > frames / 2);
+        CHECK(direct > 0);
+
+        printf("%-8s %d frames: %d spliced, %d drawn directly, %d differ\n", name, frames, spliced, direct, mismatches);
+    }
+}
+
+int main()
+{
+    headless::start(ImVec2(1920.0f, 1080.0f));
+
+    replay("slots", 600, false);
+    replay("window", 600, true);
+
+    headless::stop();
+
+    return check::result();
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+/**
+ * @brief fc2::engine::gather against the stand-in's memory image: overlapping ranges, reads split into several pieces
+ * and requests, unmapped memory and reads that run into it
+ *
+ * usage: fc2t-test-gather [serial]
+ *
+ * every byte the stand-in reads is a function of its address (standin::byte_at), except for the unmapped 64 KB at
+ * 0xdead0000. a read that starts there returns nothing, one that runs into it returns the bytes before. either has to
+ * fail its own target only. with "serial" the server doesn't understand FC2_TEAM_REQUESTS_READ_MEMORY_MANY and gather
+ * falls back to one `read_memory` request per piece.
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    constexpr unsigned long long base = 0x140001000ull;
+    constexpr unsigned long long unmapped = 0xdead0000ull;
+
+    /**
+     * @brief a read and what the image holds there
+     */
+    struct range
+    {
+        unsigned long long address;
+        std::vector< unsigned char > output;
+        bool readable;
+        std::size_t index = 0;
+    };
+
+    auto expected(const range& r) -> bool
+    {
+        for (std::size_t i = 0; i < r.output.size(); ++i)
+        {
+            if (r.output[i] != standin::byte_at(r.address + i))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief queues every read, executes them twice and checks every output against the image
+     * @return round trips of the last execute
+     */
+    auto run(standin::server& server, std::vector< range >& reads) -> std::uint64_t
+    {
+        fc2::engine::gather gather;
+        for (auto& r : reads)
+        {
+            r.index = gather.add(r.address, r.output.data(), r.output.size());
+        }
+
+        CHECK(gather.size() == reads.size());
+
+        std::uint64_t round_trips = 0;
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (auto& r : reads)
+            {
+                std::fill(r.output.begin(), r.output.end(), static_cast<unsigned char>(0xcc));
+            }
+
+            const auto before = server.served(FC2_TEAM_REQUESTS_READ_MEMORY) + server.served(FC2_TEAM_REQUESTS_READ_MEMORY_MANY);
+            const bool all = gather.execute();
+            round_trips = server.served(FC2_TEAM_REQUESTS_READ_MEMORY) + server.served(FC2_TEAM_REQUESTS_READ_MEMORY_MANY) - before;
+
+            CHECK(all == std::all_of(reads.begin(), reads.end(), [](const range& r) { return r.readable; }));
+
+            for (const auto& r : reads)
+            {
+                CHECK(gather.succeeded(r.index) == r.readable);
+                if (r.readable)
+                {
+                    CHECK(expected(r));
+                }
+            }
+        }
+
+        return round_trips;
+    }
+
+    auto make_read(const unsigned long long address, const std::size_t size) -> range
+    {
+        return { address, std::vector< unsigned char >(size), standin::readable_bytes(address, size) == size };
+    }
+
+    /**
+     * @brief ranges that overlap each other and share the same bytes, in one request
+     */
+    void overlapping(standin::server& server, const bool serial)
+    {
+        std::vector< range > reads;
+        reads.push_back(make_read(base, 64));
+        reads.push_back(make_read(base + 32, 64));
+        reads.push_back(make_read(base + 16, sizeof(int)));
+        reads.push_back(make_read(base, 64));
+        reads.push_back(make_read(base + 63, 1));
+
+        const auto round_trips = run(server, reads);
+        CHECK(round_trips == (serial ? reads.size() : 1));
+    }
+
+    /**
+     * @brief reads larger than a `read_memory` request are split into pieces, and more pieces than a request holds go
+     * into several requests
+     */
+    void split(standin::server& server, const bool serial)
+    {
+        std::vector< range > reads;
+        reads.push_back(make_read(base, 5000));
+        for (unsigned long long i = 0; i < 300; ++i)
+        {
+            reads.push_back(make_read(base + 0x10000 + i * 24, 24));
+        }
+
+        // 5 pieces of the large read and 300 small ones
+        const auto round_trips = run(server, reads);
+        CHECK(round_trips == (serial ? 305u : 2u));
+    }
+
+    /**
+     * @brief reads of unmapped memory, reads that run into it and reads that end right before it, between ones that succeed
+     */
+    void unmapped_memory(standin::server& server)
+    {
+        std::vector< range > reads;
+        reads.push_back(make_read(base, 16));
+        reads.push_back(make_read(unmapped + 0x1000, 8));
+        reads.push_back(make_read(unmapped - 8, 8));
+        reads.push_back(make_read(unmapped - 4, 8));
+        reads.push_back(make_read(unmapped - 1, 2));
+        reads.push_back(make_read(unmapped + 0xfffc, 8));
+        reads.push_back(make_read(unmapped + 0x10000, 8));
+
+        // a large read whose first pieces can be read and whose last ones can't
+        reads.push_back(make_read(unmapped - 3000, 5000));
+        reads.push_back(make_read(base + 64, 16));
+
+        CHECK(reads[0].readable && reads[2].readable && reads[6].readable && reads[8].readable);
+        CHECK(!reads[1].readable && !reads[3].readable && !reads[4].readable && !reads[5].readable && !reads[7].readable);
+
+        run(server, reads);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool serial = argc > 1 && strcmp(argv[1], "serial") == 0;
+
+    standin::options opts;
+    opts.capabilities = serial ? 0u : 1u << FC2_TEAM_EXTENSION_READ_MEMORY_MANY;
+
+    standin::server server(opts);
+    CHECK(static_cast<bool>(server));
+
+    fc2::ping();
+    CHECK(fc2::detail::client::get()->supports(FC2_TEAM_EXTENSION_READ_MEMORY_MANY) == !serial);
+
+    overlapping(server, serial);
+    split(server, serial);
+    unmapped_memory(server);
+
+    return check::result();
+}
\ No newline at end of file
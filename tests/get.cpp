@@ -0,0 +1,88 @@
+/**
+ * @brief fc2::draw::get has to return every drawing request the server has, at 10, 1000 and 10000 of them
+ *
+ * usage: fc2t-test-get [feed] [compact]
+ *
+ * the server streams drawing requests, compact with "compact". with "feed" it also publishes the drawing feed, which
+ * only holds 100 of them: get has to read small scenes from the feed and stream every larger one instead of returning
+ * the first 100.
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    auto make_scene(const int count) -> std::vector< fc2::render >
+    {
+        std::vector< fc2::render > scene;
+        for (int i = 0; i < count; ++i)
+        {
+            const auto x = i * 37 % 1900;
+            const auto y = i * 53 % 1060;
+
+            scene.push_back(i % 3 == 2
+                ? fc2::draw::primitive::text("entry " + std::to_string(i), 13, x, y, 255, 255, 255, 255)
+                : fc2::draw::primitive::box(x, y, 20, 40, 255, i % 256, 0, 255, 1));
+        }
+
+        return scene;
+    }
+
+    auto same(const std::vector< fc2::render >& a, const std::vector< fc2::render >& b) -> bool
+    {
+        return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(fc2::render)) == 0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool feed = false;
+    bool compact = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        feed |= strcmp(argv[i], "feed") == 0;
+        compact |= strcmp(argv[i], "compact") == 0;
+    }
+
+    standin::options opts;
+    opts.capabilities = 1u << (compact ? FC2_TEAM_EXTENSION_DRAWING_COMPACT : FC2_TEAM_EXTENSION_DRAWING_STREAM);
+    opts.feed_interval = std::chrono::microseconds(500);
+    if (feed)
+    {
+        opts.capabilities |= 1u << FC2_TEAM_EXTENSION_DRAWING_FEED;
+    }
+
+    standin::server server(opts);
+    CHECK(static_cast<bool>(server));
+
+    const int streamed = compact ? FC2_TEAM_REQUESTS_GET_DRAWING_COMPACT : FC2_TEAM_REQUESTS_GET_DRAWING_STREAM;
+
+    for (const int count : { 10, 1000, 10000, 10 })
+    {
+        const auto scene = make_scene(count);
+        server.set_scene(scene);
+
+        // the feed publishes the new scene with its next frame
+        if (feed)
+        {
+            std::this_thread::sleep_for(opts.feed_interval * 4);
+        }
+
+        const auto requests = server.served(streamed);
+        const auto drawn = fc2::draw::get();
+        const auto round_trips = server.served(streamed) - requests;
+
+        CHECK(same(scene, drawn));
+
+        // only small scenes can come from the feed, without a round trip
+        CHECK(feed && count <= 100 ? round_trips == 0 : round_trips > 0);
+
+        printf("%5d requests%s%s: %zu returned, %llu round trips\n", count, feed ? ", feed" : "", compact ? ", compact" : "",
+            drawn.size(), static_cast<unsigned long long>(round_trips));
+    }
+
+    // the request path holds 100, it must never be used while the server streams
+    CHECK(server.served(FC2_TEAM_REQUESTS_GET_DRAWING) == 0);
+
+    return check::result();
+}
\ No newline at end of file
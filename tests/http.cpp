@@ -0,0 +1,106 @@
+/**
+ * @brief api and http responses of several MB arrive whole and unchanged
+ *
+ * usage: fc2t-test-http [truncated]
+ *
+ * the stand-in answers with a body of `size=` bytes that depends on the url (standin::body). with
+ * FC2_TEAM_EXTENSION_HTTP_STREAM every response has to come through `fc2::api`, `fc2::api_stream` and `fc2::http::get`
+ * byte for byte, in one chunk per round trip. with "truncated" the server doesn't stream and responses are cut to the
+ * request buffer, as they always were.
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    constexpr std::size_t chunk = sizeof fc2::detail::requests::http_stream::data;
+
+    auto url(const char* path, const std::size_t size) -> std::string
+    {
+        return std::string(path) + "?size=" + std::to_string(size);
+    }
+
+    /**
+     * @brief the response as the client has to return it
+     */
+    auto expected(const std::string& url, const bool truncated) -> std::string
+    {
+        auto body = standin::body(url.c_str(), "");
+        if (truncated && body.size() >= FC2_TEAM_MAX_DATA_BUFFER)
+        {
+            body.resize(FC2_TEAM_MAX_DATA_BUFFER - 1);
+        }
+
+        return body;
+    }
+
+    void check_size(standin::server& server, const std::size_t size, const bool truncated)
+    {
+        // every chunk is a round trip, an empty body still needs one to learn that it's empty
+        const auto chunks = std::max< std::uint64_t >(1, (size + chunk - 1) / chunk);
+
+        const auto api_url = url("getMember&steam&history", size);
+        auto before = server.served(FC2_TEAM_REQUESTS_HTTP_STREAM);
+        CHECK(fc2::api(api_url) == expected(api_url, truncated));
+        CHECK(fc2::get_error() == FC2_TEAM_ERROR_NO_ERROR);
+        CHECK(server.served(FC2_TEAM_REQUESTS_HTTP_STREAM) - before == (truncated ? 0 : chunks));
+
+        const auto http_url = url("https://example.com/large", size);
+        before = server.served(FC2_TEAM_REQUESTS_HTTP_STREAM);
+        CHECK(fc2::http::get(http_url) == expected(http_url, truncated));
+        CHECK(fc2::get_error() == FC2_TEAM_ERROR_NO_ERROR);
+        CHECK(server.served(FC2_TEAM_REQUESTS_HTTP_STREAM) - before == (truncated ? 0 : chunks));
+
+        // the same response handed over chunk by chunk, none of them larger than a request holds
+        std::string streamed;
+        std::size_t largest = 0;
+        const auto ok = fc2::api_stream(api_url, [&](const char* data, const std::size_t length)
+            {
+                streamed.append(data, length);
+                largest = std::max(largest, length);
+            });
+
+        CHECK(ok);
+        CHECK(streamed == expected(api_url, truncated));
+        CHECK(largest <= chunk);
+
+        if (truncated)
+        {
+            printf("%8zu bytes: truncated to %zu\n", size, expected(api_url, true).size());
+        }
+        else
+        {
+            printf("%8zu bytes: %llu chunks\n", size, static_cast<unsigned long long>(chunks));
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool truncated = argc > 1 && strcmp(argv[1], "truncated") == 0;
+
+    standin::options opts;
+    opts.capabilities = truncated ? 0u : 1u << FC2_TEAM_EXTENSION_HTTP_STREAM;
+
+    standin::server server(opts);
+    CHECK(static_cast<bool>(server));
+
+    fc2::ping();
+    CHECK(fc2::detail::client::get()->supports(FC2_TEAM_EXTENSION_HTTP_STREAM) == !truncated);
+
+    for (const std::size_t size : { std::size_t{ 0 }, std::size_t{ 1 }, chunk - 1, chunk, chunk + 1, std::size_t{ 1 } << 20, (std::size_t{ 5 } << 20) + 3 })
+    {
+        check_size(server, size, truncated);
+    }
+
+    // a stream the server refuses is an empty response, not part of one
+    if (!truncated)
+    {
+        std::string streamed;
+        CHECK(!fc2::api_stream(url("fail", 4096), [&](const char* data, const std::size_t length) { streamed.append(data, length); }));
+        CHECK(streamed.empty());
+        CHECK(fc2::http::get(url("https://example.com/fail", 4096)).empty());
+    }
+
+    return check::result();
+}
\ No newline at end of file
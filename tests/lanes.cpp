@@ -0,0 +1,95 @@
+/**
+ * @brief a slow http request must not hold up drawing requests sent at the same time
+ *
+ * usage: fc2t-test-lanes [shared]
+ *
+ * http requests take 100 ms on the server. one thread keeps sending them while the main thread sends drawing requests,
+ * whose wall time per call, including waiting for a request buffer, has to keep its p99 far below the http latency.
+ * with "shared" the server has no lanes and every request goes through the one request buffer. then the drawing
+ * requests have to wait behind the http ones, which shows that the test notices when they do.
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    constexpr auto http_latency = std::chrono::milliseconds(100);
+
+    /**
+     * @brief p99 of the wall time of drawing requests sent for a while, one every 2 ms like frames of an overlay. sent
+     * back to back they would hardly ever let go of a shared request buffer, and the http requests would never get in.
+     */
+    auto draw_p99(const std::chrono::milliseconds duration) -> std::chrono::microseconds
+    {
+        const auto box = fc2::draw::primitive::box(10, 10, 20, 20, 255, 0, 0, 255, 1);
+
+        std::vector< std::chrono::microseconds > times;
+        const auto until = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < until)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            fc2::draw::render(box);
+            times.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+
+        std::sort(times.begin(), times.end());
+        return times[times.size() * 99 / 100];
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool shared = argc > 1 && strcmp(argv[1], "shared") == 0;
+
+    standin::options opts;
+    opts.latency = std::chrono::microseconds(20);
+    opts.request_latency[FC2_TEAM_REQUESTS_HTTP_REQUEST] = http_latency;
+    opts.capabilities = shared ? 0u : 1u << FC2_TEAM_EXTENSION_LANES;
+
+    standin::server server(opts);
+    CHECK(static_cast<bool>(server));
+
+    fc2::ping();
+    CHECK(fc2::get_error() == FC2_TEAM_ERROR_NO_ERROR);
+    CHECK(fc2::detail::client::get()->supports(FC2_TEAM_EXTENSION_LANES) == !shared);
+
+    const auto idle = draw_p99(std::chrono::milliseconds(500));
+
+    std::atomic< bool > running{ true };
+    std::thread http([&running]
+        {
+            while (running)
+            {
+                fc2::http::get("https://example.com/?size=256");
+            }
+        });
+
+    // give the http thread time to get its first request in
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    const auto requests = server.served(FC2_TEAM_REQUESTS_HTTP_REQUEST);
+    const auto loaded = draw_p99(std::chrono::milliseconds(1000));
+    const auto overlapping = server.served(FC2_TEAM_REQUESTS_HTTP_REQUEST) - requests;
+
+    running = false;
+    http.join();
+
+    // the http requests really ran while drawing
+    CHECK(overlapping >= 5);
+
+    if (shared)
+    {
+        CHECK(loaded >= http_latency / 2);
+    }
+    else
+    {
+        CHECK(loaded < http_latency / 10);
+    }
+
+    printf("%s: draw p99 %lld us idle, %lld us with %llu http requests of %lld ms in flight\n", shared ? "shared" : "lanes",
+        static_cast<long long>(idle.count()), static_cast<long long>(loaded.count()), static_cast<unsigned long long>(overlapping),
+        static_cast<long long>(http_latency.count()));
+
+    return check::result();
+}
\ No newline at end of file
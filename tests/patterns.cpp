@@ -0,0 +1,128 @@
+/**
+ * @brief fc2::engine::pattern remembers results on disk, so a restarted overlay doesn't make the server scan again
+ *
+ * every run is a process of its own, forked from this one, with a stand-in server of its own: a cold run scans, a warm
+ * one only scans what can't be cached, a run against the module loaded elsewhere gets the cached results relocated and
+ * one against a changed module scans everything again. the stand-in counts the scans.
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+#include <sys/wait.h>
+
+namespace
+{
+    struct scan
+    {
+        const char* module;
+        const char* pattern;
+        unsigned int offset;
+        bool cached;
+    };
+
+    constexpr scan scans[] =
+    {
+        { "game.exe", "48 8B 05 ? ? ? ? 48 85 C0", 3, true },
+
+        // the same pattern with another offset is another result
+        { "game.exe", "48 8B 05 ? ? ? ? 48 85 C0", 7, true },
+        { "game.exe", "E8 ? ? ? ? 84 C0 74", 1, true },
+
+        // the stand-in finds nothing for "??", and nothing in modules it doesn't know
+        { "game.exe", "48 ?? 05", 0, false },
+        { "other.dll", "48 8B 05", 3, false }
+    };
+
+    /**
+     * @brief one start of an overlay: scans every pattern twice and checks the round trips it took
+     * @param scanned scans the first pass has to make
+     */
+    void run(const unsigned long long base, const unsigned long long size, const std::uint64_t scanned)
+    {
+        standin::options opts;
+        opts.module_base = base;
+        opts.module_size = size;
+
+        standin::server server(opts);
+        CHECK(static_cast<bool>(server));
+
+        const auto uncached = static_cast<std::uint64_t>(std::count_if(std::begin(scans), std::end(scans), [](const scan& s) { return !s.cached; }));
+
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            const auto before = server.served(FC2_TEAM_REQUESTS_PATTERN);
+            for (const auto& s : scans)
+            {
+                const auto expected = s.cached ? base + 0x1000 + s.offset + strlen(s.pattern) : 0;
+                CHECK(fc2::engine::pattern(s.module, s.pattern, s.offset) == expected);
+            }
+
+            CHECK(server.served(FC2_TEAM_REQUESTS_PATTERN) - before == (pass == 0 ? scanned : uncached));
+        }
+
+        // game.exe is looked up and identified once, other.dll every time because it isn't loaded
+        CHECK(server.served(FC2_TEAM_REQUESTS_GET_MODULE) == 1 + 2);
+        CHECK(server.served(FC2_TEAM_REQUESTS_READ_MEMORY) == 1);
+
+        // after an attach the module may be another one
+        CHECK(fc2::engine::attach(std::string("game.exe")));
+        CHECK(fc2::engine::pattern(scans[0].module, scans[0].pattern, scans[0].offset) == base + 0x1000 + scans[0].offset + strlen(scans[0].pattern));
+        CHECK(server.served(FC2_TEAM_REQUESTS_GET_MODULE) == 1 + 2 + 1);
+        CHECK(server.served(FC2_TEAM_REQUESTS_READ_MEMORY) == 2);
+    }
+
+    /**
+     * @brief `run` in a new process, which has to read the cache from the file like a restarted overlay
+     */
+    auto restart(const unsigned long long base, const unsigned long long size, const std::uint64_t scanned) -> bool
+    {
+        fflush(stdout);
+        fflush(stderr);
+
+        const auto pid = fork();
+        if (pid == 0)
+        {
+            run(base, size, scanned);
+            std::exit(check::result());
+        }
+
+        int status = 0;
+        return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+}
+
+int main()
+{
+    constexpr unsigned long long base = 0x140000000ull;
+    constexpr unsigned long long size = 0x200000ull;
+
+    const auto all = static_cast<std::uint64_t>(std::size(scans));
+    const auto uncached = static_cast<std::uint64_t>(std::count_if(std::begin(scans), std::end(scans), [](const scan& s) { return !s.cached; }));
+
+    std::error_code error;
+    const auto file = fc2::detail::helper::executable_directory() / FC2_TEAM_PATTERN_CACHE_FILE;
+    std::filesystem::remove(file, error);
+
+    // cold, then warm
+    CHECK(restart(base, size, all));
+    CHECK(std::filesystem::exists(file, error));
+    CHECK(restart(base, size, uncached));
+
+    // the module loaded elsewhere
+    CHECK(restart(base + 0x10000000, size, uncached));
+
+    // a new build of the module, then warm again
+    CHECK(restart(base, size + 0x10000, all));
+    CHECK(restart(base, size + 0x10000, uncached));
+
+    // a file that isn't a cache is replaced
+    {
+        std::ofstream(file, std::ios::binary | std::ios::trunc) << "not a pattern cache";
+    }
+
+    CHECK(restart(base, size, all));
+    CHECK(restart(base, size, uncached));
+
+    std::filesystem::remove(file, error);
+
+    return check::result();
+}
\ No newline at end of file
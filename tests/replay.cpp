@@ -0,0 +1,204 @@
+/**
+ * @brief replays a random sequence of drawing changes into fc2::draw::table and checks it against the scene after every update
+ *
+ * usage: fc2t-test-replay [delta]
+ *
+ * with "delta" the table patches its slots with FC2_TEAM_REQUESTS_GET_DRAWING_DELTA, otherwise it compares the whole set
+ * every update. both must end up with what the server has, and `changed` must name exactly the slots that changed.
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    std::mt19937 random(1234);
+
+    auto pick(const int n) -> int
+    {
+        return std::uniform_int_distribution< int >(0, n - 1)(random);
+    }
+
+    auto make_entry() -> fc2::render
+    {
+        const auto x = pick(1900);
+        const auto y = pick(1060);
+
+        switch (pick(4))
+        {
+        case 0:
+            return fc2::draw::primitive::box(x, y, pick(100), pick(100), pick(256), pick(256), pick(256), 255, 1 + pick(3));
+        case 1:
+            return fc2::draw::primitive::line(x, y, pick(1900), pick(1060), pick(256), pick(256), pick(256), 255, 1);
+        case 2:
+            return fc2::draw::primitive::box_filled(x, y, pick(100), pick(100), pick(256), pick(256), pick(256), pick(256));
+        default:
+            return fc2::draw::primitive::text("label " + std::to_string(pick(100000)), 13, x, y, 255, 255, 255, 255);
+        }
+    }
+
+    auto used(const std::vector< fc2::render >& entries) -> std::vector< fc2::render >
+    {
+        std::vector< fc2::render > output;
+        std::copy_if(entries.begin(), entries.end(), std::back_inserter(output), [](const fc2::render& e) { return e.style[FC2_TEAM_DRAW_STYLE_TYPE] != FC2_TEAM_DRAW_TYPE_NONE; });
+        return output;
+    }
+
+    auto same(const std::vector< fc2::render >& a, const std::vector< fc2::render >& b) -> bool
+    {
+        return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(fc2::render)) == 0);
+    }
+
+    /**
+     * @brief slots whose content differs between two sets, a missing slot counts as an empty one
+     */
+    auto differences(const std::vector< fc2::render >& before, const std::vector< fc2::render >& after) -> std::vector< std::uint32_t >
+    {
+        const fc2::render empty{};
+        std::vector< std::uint32_t > output;
+        for (std::uint32_t i = 0; i < std::max(before.size(), after.size()); ++i)
+        {
+            const auto& a = i < before.size() ? before[i] : empty;
+            const auto& b = i < after.size() ? after[i] : empty;
+            if (memcmp(&a, &b, sizeof a) != 0)
+            {
+                output.push_back(i);
+            }
+        }
+
+        return output;
+    }
+
+    /**
+     * @brief change a few slots, remove some, grow or shrink the set
+     */
+    void mutate(std::vector< fc2::render >& scene)
+    {
+        switch (pick(6))
+        {
+        case 0:
+            for (int i = pick(4) + 1; i > 0 && !scene.empty(); --i)
+            {
+                scene[pick(static_cast<int>(scene.size()))] = fc2::render{};
+            }
+            break;
+        case 1:
+            for (int i = pick(8) + 1; i > 0; --i)
+            {
+                scene.push_back(make_entry());
+            }
+            break;
+        case 2:
+            scene.resize(scene.size() - std::min< std::size_t >(scene.size(), pick(8) + 1));
+            break;
+        default:
+            for (int i = pick(6) + 1; i > 0 && !scene.empty(); --i)
+            {
+                scene[pick(static_cast<int>(scene.size()))] = make_entry();
+            }
+            break;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool delta = argc > 1 && std::string(argv[1]) == "delta";
+
+    standin::options opts;
+    opts.capabilities = 1u << FC2_TEAM_EXTENSION_DRAWING_STREAM;
+    if (delta)
+    {
+        opts.capabilities |= 1u << FC2_TEAM_EXTENSION_DRAWING_DELTA;
+    }
+
+    standin::server server(opts);
+    CHECK(static_cast<bool>(server));
+
+    std::vector< fc2::render > scene;
+    for (int i = 0; i < 300; ++i)
+    {
+        scene.push_back(make_entry());
+    }
+
+    server.set_scene(scene);
+
+    fc2::draw::table table;
+    int updates = 0;
+    int gets = 0;
+
+    for (int step = 0; step < 300; ++step)
+    {
+        auto before = table.entries();
+
+        /**
+         * @brief sometimes several versions go by between two updates, sometimes none, sometimes the server forgets its history
+         */
+        bool exact = true;
+        if (step % 11 == 5)
+        {
+            mutate(scene);
+            server.set_scene(scene);
+            exact = false;
+        }
+
+        if (step % 13 == 7)
+        {
+            server.forget();
+            exact = false;
+        }
+
+        if (step % 7 != 3)
+        {
+            mutate(scene);
+            server.set_scene(scene);
+        }
+
+        const bool any = table.update();
+        ++updates;
+
+        if (delta)
+        {
+            CHECK(same(table.entries(), scene));
+        }
+        else
+        {
+            CHECK(same(used(table.entries()), used(scene)));
+        }
+
+        /**
+         * @brief deltas over several versions, or after the history was dropped, may name slots that ended up unchanged
+         */
+        const auto expected = differences(before, table.entries());
+        const auto& changed = table.changed();
+        CHECK(any == !changed.empty());
+        CHECK(std::includes(changed.begin(), changed.end(), expected.begin(), expected.end()));
+        if (exact)
+        {
+            CHECK(changed == expected);
+        }
+
+        if (step % 10 == 0)
+        {
+            CHECK(same(fc2::draw::get(), used(scene)));
+            ++gets;
+        }
+    }
+
+    const auto delta_bytes = server.bytes(FC2_TEAM_REQUESTS_GET_DRAWING_DELTA);
+    const auto stream_bytes = server.bytes(FC2_TEAM_REQUESTS_GET_DRAWING_STREAM);
+    const auto table_bytes = delta ? delta_bytes : stream_bytes;
+    printf("%s: %d updates, %llu bytes per update, a full stream is %llu bytes\n", delta ? "delta" : "full", updates,
+        static_cast<unsigned long long>(table_bytes / updates), static_cast<unsigned long long>(stream_bytes / (delta ? gets : updates + gets)));
+
+    if (delta)
+    {
+        CHECK(server.served(FC2_TEAM_REQUESTS_GET_DRAWING_DELTA) > 0);
+        CHECK(delta_bytes / updates < stream_bytes / gets / 4);
+    }
+    else
+    {
+        CHECK(server.served(FC2_TEAM_REQUESTS_GET_DRAWING_DELTA) == 0);
+    }
+
+    return check::result();
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+ * @brief the response cache behind `fc2::api( url, max_age )` and `fc2::http::get( url, max_age )`
+ *
+ * usage: fc2t-test-responses [single]
+ *
+ * identical requests running at the same time make one round trip, a cached response is answered without one until
+ * it is older than the caller's max age, and a failed request is never cached. with "single" the server doesn't
+ * stream and every response is one api or http request.
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+#include <latch>
+
+namespace
+{
+    constexpr auto latency = std::chrono::milliseconds(100);
+
+    auto round_trips(standin::server& server) -> std::uint64_t
+    {
+        return server.served(FC2_TEAM_REQUESTS_API) + server.served(FC2_TEAM_REQUESTS_HTTP_REQUEST) + server.served(FC2_TEAM_REQUESTS_HTTP_STREAM);
+    }
+
+    /**
+     * @brief callers that all ask for the same url while the first request is still in flight
+     */
+    void coalescing(standin::server& server)
+    {
+        constexpr int callers = 8;
+        const std::string url = "getConfiguration&size=200";
+        const auto expected = standin::body(url.c_str(), "");
+
+        fc2::response_cache::reset_stats();
+        const auto before = round_trips(server);
+
+        std::latch start(callers);
+        std::atomic< int > correct{ 0 };
+        std::vector< std::thread > threads;
+        for (int i = 0; i < callers; ++i)
+        {
+            threads.emplace_back([&]
+                {
+                    start.arrive_and_wait();
+                    correct += fc2::api(url, std::chrono::seconds(10)) == expected;
+                });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        const auto stats = fc2::response_cache::get_stats();
+        CHECK(correct == callers);
+        CHECK(round_trips(server) - before == 1);
+        CHECK(stats.misses == 1);
+        CHECK(stats.coalesced + stats.hits == callers - 1);
+        CHECK(stats.coalesced > 0);
+
+        // and later callers get the cached response
+        CHECK(fc2::api(url, std::chrono::seconds(10)) == expected);
+        CHECK(round_trips(server) - before == 1);
+    }
+
+    /**
+     * @brief a response older than the caller's max age is fetched again
+     */
+    void expiry(standin::server& server)
+    {
+        const std::string url = "https://example.com/settings?size=64";
+        const auto expected = standin::body(url.c_str(), "");
+        const auto before = round_trips(server);
+
+        CHECK(fc2::http::get(url, std::chrono::milliseconds(300)) == expected);
+        CHECK(fc2::http::get(url, std::chrono::milliseconds(300)) == expected);
+        CHECK(round_trips(server) - before == 1);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        // young enough for one caller, too old for another
+        CHECK(fc2::http::get(url, std::chrono::milliseconds(300)) == expected);
+        CHECK(round_trips(server) - before == 1);
+        CHECK(fc2::http::get(url, std::chrono::milliseconds(10)) == expected);
+        CHECK(round_trips(server) - before == 2);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+        CHECK(fc2::http::get(url, std::chrono::milliseconds(300)) == expected);
+        CHECK(round_trips(server) - before == 3);
+    }
+
+    /**
+     * @brief a stream the server refuses comes back empty and has to be asked for again
+     */
+    void failure(standin::server& server)
+    {
+        const auto before = round_trips(server);
+        CHECK(fc2::http::get("https://example.com/fail?size=64", std::chrono::seconds(10)).empty());
+        CHECK(fc2::http::get("https://example.com/fail?size=64", std::chrono::seconds(10)).empty());
+        CHECK(fc2::api("fail&size=64", std::chrono::seconds(10)).empty());
+        CHECK(fc2::api("fail&size=64", std::chrono::seconds(10)).empty());
+        CHECK(round_trips(server) - before == 4);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool single = argc > 1 && strcmp(argv[1], "single") == 0;
+
+    standin::options opts;
+    opts.capabilities = single ? 0u : 1u << FC2_TEAM_EXTENSION_HTTP_STREAM;
+    for (const auto request : { FC2_TEAM_REQUESTS_API, FC2_TEAM_REQUESTS_HTTP_REQUEST, FC2_TEAM_REQUESTS_HTTP_STREAM })
+    {
+        opts.request_latency[request] = latency;
+    }
+
+    standin::server server(opts);
+    CHECK(static_cast<bool>(server));
+
+    fc2::ping();
+    CHECK(fc2::detail::client::get()->supports(FC2_TEAM_EXTENSION_HTTP_STREAM) == !single);
+
+    coalescing(server);
+    expiry(server);
+
+    // the single buffer requests of the stand-in never fail
+    if (!single)
+    {
+        failure(server);
+    }
+
+    return check::result();
+}
\ No newline at end of file
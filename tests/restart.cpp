@@ -0,0 +1,116 @@
+/**
+ * @brief starts, stops and restarts the stand-in server underneath a client that keeps sending requests
+ *
+ * SIGTERM removes the segments like a clean shutdown, SIGKILL leaves them behind like a crash. the client has to
+ * come back on its own every time, with a new connection generation, and no request may hang longer than its timeout.
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+
+namespace
+{
+    std::atomic< bool > running{ true };
+    std::atomic< std::uint64_t > answered{ 0 };
+    std::atomic< std::uint64_t > failed{ 0 };
+    std::atomic< std::int64_t > longest{ 0 };
+
+    /**
+     * @brief what an application would do: send a request every millisecond and carry on whatever the result
+     */
+    void client()
+    {
+        for (std::uint64_t i = 0; running; ++i)
+        {
+            const auto label = "request " + std::to_string(i);
+
+            const auto start = std::chrono::steady_clock::now();
+            const bool ok = fc2::call< std::string >(label, FC2_LUA_TYPE_STRING) == label;
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+            (ok ? answered : failed).fetch_add(1);
+            if (elapsed > longest)
+            {
+                longest = elapsed;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    template< typename predicate_t >
+    auto eventually(predicate_t&& predicate, const std::chrono::milliseconds timeout) -> bool
+    {
+        const auto until = std::chrono::steady_clock::now() + timeout;
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() >= until)
+            {
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief long enough for a request to time out and for the backoff to come around once more
+     */
+    constexpr auto recovery = std::chrono::seconds(FC2_TEAM_REQUESTS_TIMEOUT) + std::chrono::milliseconds(FC2_TEAM_RECONNECT_MAX_MILLISECONDS) + std::chrono::seconds(2);
+
+    auto answering() -> bool
+    {
+        const auto before = answered.load();
+        return eventually([before] { return answered.load() > before + 10; }, recovery);
+    }
+
+    auto failing() -> bool
+    {
+        const auto before = failed.load();
+        return eventually([before] { return failed.load() > before; }, recovery);
+    }
+}
+
+int main()
+{
+    /**
+     * @brief the client starts before there is anything to connect to
+     */
+    std::thread thread(client);
+    CHECK(failing());
+    CHECK(answered == 0);
+
+    std::optional< standin::process > server;
+    server.emplace();
+    CHECK(static_cast<bool>(*server));
+    CHECK(answering());
+
+    auto generation = fc2::get_generation();
+    CHECK(generation > 0);
+
+    for (const int signal : { SIGTERM, SIGKILL, SIGTERM, SIGKILL })
+    {
+        server->stop(signal);
+        CHECK(failing());
+
+        server.emplace();
+        CHECK(static_cast<bool>(*server));
+        CHECK(answering());
+
+        const auto next = fc2::get_generation();
+        CHECK(next > generation);
+        generation = next;
+
+        printf("after %s: generation %llu, %llu answered, %llu failed, longest request %lld ms\n", signal == SIGTERM ? "SIGTERM" : "SIGKILL",
+            static_cast<unsigned long long>(generation), static_cast<unsigned long long>(answered.load()), static_cast<unsigned long long>(failed.load()), static_cast<long long>(longest.load()));
+    }
+
+    running = false;
+    thread.join();
+
+    CHECK(longest <= FC2_TEAM_REQUESTS_TIMEOUT * 1000 + 500);
+    CHECK(fc2::get_error() == FC2_TEAM_ERROR_NO_ERROR);
+
+    return check::result();
+}
\ No newline at end of file
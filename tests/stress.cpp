@@ -0,0 +1,123 @@
+/**
+ * @brief 1, 2, 4 and 8 client processes hammering one stand-in server, over the request segment alone, over lanes and over slots
+ *
+ * every answer depends on what its request asked for, so two clients writing the same buffer at once show up as wrong
+ * answers. with more than one client, one more client is killed while it is busy, which must not hold up the others.
+ */
+#include "check.hpp"
+#include "../tools/standin/standin.hpp"
+
+#include <sys/wait.h>
+
+namespace
+{
+    constexpr int requests = 300;
+
+    /**
+     * @brief runs in a fresh process, so it connects on its own and sees the capabilities of the current server
+     * @return how many answers were wrong
+     */
+    auto client(const int index, const bool forever) -> int
+    {
+        int wrong = 0;
+        for (int i = 0; forever || i < requests; ++i)
+        {
+            const auto label = "client " + std::to_string(index) + " request " + std::to_string(i);
+            if (fc2::call< std::string >(label, FC2_LUA_TYPE_STRING) != label)
+            {
+                ++wrong;
+            }
+
+            const auto address = 0x140000000ull + static_cast<unsigned long long>(index) * 0x10000 + static_cast<unsigned long long>(i) * 8;
+            const auto value = fc2::engine::read_memory< std::uint64_t >(address);
+
+            std::uint64_t expected = 0;
+            for (int b = 0; b < 8; ++b)
+            {
+                expected |= static_cast<std::uint64_t>(standin::byte_at(address + b)) << b * 8;
+            }
+
+            if (!value || *value != expected)
+            {
+                ++wrong;
+            }
+
+            const auto url = "https://example.com/" + std::to_string(index) + "?size=" + std::to_string(100 + i % 200);
+            if (fc2::http::get(url) != standin::body(url.c_str(), ""))
+            {
+                ++wrong;
+            }
+        }
+
+        return wrong;
+    }
+
+    auto spawn(const int index, const bool forever) -> pid_t
+    {
+        const auto pid = fork();
+        if (pid == 0)
+        {
+            _exit(std::min(client(index, forever), 100));
+        }
+
+        return pid;
+    }
+
+    void run(const char* name, const std::uint32_t capabilities, const int clients)
+    {
+        standin::options opts;
+        opts.capabilities = capabilities;
+        opts.slots = 4;
+
+        standin::process server(opts);
+        CHECK(static_cast<bool>(server));
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector< pid_t > pids;
+        for (int i = 0; i < clients; ++i)
+        {
+            pids.push_back(spawn(i, false));
+        }
+
+        if (clients > 1)
+        {
+            const auto victim = spawn(clients, true);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            kill(victim, SIGKILL);
+            waitpid(victim, nullptr, 0);
+        }
+
+        int failed = 0;
+        for (const auto pid : pids)
+        {
+            int status = 0;
+            waitpid(pid, &status, 0);
+            failed += !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+        }
+
+        CHECK(failed == 0);
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        printf("%-8s %d client(s): %d failed, %lld ms\n", name, clients, failed, static_cast<long long>(elapsed.count()));
+    }
+}
+
+int main()
+{
+    const std::pair< const char*, std::uint32_t > setups[] = {
+        { "segment", 0 },
+        { "lanes", 1u << FC2_TEAM_EXTENSION_LANES },
+        { "slots", 1u << FC2_TEAM_EXTENSION_SLOTS },
+    };
+
+    for (const auto& [name, capabilities] : setups)
+    {
+        for (const int clients : { 1, 2, 4, 8 })
+        {
+            run(name, capabilities, clients);
+        }
+    }
+
+    return check::result();
+}
\ No newline at end of file
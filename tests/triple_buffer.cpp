@@ -0,0 +1,132 @@
+/**
+ * @brief the fetcher hands drawing snapshots to the render thread through TripleBuffer, this checks its two promises
+ *
+ * a value the consumer reads is never torn, and after an update the consumer is never behind what the producer had
+ * published before that update started.
+ */
+#include "check.hpp"
+#include "../TripleBuffer.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief large enough that a torn copy shows up as words from different values
+     */
+    struct value
+    {
+        std::uint64_t words[64]{};
+    };
+
+    auto whole(const value& v) -> bool
+    {
+        for (const auto word : v.words)
+        {
+            if (word != v.words[0])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief the consumer gets the newest value, values it missed are skipped, and nothing is taken twice
+     */
+    void sequence()
+    {
+        TripleBuffer< int > buffer;
+        CHECK(!buffer.Update());
+        CHECK(buffer.Front() == 0);
+
+        for (int i = 1; i <= 3; ++i)
+        {
+            buffer.Back() = i;
+            buffer.Publish();
+        }
+
+        CHECK(buffer.Update());
+        CHECK(buffer.Front() == 3);
+        CHECK(!buffer.Update());
+        CHECK(buffer.Front() == 3);
+
+        buffer.Back() = 4;
+        buffer.Publish();
+        buffer.Back() = 5;
+
+        CHECK(buffer.Update());
+        CHECK(buffer.Front() == 4);
+    }
+
+    /**
+     * @brief one producer and one consumer at full speed. the producer now and then yields halfway through a write, so a
+     * consumer reading the buffer being written would see it even on a single core.
+     */
+    void concurrent()
+    {
+        constexpr std::uint64_t count = 2000000;
+
+        TripleBuffer< value > buffer;
+        std::atomic< std::uint64_t > published{ 0 };
+
+        std::thread producer([&]
+            {
+                for (std::uint64_t i = 1; i <= count; ++i)
+                {
+                    auto& back = buffer.Back();
+                    for (std::size_t w = 0; w < std::size(back.words); ++w)
+                    {
+                        if (w == std::size(back.words) / 2 && i % 256 == 0)
+                        {
+                            std::this_thread::yield();
+                        }
+
+                        back.words[w] = i;
+                    }
+
+                    buffer.Publish();
+                    published.store(i, std::memory_order_release);
+                }
+            });
+
+        std::uint64_t last = 0;
+        std::uint64_t torn = 0;
+        std::uint64_t backwards = 0;
+        std::uint64_t stale = 0;
+        std::uint64_t taken = 0;
+
+        while (last < count)
+        {
+            const auto before = published.load(std::memory_order_acquire);
+            taken += buffer.Update();
+
+            const auto& front = buffer.Front();
+            torn += !whole(front);
+            backwards += front.words[0] < last;
+            stale += front.words[0] < before;
+            last = front.words[0];
+            std::this_thread::yield();
+        }
+
+        producer.join();
+
+        CHECK(torn == 0);
+        CHECK(backwards == 0);
+        CHECK(stale == 0);
+        CHECK(last == count);
+        CHECK(!buffer.Update());
+
+        printf("%llu values published, %llu taken\n", static_cast<unsigned long long>(count), static_cast<unsigned long long>(taken));
+    }
+}
+
+int main()
+{
+    sequence();
+    concurrent();
+
+    return check::result();
+}
\ No newline at end of file
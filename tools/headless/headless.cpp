@@ -0,0 +1,69 @@
+#include "headless.hpp"
+#include "../../UI.hpp"
+#include "../../Health.hpp"
+
+// the defaults of Config.cpp, without reading or writing any config
+bool Config::bStreamProof = true;
+bool Config::bAutostart = false;
+bool Config::bDebug = false;
+int Config::iTargetFPS = 250;
+std::atomic<std::chrono::microseconds::rep> Config::targetFrametime = 4000;
+bool Config::bCreateOverlay = false;
+int Config::iRandomOffsetMin = 0;
+int Config::iRandomOffsetMax = 0;
+int Config::iOffsetLeft = 0;
+int Config::iOffsetTop = 0;
+int Config::iOffsetRight = 0;
+int Config::iOffsetBottom = 0;
+std::string Config::sWindowName = "FC2Toverlay";
+int Config::iQuitKeycode = 0x23;
+std::vector<int> Config::fontSizes = { 13, 16, 20, 26, 34, 48 };
+
+bool Config::IsConstellationConnected() { return true; }
+void Config::GetConfig() {}
+void Config::SaveConfig() {}
+void Config::SetRandomDimensions() {}
+int Config::ImGuiKeyToVirtualKeycode(ImGuiKey) { return 0; }
+
+ImGuiKey ImGui_ImplWin32_KeyEventToImGuiKey(WPARAM, LPARAM) { return ImGuiKey_None; }
+
+HWND UI::hTargetWindow = 0;
+DWORD UI::dTargetPID = 0;
+DWORD UI::dwUIAccessErr = 0;
+
+bool UI::SetTargetWindow() { return false; }
+
+bool Health::IsConnected() { return true; }
+void Health::GetRttStats(float& min, float& avg, float& max) { min = avg = max = 0.0f; }
+void Health::PlotRttHistory(const char*, ImVec2) {}
+
+DrawingSnapshot headless::snapshot;
+
+const DrawingSnapshot& Fetcher::GetSnapshot()
+{
+    return headless::snapshot;
+}
+
+void headless::start(const ImVec2 display)
+{
+    ImGui::CreateContext();
+    Fonts::Load();
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = display;
+    io.DeltaTime = 1.0f / 250.0f;
+    io.IniFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+    // the dx11 backend uploads the atlas and hands ImGui a texture id, any non null id does here
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID(static_cast<ImTextureID>(1));
+}
+
+void headless::stop()
+{
+    ImGui::DestroyContext();
+}
\ No newline at end of file
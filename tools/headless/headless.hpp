@@ -0,0 +1,27 @@
+/**
+ * @brief runs the overlay's drawing code without a window, a device or FC2
+ *
+ * the overlay's Windows only parts are replaced by headless.cpp: the fetcher hands out `headless::snapshot`, Health
+ * always reports a connection and Config starts out with its defaults.
+ */
+#pragma once
+
+#include "../../Drawing.hpp"
+#include "../../Fetcher.hpp"
+#include "../../Config.hpp"
+#include "../../Fonts.hpp"
+
+namespace headless
+{
+    /**
+     * @brief what Fetcher::GetSnapshot returns to DrawOverlay
+     */
+    extern DrawingSnapshot snapshot;
+
+    /**
+     * @brief creates the ImGui context, bakes the fonts and sets up the io the way the dx11 backend would
+     */
+    void start(ImVec2 display);
+
+    void stop();
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef PCH_HPP
+#define PCH_HPP
+
+// stands in for the overlay's pch.hpp so Drawing.cpp and Fonts.cpp build on Linux. it gets force included, which keeps
+// the real one with windows.h and d3d11.h out. only the Windows types the overlay headers name are declared here.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::uintptr_t WPARAM;
+typedef std::intptr_t LPARAM;
+typedef std::intptr_t LRESULT;
+typedef std::uintptr_t HWND;
+typedef std::uint32_t DWORD;
+typedef unsigned int UINT;
+typedef int BOOL;
+
+struct RECT
+{
+    long left;
+    long top;
+    long right;
+    long bottom;
+};
+
+#define WINAPI
+
+struct ID3D11Device;
+struct ID3D11DeviceContext;
+struct IDXGISwapChain;
+struct ID3D11RenderTargetView;
+
+#include "../../fc2.hpp"
+#include "../../ImGui/imgui.h"
+#include "../../ImGui/imgui_stdlib.h"
+#include "../../ImGui/imgui_internal.h"
+
+#endif
\ No newline at end of file
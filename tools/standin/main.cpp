@@ -0,0 +1,151 @@
+/**
+ * @brief stand-in server for manual testing. serves until SIGINT or SIGTERM and prints how many requests of every type it answered.
+ *
+ * usage: fc2t-standin [--key n] [--latency us] [--jitter us] [--slow us] [--scene n] [--slots n] [--capabilities list]
+ *
+ * --slow sets the latency of api, http, lua and pattern requests. --capabilities takes a comma separated list of
+ * feed, stream, compact, delta, many, lanes, slots, batch, gather and http.
+ */
+#include "standin.hpp"
+
+namespace
+{
+    std::atomic< bool > running{ true };
+
+    auto capability(const std::string& name) -> int
+    {
+        static const std::pair< const char*, FC2_TEAM_EXTENSION > names[] = {
+            { "feed", FC2_TEAM_EXTENSION_DRAWING_FEED },
+            { "stream", FC2_TEAM_EXTENSION_DRAWING_STREAM },
+            { "compact", FC2_TEAM_EXTENSION_DRAWING_COMPACT },
+            { "delta", FC2_TEAM_EXTENSION_DRAWING_DELTA },
+            { "many", FC2_TEAM_EXTENSION_CALL_MANY },
+            { "lanes", FC2_TEAM_EXTENSION_LANES },
+            { "slots", FC2_TEAM_EXTENSION_SLOTS },
+            { "batch", FC2_TEAM_EXTENSION_DRAW_BATCH },
+            { "gather", FC2_TEAM_EXTENSION_READ_MEMORY_MANY },
+            { "http", FC2_TEAM_EXTENSION_HTTP_STREAM },
+        };
+
+        for (const auto& [key, value] : names)
+        {
+            if (name == key)
+            {
+                return value;
+            }
+        }
+
+        return -1;
+    }
+
+    /**
+     * @brief a scene of boxes and labels that fills the default 1920x1080 overlay
+     */
+    auto make_scene(const std::size_t count) -> std::vector< standin::detail_t >
+    {
+        std::vector< standin::detail_t > scene(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto x = static_cast<std::int32_t>(i * 37 % 1900);
+            const auto y = static_cast<std::int32_t>(i * 53 % 1060);
+
+            scene[i] = i % 4 == 3
+                ? fc2::draw::primitive::text("entry " + std::to_string(i), 13, x, y, 255, 255, 255, 255)
+                : fc2::draw::primitive::box(x, y, 20, 20, 255, static_cast<std::int32_t>(i % 256), 0, 255, 1);
+        }
+
+        return scene;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    standin::options opts;
+    std::size_t scene = 100;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        const std::string value = argv[i + 1];
+
+        if (arg == "--key")
+        {
+            opts.key = std::stoi(value);
+        }
+        else if (arg == "--latency")
+        {
+            opts.latency = std::chrono::microseconds(std::stoll(value));
+        }
+        else if (arg == "--jitter")
+        {
+            opts.jitter = std::chrono::microseconds(std::stoll(value));
+        }
+        else if (arg == "--slow")
+        {
+            for (const auto request : { FC2_TEAM_REQUESTS_API, FC2_TEAM_REQUESTS_HTTP_REQUEST, FC2_TEAM_REQUESTS_HTTP_STREAM, FC2_TEAM_REQUESTS_LUA, FC2_TEAM_REQUESTS_PATTERN })
+            {
+                opts.request_latency[request] = std::chrono::microseconds(std::stoll(value));
+            }
+        }
+        else if (arg == "--scene")
+        {
+            scene = std::stoull(value);
+        }
+        else if (arg == "--slots")
+        {
+            opts.slots = static_cast<std::uint32_t>(std::stoul(value));
+        }
+        else if (arg == "--capabilities")
+        {
+            std::size_t start = 0;
+            while (start <= value.size())
+            {
+                const auto end = std::min(value.find(',', start), value.size());
+                const auto index = capability(value.substr(start, end - start));
+                if (index < 0)
+                {
+                    fprintf(stderr, "unknown capability: %s\n", value.substr(start, end - start).c_str());
+                    return 1;
+                }
+
+                opts.capabilities |= 1u << index;
+                start = end + 1;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    signal(SIGINT, [](int) { running = false; });
+    signal(SIGTERM, [](int) { running = false; });
+
+    standin::server server(opts);
+    if (!server)
+    {
+        perror("fc2t-standin: can't create the segments");
+        return 1;
+    }
+
+    server.set_scene(make_scene(scene));
+    printf("serving key %d, capabilities 0x%x\n", opts.key, opts.capabilities);
+
+    while (running)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    server.stop();
+
+    for (int request = 1; request < fc2::detail::statistics::max_requests; ++request)
+    {
+        if (const auto count = server.served(request))
+        {
+            printf("%-20s %llu\n", fc2::stats::name(request), static_cast<unsigned long long>(count));
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,1015 @@
+/**
+ * @title FC2T stand-in server
+ * @file standin.hpp
+ * @description serves the Linux shared memory segments of fc2.hpp without FC2, so the client can be tested and measured on its own
+ */
+#ifndef FC2T_STANDIN_HPP
+#define FC2T_STANDIN_HPP
+
+#include "../../fc2.hpp"
+
+#ifndef __linux__
+#error "the stand-in server only provides the SysV segments used on Linux"
+#endif
+
+#include <climits> /** INT_MAX **/
+#include <map> /** std::map **/
+#include <random> /** std::mt19937 **/
+#include <sys/wait.h> /** waitpid **/
+
+namespace standin
+{
+    using detail_t = fc2::detail::requests::draw::detail;
+
+    /**
+     * @brief how the stand-in server behaves. everything can be changed before the server is created, latency also while it is running.
+     */
+    struct options
+    {
+        /**
+         * @brief SysV key of the request segment. the extension segment uses `key + SHM_EXTENSION_OFFSET_LINUX`, same as the client.
+         */
+        int key = SHM_KEY;
+
+        /**
+         * @brief how long every request takes, plus a uniformly distributed random part of up to `jitter`
+         */
+        std::chrono::microseconds latency{ 0 };
+        std::chrono::microseconds jitter{ 0 };
+
+        /**
+         * @brief latency of single request types, replaces `latency` for them
+         */
+        std::map< int, std::chrono::microseconds > request_latency;
+
+        /**
+         * @brief FC2_TEAM_EXTENSION bits to advertise. the extension segment is only created if any is set.
+         */
+        std::uint32_t capabilities = 0;
+
+        /**
+         * @brief size of the slot ring when FC2_TEAM_EXTENSION_SLOTS is advertised
+         */
+        std::uint32_t slots = 8;
+
+        /**
+         * @brief how often the drawing feed publishes a frame when FC2_TEAM_EXTENSION_DRAWING_FEED is advertised
+         */
+        std::chrono::microseconds feed_interval{ 1000 };
+
+        /**
+         * @brief what FC2_TEAM_REQUESTS_GET_MODULE answers for "game.exe". every other module is unknown.
+         */
+        unsigned long long module_base = 0x140000000ull;
+        unsigned long long module_size = 0x200000ull;
+    };
+
+    /**
+     * @brief body of every api and http response: `size=` bytes (64 if the url has none) that depend on the url and the post data
+     * @param url
+     * @param post
+     * @return
+     */
+    inline auto body(const char* url, const char* post) -> std::string
+    {
+        const char* size = strstr(url, "size=");
+        const std::size_t length = size ? strtoull(size + 5, nullptr, 10) : 64;
+
+        std::string output(length, '\0');
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            output[i] = static_cast<char>('a' + (i * 7 + strlen(url) + strlen(post)) % 26);
+        }
+
+        return output;
+    }
+
+    /**
+     * @brief the byte FC2_TEAM_REQUESTS_READ_MEMORY reads at an address. the 64 KB at 0xdead0000 can't be read. a read
+     * that runs into them only returns the bytes before, like one that runs into an unmapped page.
+     * @param address
+     * @return
+     */
+    inline auto byte_at(const unsigned long long address) -> unsigned char
+    {
+        return static_cast<unsigned char>(address ^ address >> 8);
+    }
+
+    inline auto readable(const unsigned long long address) -> bool
+    {
+        return address >> 16 != 0xdead;
+    }
+
+    /**
+     * @brief how many bytes from `address` on can be read
+     * @param address
+     * @param size
+     * @return
+     */
+    inline auto readable_bytes(const unsigned long long address, const unsigned long long size) -> unsigned long long
+    {
+        for (unsigned long long i = 0; i < size; ++i)
+        {
+            if (!readable(address + i))
+            {
+                return i;
+            }
+        }
+
+        return size;
+    }
+
+    /**
+     * @brief serves every request buffer of the Linux protocol on its own thread: the request segment, every lane and every slot
+     *
+     * drawing requests come from a scene of slots that is replaced with `set_scene`. the scene has a version that is bumped on every change, which is the frame id of the stream, compact and delta requests. the delta request can be answered relative to any version, unless the history was dropped with `forget`.
+     *
+     * @code
+     *
+     * standin::options opts;
+     * opts.latency = std::chrono::microseconds( 50 );
+     * opts.capabilities = 1u << FC2_TEAM_EXTENSION_DRAWING_DELTA;
+     *
+     * standin::server server( opts );
+     * server.set_scene( entries );
+     *
+     * auto pong = fc2::ping( );
+     *
+     * @endcode
+     */
+    class server
+    {
+        options opts;
+
+        int id = -1;
+        char* data = nullptr;
+        int extension_id = -1;
+        char* extension = nullptr;
+
+        /**
+         * @brief every request buffer, laid out like the request segment
+         */
+        std::vector< fc2::detail::information* > buffers;
+        std::vector< std::thread > threads;
+        std::atomic< bool > running{ true };
+        std::atomic< bool > held{ false };
+
+        fc2::detail::extension::drawing_feed* feed = nullptr;
+
+        std::mutex latency_mutex;
+        std::mt19937 random{ 0x46433254 };
+
+        std::mutex scene_mutex;
+        std::vector< detail_t > scene;
+        std::vector< std::uint32_t > changed_at;
+        std::uint32_t version = 1;
+        std::uint32_t floor = 1;
+
+        /**
+         * @brief used slots of the current version and their compact encoding, rebuilt when the version changes
+         */
+        std::vector< detail_t > used;
+        std::vector< std::uint8_t > encoded;
+        std::uint32_t used_version = 0;
+
+        std::mutex drawn_mutex;
+        std::vector< detail_t > drawn_entries;
+
+        std::mutex streams_mutex;
+        std::map< std::uint32_t, std::string > streams;
+        std::uint32_t next_stream = 1;
+
+        std::atomic< std::uint64_t > served_count[fc2::detail::statistics::max_requests]{};
+        std::atomic< std::uint64_t > byte_count[fc2::detail::statistics::max_requests]{};
+
+        /**
+         * @brief create a segment, replacing one of the same key that has a different size
+         * @param key
+         * @param size
+         * @return
+         */
+        static auto create(const int key, const std::size_t size) -> int
+        {
+            auto segment = shmget(key, size, IPC_CREAT | 0666);
+            if (segment < 0 && errno == EINVAL)
+            {
+                shmctl(shmget(key, 0, 0666), IPC_RMID, nullptr);
+                segment = shmget(key, size, IPC_CREAT | 0666);
+            }
+
+            return segment;
+        }
+
+        static auto align(const std::size_t value) -> std::size_t
+        {
+            return (value + alignof(std::uint64_t) - 1) & ~(alignof(std::uint64_t) - 1);
+        }
+
+        static void complete(fc2::detail::information* info)
+        {
+            std::atomic_thread_fence(std::memory_order_release);
+            *reinterpret_cast<volatile int*>(&info->status) = fc2::detail::FC2_TEAM_SERVER_DONE;
+            syscall(SYS_futex, &info->status, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+        }
+
+        auto supports(const FC2_TEAM_EXTENSION index) const -> bool
+        {
+            return opts.capabilities & (1u << index);
+        }
+
+        /**
+         * @brief lay out the extension segment: header, drawing feed, lanes, slot ring
+         * @return
+         */
+        auto create_extension() -> bool
+        {
+            using namespace fc2::detail::extension;
+
+            std::uint32_t regions[max_regions] = {};
+            auto size = align(sizeof(header));
+
+            if (supports(FC2_TEAM_EXTENSION_DRAWING_FEED))
+            {
+                regions[FC2_TEAM_EXTENSION_DRAWING_FEED] = static_cast<std::uint32_t>(size);
+                size = align(size + sizeof(drawing_feed));
+            }
+
+            if (supports(FC2_TEAM_EXTENSION_LANES))
+            {
+                regions[FC2_TEAM_EXTENSION_LANES] = static_cast<std::uint32_t>(size);
+                size = align(size + sizeof(lanes) + FC2_TEAM_LANE_COUNT * align(FC2_TEAM_BUFFER_SIZE));
+            }
+
+            const auto slot_stride = align(sizeof(slot) + FC2_TEAM_BUFFER_SIZE);
+            if (supports(FC2_TEAM_EXTENSION_SLOTS))
+            {
+                regions[FC2_TEAM_EXTENSION_SLOTS] = static_cast<std::uint32_t>(size);
+                size = align(size + sizeof(slots) + opts.slots * slot_stride);
+            }
+
+            extension_id = create(opts.key + SHM_EXTENSION_OFFSET_LINUX, size);
+            if (extension_id < 0)
+            {
+                return false;
+            }
+
+            extension = static_cast<char*>(shmat(extension_id, nullptr, 0));
+            if (extension == reinterpret_cast<char*>(-1))
+            {
+                extension = nullptr;
+                return false;
+            }
+
+            memset(extension, 0, size);
+
+            if (supports(FC2_TEAM_EXTENSION_DRAWING_FEED))
+            {
+                feed = reinterpret_cast<drawing_feed*>(extension + regions[FC2_TEAM_EXTENSION_DRAWING_FEED]);
+            }
+
+            if (supports(FC2_TEAM_EXTENSION_LANES))
+            {
+                const auto region = reinterpret_cast<lanes*>(extension + regions[FC2_TEAM_EXTENSION_LANES]);
+                region->count = FC2_TEAM_LANE_COUNT;
+                region->stride = static_cast<std::uint32_t>(align(FC2_TEAM_BUFFER_SIZE));
+
+                for (std::uint32_t i = 0; i < region->count; ++i)
+                {
+                    buffers.push_back(reinterpret_cast<fc2::detail::information*>(reinterpret_cast<char*>(region + 1) + i * region->stride));
+                }
+            }
+
+            if (supports(FC2_TEAM_EXTENSION_SLOTS))
+            {
+                const auto region = reinterpret_cast<slots*>(extension + regions[FC2_TEAM_EXTENSION_SLOTS]);
+                region->count = opts.slots;
+                region->stride = static_cast<std::uint32_t>(slot_stride);
+
+                for (std::uint32_t i = 0; i < region->count; ++i)
+                {
+                    buffers.push_back(reinterpret_cast<fc2::detail::information*>(reinterpret_cast<char*>(region + 1) + i * region->stride + sizeof(slot)));
+                }
+            }
+
+            /**
+             * @brief the header goes last, a client that attaches meanwhile must not see half a layout
+             */
+            const auto hdr = reinterpret_cast<header*>(extension);
+            memcpy(hdr->regions, regions, sizeof regions);
+            hdr->version = fc2::detail::extension::version;
+            hdr->size = static_cast<std::uint32_t>(size);
+            hdr->capabilities = opts.capabilities;
+            std::atomic_ref< std::uint32_t >(hdr->magic).store(magic, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief the used slots of the current version. scene_mutex must be held.
+         */
+        void refresh_used()
+        {
+            if (used_version == version)
+            {
+                return;
+            }
+
+            used.clear();
+            for (const auto& entry : scene)
+            {
+                if (entry.style[FC2_TEAM_DRAW_STYLE_TYPE] != FC2_TEAM_DRAW_TYPE_NONE)
+                {
+                    used.push_back(entry);
+                }
+            }
+
+            fc2::detail::compact::encode(used.data(), used.size(), encoded);
+            used_version = version;
+        }
+
+        void delay(const int request)
+        {
+            std::chrono::microseconds duration;
+            std::chrono::microseconds jitter{ 0 };
+            {
+                std::lock_guard< std::mutex > guard(latency_mutex);
+                duration = opts.latency;
+                if (const auto it = opts.request_latency.find(request); it != opts.request_latency.end())
+                {
+                    duration = it->second;
+                }
+
+                if (opts.jitter.count() > 0)
+                {
+                    jitter = std::chrono::microseconds(std::uniform_int_distribution< long long >(0, opts.jitter.count())(random));
+                }
+            }
+
+            duration += jitter;
+            if (duration.count() <= 0)
+            {
+                return;
+            }
+
+            /**
+             * @brief sleep most of it, the scheduler overshoots short sleeps by far more than the latencies worth simulating
+             */
+            const auto until = std::chrono::steady_clock::now() + duration;
+            if (duration > std::chrono::milliseconds(2))
+            {
+                std::this_thread::sleep_for(duration - std::chrono::milliseconds(1));
+            }
+
+            while (std::chrono::steady_clock::now() < until)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        static void answer_call(const char* identifier, const FC2_LUA_TYPE typing, unsigned char* output, const std::size_t size)
+        {
+            memset(output, 0, size);
+
+            const auto length = static_cast<int>(strlen(identifier));
+            switch (typing)
+            {
+            case FC2_LUA_TYPE_STRING:
+                fc2::detail::helper::safe_copy(reinterpret_cast<char*>(output), identifier, size);
+                break;
+            case FC2_LUA_TYPE_BOOLEAN:
+                output[0] = length % 2 == 0;
+                break;
+            case FC2_LUA_TYPE_DOUBLE:
+            {
+                const double value = length * 0.5;
+                memcpy(output, &value, sizeof value);
+                break;
+            }
+            case FC2_LUA_TYPE_FLOAT:
+            {
+                const float value = length * 0.5f;
+                memcpy(output, &value, sizeof value);
+                break;
+            }
+            default:
+                memcpy(output, &length, sizeof length);
+                break;
+            }
+        }
+
+        /**
+         * @brief answer one chunk of a chunked drawing request. a request for another version than the current one restarts at offset 0.
+         * @return amount of items in this chunk
+         */
+        template< typename t >
+        auto chunk(t& request, const std::size_t total, const std::size_t capacity) -> std::size_t
+        {
+            if (request.frame != version || request.offset > total)
+            {
+                request.frame = version;
+                request.offset = 0;
+            }
+
+            request.total = static_cast<std::uint32_t>(total);
+            request.count = static_cast<std::uint32_t>(std::min(total - request.offset, capacity));
+            return request.count;
+        }
+
+        void answer(const int request, char* payload)
+        {
+            using namespace fc2::detail::requests;
+
+            switch (request)
+            {
+            case FC2_TEAM_REQUESTS_PING:
+            {
+                const auto p = reinterpret_cast<ping_pong*>(payload);
+                p->pong = static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count());
+                break;
+            }
+            case FC2_TEAM_REQUESTS_API:
+            {
+                const auto p = reinterpret_cast<api*>(payload);
+                fc2::detail::helper::safe_copy(p->buffer, body(p->url, ""), sizeof p->buffer);
+                break;
+            }
+            case FC2_TEAM_REQUESTS_HTTP_REQUEST:
+            {
+                const auto p = reinterpret_cast<http*>(payload);
+                fc2::detail::helper::safe_copy(p->response, body(p->url, p->post), sizeof p->response);
+                break;
+            }
+            case FC2_TEAM_REQUESTS_HTTP_ESCAPE:
+            {
+                const auto p = reinterpret_cast<http_escape*>(payload);
+                fc2::detail::helper::safe_copy(p->response, p->str, sizeof p->response);
+                break;
+            }
+            case FC2_TEAM_REQUESTS_ATTACH:
+                reinterpret_cast<attach*>(payload)->status = 1;
+                break;
+            case FC2_TEAM_REQUESTS_SETUP:
+                reinterpret_cast<setup*>(payload)->result = true;
+                break;
+            case FC2_TEAM_REQUESTS_GET_MODULE:
+            {
+                const auto p = reinterpret_cast<module*>(payload);
+                p->status = strcmp(p->name, "game.exe") == 0;
+                p->base = p->status ? opts.module_base : 0;
+                p->size = p->status ? opts.module_size : 0;
+                break;
+            }
+            case FC2_TEAM_REQUESTS_PATTERN:
+            {
+                const auto p = reinterpret_cast<pattern*>(payload);
+                p->result = strcmp(p->module, "game.exe") || strstr(p->sig_pattern, "??") ? 0 : opts.module_base + 0x1000 + p->offset + strlen(p->sig_pattern);
+                break;
+            }
+            case FC2_TEAM_REQUESTS_READ_MEMORY:
+            {
+                const auto p = reinterpret_cast<read_memory*>(payload);
+                p->bytes_read = 0;
+                if (p->size > sizeof p->data)
+                {
+                    break;
+                }
+
+                p->bytes_read = readable_bytes(p->address, p->size);
+                for (unsigned long long i = 0; i < p->bytes_read; ++i)
+                {
+                    p->data[i] = byte_at(p->address + i);
+                }
+                break;
+            }
+            case FC2_TEAM_REQUESTS_READ_MEMORY_MANY:
+            {
+                const auto p = reinterpret_cast<read_memory_many*>(payload);
+                for (std::uint32_t e = 0; e < std::min< std::uint32_t >(p->count, std::size(p->entries)); ++e)
+                {
+                    auto& entry = p->entries[e];
+                    entry.bytes_read = 0;
+                    if (static_cast<std::size_t>(entry.offset) + entry.size > sizeof p->data)
+                    {
+                        continue;
+                    }
+
+                    entry.bytes_read = static_cast<std::uint32_t>(readable_bytes(entry.address, entry.size));
+                    for (std::uint32_t i = 0; i < entry.bytes_read; ++i)
+                    {
+                        p->data[entry.offset + i] = byte_at(entry.address + i);
+                    }
+                }
+                break;
+            }
+            case FC2_TEAM_REQUESTS_CALL:
+            {
+                const auto p = reinterpret_cast<call*>(payload);
+                p->identifier[sizeof p->identifier - 1] = '\0';
+                answer_call(p->identifier, p->typing, p->data, sizeof p->data);
+                break;
+            }
+            case FC2_TEAM_REQUESTS_CALL_MANY:
+            {
+                const auto p = reinterpret_cast<call_many*>(payload);
+                for (std::uint32_t e = 0; e < std::min< std::uint32_t >(p->count, std::size(p->entries)); ++e)
+                {
+                    auto& entry = p->entries[e];
+                    entry.identifier[sizeof entry.identifier - 1] = '\0';
+                    answer_call(entry.identifier, entry.typing, entry.data, sizeof entry.data);
+                }
+                break;
+            }
+            case FC2_TEAM_REQUESTS_SESSION:
+            {
+                const auto p = reinterpret_cast<session*>(payload);
+                fc2::detail::helper::safe_copy(p->license, "STANDIN-0000", sizeof p->license);
+                fc2::detail::helper::safe_copy(p->username, "standin", sizeof p->username);
+                fc2::detail::helper::safe_copy(p->identifier, "0000000000000000000000000000000000000000000000000000000000000000", sizeof p->identifier);
+                fc2::detail::helper::safe_copy(p->directory, "/tmp", sizeof p->directory);
+                p->level = 3;
+                p->protection = 0;
+                break;
+            }
+            case FC2_TEAM_REQUESTS_DRAW:
+            {
+                std::lock_guard< std::mutex > guard(drawn_mutex);
+                drawn_entries.push_back(*reinterpret_cast<const detail_t*>(payload));
+                break;
+            }
+            case FC2_TEAM_REQUESTS_DRAW_BATCH:
+            {
+                const auto p = reinterpret_cast<const draw_batch*>(payload);
+                std::lock_guard< std::mutex > guard(drawn_mutex);
+                drawn_entries.insert(drawn_entries.end(), p->details, p->details + std::min< std::size_t >(p->count, std::size(p->details)));
+                break;
+            }
+            case FC2_TEAM_REQUESTS_GET_DRAWING:
+            {
+                const auto p = reinterpret_cast<draw*>(payload);
+                std::lock_guard< std::mutex > guard(scene_mutex);
+                refresh_used();
+
+                memset(p->details, 0, sizeof p->details);
+                memcpy(p->details, used.data(), std::min(used.size(), std::size(p->details)) * sizeof(detail_t));
+                byte_count[request].fetch_add(sizeof(draw), std::memory_order_relaxed);
+                break;
+            }
+            case FC2_TEAM_REQUESTS_GET_DRAWING_STREAM:
+            {
+                const auto p = reinterpret_cast<draw_stream*>(payload);
+                std::lock_guard< std::mutex > guard(scene_mutex);
+                refresh_used();
+
+                const auto count = chunk(*p, used.size(), std::size(p->details));
+                memcpy(p->details, used.data() + p->offset, count * sizeof(detail_t));
+                byte_count[request].fetch_add(offsetof(draw_stream, details) + count * sizeof(detail_t), std::memory_order_relaxed);
+                break;
+            }
+            case FC2_TEAM_REQUESTS_GET_DRAWING_COMPACT:
+            {
+                const auto p = reinterpret_cast<draw_compact*>(payload);
+                std::lock_guard< std::mutex > guard(scene_mutex);
+                refresh_used();
+
+                const auto count = chunk(*p, encoded.size(), sizeof p->data);
+                memcpy(p->data, encoded.data() + p->offset, count);
+                byte_count[request].fetch_add(offsetof(draw_compact, data) + count, std::memory_order_relaxed);
+                break;
+            }
+            case FC2_TEAM_REQUESTS_GET_DRAWING_DELTA:
+            {
+                const auto p = reinterpret_cast<draw_delta*>(payload);
+                std::lock_guard< std::mutex > guard(scene_mutex);
+
+                /**
+                 * @brief every version since `floor` can be the base. a full resend only needs the used slots, the client starts from empty ones.
+                 */
+                const bool full = p->acknowledged < floor || p->acknowledged > version;
+                std::vector< std::uint32_t > changed;
+                for (std::uint32_t i = 0; i < scene.size(); ++i)
+                {
+                    if (full ? scene[i].style[FC2_TEAM_DRAW_STYLE_TYPE] != FC2_TEAM_DRAW_TYPE_NONE : changed_at[i] > p->acknowledged)
+                    {
+                        changed.push_back(i);
+                    }
+                }
+
+                p->base = full ? 0 : p->acknowledged;
+                p->slots = static_cast<std::uint32_t>(scene.size());
+
+                const auto count = chunk(*p, changed.size(), std::size(p->changes));
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    auto& change = p->changes[i];
+                    change.slot = changed[p->offset + i];
+                    change.entry = scene[change.slot];
+                }
+
+                byte_count[request].fetch_add(offsetof(draw_delta, changes) + count * sizeof(draw_delta::change), std::memory_order_relaxed);
+                break;
+            }
+            case FC2_TEAM_REQUESTS_HTTP_STREAM:
+            {
+                const auto p = reinterpret_cast<http_stream*>(payload);
+                std::lock_guard< std::mutex > guard(streams_mutex);
+
+                if (p->stream == 0)
+                {
+                    p->url[sizeof p->url - 1] = '\0';
+                    p->post[sizeof p->post - 1] = '\0';
+                    if (strstr(p->url, "fail"))
+                    {
+                        p->failed = true;
+                        break;
+                    }
+
+                    p->stream = next_stream++;
+                    streams[p->stream] = body(p->url, p->post);
+                }
+
+                const auto it = streams.find(p->stream);
+                if (it == streams.end() || p->offset > it->second.size())
+                {
+                    p->failed = true;
+                    break;
+                }
+
+                p->total = it->second.size();
+                p->size = static_cast<std::uint32_t>(std::min< std::size_t >(sizeof p->data, it->second.size() - p->offset));
+                memcpy(p->data, it->second.data() + p->offset, p->size);
+
+                p->end = p->offset + p->size >= it->second.size();
+                if (p->end)
+                {
+                    streams.erase(it);
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        /**
+         * @brief serve one request buffer until the server stops. spin while busy, back off to short sleeps while idle.
+         * @param info
+         */
+        void serve(fc2::detail::information* info)
+        {
+            const auto payload = reinterpret_cast<char*>(info) + offsetof(fc2::detail::information, data);
+
+            unsigned int idle = 0;
+            while (running.load(std::memory_order_relaxed))
+            {
+                if (fc2::detail::wait::status(info) != fc2::detail::FC2_TEAM_SERVER_PENDING || held.load(std::memory_order_relaxed))
+                {
+                    // the same counts as the client, a count of 0 turns a phase off
+                    ++idle;
+                    if constexpr (fc2::detail::wait::spin_count > 0)
+                    {
+                        if (idle < fc2::detail::wait::spin_count)
+                        {
+                            fc2::detail::wait::relax();
+                            continue;
+                        }
+                    }
+
+                    if constexpr (fc2::detail::wait::spin_count + fc2::detail::wait::yield_count > 0)
+                    {
+                        if (idle < fc2::detail::wait::spin_count + fc2::detail::wait::yield_count)
+                        {
+                            std::this_thread::yield();
+                            continue;
+                        }
+                    }
+
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                    continue;
+                }
+
+                idle = 0;
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                const auto request = *reinterpret_cast<volatile int*>(&info->id);
+                delay(request);
+                answer(request, payload);
+
+                if (request >= 0 && request < fc2::detail::statistics::max_requests)
+                {
+                    served_count[request].fetch_add(1, std::memory_order_relaxed);
+                }
+
+                complete(info);
+            }
+        }
+
+        /**
+         * @brief publish the used slots of the scene into the drawing feed, like the producer described at `drawing_feed`
+         */
+        void publish()
+        {
+            std::uint64_t number = 0;
+            while (running.load(std::memory_order_relaxed))
+            {
+                const auto index = (std::atomic_ref< std::uint32_t >(feed->latest).load(std::memory_order_relaxed) + 1) % 3;
+                auto& frame = feed->frames[index];
+                std::atomic_ref< std::uint32_t > sequence(frame.sequence);
+
+                sequence.fetch_add(1, std::memory_order_acq_rel);
+                {
+                    std::lock_guard< std::mutex > guard(scene_mutex);
+                    refresh_used();
+
+                    // the count is every used slot, a reader that gets more than a frame holds has to stream them
+                    frame.count = static_cast<std::uint32_t>(used.size());
+                    frame.number = ++number;
+                    memcpy(frame.details, used.data(), std::min(used.size(), std::size(frame.details)) * sizeof(detail_t));
+                }
+                sequence.fetch_add(1, std::memory_order_acq_rel);
+
+                std::atomic_ref< std::uint32_t >(feed->latest).store(index, std::memory_order_release);
+                std::this_thread::sleep_for(opts.feed_interval);
+            }
+        }
+
+    public:
+        explicit server(options value = {}) : opts(std::move(value))
+        {
+            id = create(opts.key, FC2_TEAM_BUFFER_SIZE);
+            if (id < 0)
+            {
+                return;
+            }
+
+            data = static_cast<char*>(shmat(id, nullptr, 0));
+            if (data == reinterpret_cast<char*>(-1))
+            {
+                data = nullptr;
+                return;
+            }
+
+            memset(data, 0, FC2_TEAM_BUFFER_SIZE);
+            buffers.push_back(reinterpret_cast<fc2::detail::information*>(data));
+
+            if (opts.capabilities && !create_extension())
+            {
+                return;
+            }
+
+            /**
+             * @brief nothing is pending until a client posts something
+             */
+            for (const auto info : buffers)
+            {
+                info->status = fc2::detail::FC2_TEAM_SERVER_DONE;
+            }
+
+            for (const auto info : buffers)
+            {
+                threads.emplace_back(&server::serve, this, info);
+            }
+
+            if (feed)
+            {
+                threads.emplace_back(&server::publish, this);
+            }
+        }
+
+        server(const server&) = delete;
+        server& operator=(const server&) = delete;
+
+        ~server()
+        {
+            stop();
+        }
+
+        /**
+         * @brief false if the segments couldn't be created
+         */
+        explicit operator bool() const
+        {
+            return !threads.empty();
+        }
+
+        /**
+         * @brief stop serving and remove the segments. clients still attached keep their mapping, but nobody answers anymore.
+         */
+        void stop()
+        {
+            running = false;
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+
+            threads.clear();
+
+            if (extension)
+            {
+                shmdt(extension);
+                extension = nullptr;
+            }
+
+            if (extension_id >= 0)
+            {
+                shmctl(extension_id, IPC_RMID, nullptr);
+                extension_id = -1;
+            }
+
+            if (data)
+            {
+                shmdt(data);
+                data = nullptr;
+            }
+
+            if (id >= 0)
+            {
+                shmctl(id, IPC_RMID, nullptr);
+                id = -1;
+            }
+        }
+
+        /**
+         * @brief stop picking up new requests while true. requests being served are still answered.
+         * @param value
+         */
+        void hold(const bool value)
+        {
+            held = value;
+        }
+
+        void set_latency(const std::chrono::microseconds latency, const std::chrono::microseconds jitter = {})
+        {
+            std::lock_guard< std::mutex > guard(latency_mutex);
+            opts.latency = latency;
+            opts.jitter = jitter;
+        }
+
+        void set_latency(const int request, const std::chrono::microseconds latency)
+        {
+            std::lock_guard< std::mutex > guard(latency_mutex);
+            opts.request_latency[request] = latency;
+        }
+
+        /**
+         * @brief replace the drawing slots. the version is bumped if any slot changed.
+         * @param entries
+         * @return the current version
+         */
+        auto set_scene(const std::vector< detail_t >& entries) -> std::uint32_t
+        {
+            std::lock_guard< std::mutex > guard(scene_mutex);
+
+            bool changed = entries.size() != scene.size();
+            changed_at.resize(entries.size(), 0);
+            for (std::size_t i = 0; i < entries.size(); ++i)
+            {
+                if (i >= scene.size() || memcmp(&entries[i], &scene[i], sizeof(detail_t)) != 0)
+                {
+                    changed_at[i] = version + 1;
+                    changed = true;
+                }
+            }
+
+            if (changed)
+            {
+                scene = entries;
+                ++version;
+            }
+
+            return version;
+        }
+
+        /**
+         * @brief drop the history, the next delta request is answered with every slot
+         */
+        void forget()
+        {
+            std::lock_guard< std::mutex > guard(scene_mutex);
+            floor = ++version;
+        }
+
+        /**
+         * @brief everything received through FC2_TEAM_REQUESTS_DRAW and FC2_TEAM_REQUESTS_DRAW_BATCH so far
+         */
+        auto drawn() -> std::vector< detail_t >
+        {
+            std::lock_guard< std::mutex > guard(drawn_mutex);
+            return drawn_entries;
+        }
+
+        /**
+         * @brief requests of a type answered so far
+         * @param request
+         */
+        auto served(const int request) const -> std::uint64_t
+        {
+            return served_count[request].load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief payload bytes sent back for a drawing request type so far
+         * @param request
+         */
+        auto bytes(const int request) const -> std::uint64_t
+        {
+            return byte_count[request].load(std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief a stand-in server in a child process, for clients that shouldn't share a process with it or that outlive it
+     */
+    class process
+    {
+        options opts;
+        std::vector< detail_t > scene;
+        pid_t pid = -1;
+
+    public:
+        explicit process(options value = {}, std::vector< detail_t > entries = {}) : opts(std::move(value)), scene(std::move(entries))
+        {
+            start();
+        }
+
+        process(const process&) = delete;
+        process& operator=(const process&) = delete;
+
+        ~process()
+        {
+            stop(SIGTERM);
+        }
+
+        explicit operator bool() const
+        {
+            return pid > 0;
+        }
+
+        /**
+         * @brief fork the server and wait until its segments exist
+         * @return false if it couldn't be started
+         */
+        auto start() -> bool
+        {
+            int ready[2];
+            if (pipe(ready) < 0)
+            {
+                return false;
+            }
+
+            pid = fork();
+            if (pid == 0)
+            {
+                close(ready[0]);
+
+                static volatile sig_atomic_t stopping = 0;
+                signal(SIGTERM, [](int) { stopping = 1; });
+
+                server instance(opts);
+                instance.set_scene(scene);
+
+                const char ok = instance ? 1 : 0;
+                (void)!write(ready[1], &ok, 1);
+                close(ready[1]);
+
+                while (!stopping && ok)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+
+                instance.stop();
+                _exit(0);
+            }
+
+            close(ready[1]);
+
+            char ok = 0;
+            if (pid < 0 || read(ready[0], &ok, 1) != 1 || !ok)
+            {
+                close(ready[0]);
+                stop(SIGKILL);
+                return false;
+            }
+
+            close(ready[0]);
+            return true;
+        }
+
+        /**
+         * @brief SIGTERM shuts the server down and removes its segments. SIGKILL leaves them behind, like a crash.
+         * @param signal
+         */
+        void stop(const int signal)
+        {
+            if (pid <= 0)
+            {
+                return;
+            }
+
+            kill(pid, signal);
+            waitpid(pid, nullptr, 0);
+            pid = -1;
+        }
+    };
+}
+
+#endif
\ No newline at end of file